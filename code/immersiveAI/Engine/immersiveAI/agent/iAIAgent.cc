@@ -1,289 +1,675 @@
-//-------------------------------------------------------------------
-// Immersive AI :: Agent
-// Copyright (c) 2006 Gavin Bunney & Tom Romano
-//-------------------------------------------------------------------
-#include "iAIAgent.h"
-#include "console/consoleInternal.h"
-#include "core/realComp.h"
-#include "math/mMatrix.h"
-#include "game/moveManager.h"
-#include "game/gameConnection.h"
-
-IMPLEMENT_CO_NETOBJECT_V1(iAIAgent);
-
-iAIAgent::iAIAgent()
-{
-	mTypeMask |= iAIAgentObjectType;
-	this->setMoveTolerance(1.00f);
-
-	this->mDamage = 0.00f;
-	this->mHappiness = 100;
-	this->mFatigue = 0;
-	this->mMoney = 100.0;
-	this->mBoredom = 0;
-	this->mCurrentPath = 0;
-}
-
-iAIAgent::~iAIAgent()
-{
-	// nothing to destruct.. yet
-}
-
-void iAIAgent::initPersistFields()
-{
-	Parent::initPersistFields();
-}
-
-void iAIAgent::executeFunction(const char *name)
-{
-	Con::executef(2, name);
-}
-
-void iAIAgent::executeDatablockFunction(const char *name)
-{
-	Con::executef(this->getDataBlock(), 2, name, this->scriptThis());
-}
-
-void iAIAgent::setHealth(const S32 health)
-{
-	if ((health >= 0) && (health <= 100))
-	{
-		this->setDamageLevel(100 - health);
-	} else
-	{
-		if (health < 0)
-			this->setDamageLevel(100);
-		else
-			this->setDamageLevel(0);
-	}
-}
-
-const S32 iAIAgent::getHealth()
-{
-	return (100 - this->getDamageLevel());
-}
-
-void iAIAgent::setHappiness(const S32 happiness)
-{
-	if ((happiness >= 0) && (happiness <= 100))
-	{
-		this->mHappiness = happiness;
-	} else
-	{
-		if (happiness < 0)
-			this->mHappiness = 0;
-		else
-			this->mHappiness = 100;
-	}
-}
-
-const S32 iAIAgent::getHappiness()
-{
-	return this->mHappiness;
-}
-
-void iAIAgent::setFatigue(const S32 fatigue)
-{
-	if ((fatigue >= 0) && (fatigue <= 100))
-	{
-		this->mFatigue = fatigue;
-	} else
-	{
-		if (fatigue < 0)
-			this->mFatigue = 0;
-		else
-			this->mFatigue = 100;
-	}
-}
-
-const S32 iAIAgent::getFatigue()
-{
-	return this->mFatigue;
-}
-
-void iAIAgent::setMoney(const F32 money)
-{
-	if ((money >= 0) && (money <= 10000))
-	{
-		this->mMoney = money;
-	} else
-	{
-		if (money < 0)
-			this->mMoney = 0;
-		else
-			this->mMoney = 10000;
-	}
-}
-
-const F32 iAIAgent::getMoney()
-{
-	return this->mMoney;
-}
-
-void iAIAgent::setBoredom(const S32 boredom)
-{
-	if ((boredom >= 0) && (boredom <= 100))
-	{
-		this->mBoredom = boredom;
-	} else
-	{
-		if (boredom < 0)
-			this->mBoredom = 0;
-		else
-			this->mBoredom = 100;
-	}
-}
-
-const S32 iAIAgent::getBoredom()
-{
-	return this->mBoredom;
-}
-
-void iAIAgent::setLevel(const S32 level)
-{
-	if ((level >= 1) && (level <= 100))
-	{
-		this->mLevel = level;
-	} else
-	{
-		if (level < 1)
-			this->mLevel = 1;
-		else
-			this->mLevel = 100;
-	}
-}
-
-const S32 iAIAgent::getLevel()
-{
-	return this->mLevel;
-}
-
-ConsoleMethodGroupBegin(iAIAgent, ScriptFunctions, "iAIAgent Script Functions");
-
-ConsoleMethod( iAIAgent, getCurrentPath, S32, 2, 2,
-			  "S32 iAIAgent.getCurrentPath() - Retrieves the current path for the agent.")
-{
-	iAIPath *currentPath = object->getCurrentPath();
-	if (currentPath)
-		return (currentPath->getId());
-	else
-		return 0;
-}
-
-ConsoleMethod( iAIAgent, setCurrentPath, bool, 3, 3,
-			  "bool iAIAgent.setCurrentPath(iAIPath path) - Sets the current path for the agent.")
-{
-	// ensure pos passed
-	if (dStrlen(argv[2]) != 0)
-	{
-		// find the path in the Sim and set the agent path
-		iAIPath *path;
-		if (Sim::findObject(dAtoi(argv[2]), path))
-		{
-			object->setCurrentPath(path);
-			return true;
-		} else
-		{
-			Con::errorf("Immersive AI :: Agent :: Path [%d] not found.", dAtoi(argv[2]));
-			return false;
-		}
-	} else
-	{
-		Con::errorf("Immersive AI :: Agent :: path not passed!");
-		return false;
-	}
-}
-
-//-------------------------------------------------------------------
-// Variable accessors/mutators
-//-------------------------------------------------------------------
-
-ConsoleMethod( iAIAgent, setAgentType, void, 3, 3,
-			  "void iAIAgent.setAgentType(string agentType) - Set the type of agent.")
-{
-	object->setAgentType(argv[2]);
-}
-
-ConsoleMethod( iAIAgent, getAgentType, const char*, 2, 2,
-			  "string iAIAgent.getAgentType() - Get the type of agent.")
-{
-	const char *agentType = object->getAgentType();
-	char *returnBuffer = Con::getReturnBuffer(dStrlen(agentType) + 1);
-	dSprintf(returnBuffer, sizeof(returnBuffer), "%s", agentType);
-
-	return returnBuffer;
-}
-
-ConsoleMethod( iAIAgent, setHealth, void, 3, 3,
-			  "void iAIAgent.setHealth(S8 health) - Set the health level.")
-{
-	object->setHealth(dAtoi(argv[2]));
-}
-
-ConsoleMethod( iAIAgent, getHealth, S32, 2, 2,
-			  "S8 iAIAgent.getHealth() - Get the health level.")
-{
-	return object->getHealth();
-}
-
-ConsoleMethod( iAIAgent, setHappiness, void, 3, 3,
-			  "void iAIAgent.setHappiness(S32 happiness) - Set the happiness level.")
-{
-	object->setHappiness(dAtoi(argv[2]));
-}
-
-ConsoleMethod( iAIAgent, getHappiness, S32, 2, 2,
-			  "S8 iAIAgent.getHappiness() - Get the happiness level.")
-{
-	return object->getHappiness();
-}
-
-ConsoleMethod( iAIAgent, setFatigue, void, 3, 3,
-			  "void iAIAgent.setFatigue(S32 fatigue) - Set the fatigue level.")
-{
-	object->setFatigue(dAtoi(argv[2]));
-}
-
-ConsoleMethod( iAIAgent, getFatigue, S32, 2, 2,
-			  "S8 iAIAgent.getFatigue() - Get the fatigue level.")
-{
-	return object->getFatigue();
-}
-
-ConsoleMethod( iAIAgent, setMoney, void, 3, 3,
-			  "void iAIAgent.setMoney(F32 money) - Set the money level.")
-{
-	object->setMoney(dAtof(argv[2]));
-}
-
-ConsoleMethod( iAIAgent, getMoney, S32, 2, 2,
-			  "F32 iAIAgent.getMoney() - Get the money level.")
-{
-	return object->getMoney();
-}
-
-ConsoleMethod( iAIAgent, setBoredom, void, 3, 3,
-			  "void iAIAgent.setBoredom(S32 boredom) - Set the boredom level.")
-{
-	object->setBoredom(dAtoi(argv[2]));
-}
-
-ConsoleMethod( iAIAgent, getBoredom, S32, 2, 2,
-			  "S8 iAIAgent.getBoredom() - Get the boredom level.")
-{
-	return object->getBoredom();
-}
-
-ConsoleMethod( iAIAgent, setLevel, void, 3, 3,
-			  "void iAIAgent.setLevel(S32 level) - Set the agent level.")
-{
-	object->setLevel(dAtoi(argv[2]));
-}
-
-ConsoleMethod( iAIAgent, getLevel, S32, 2, 2,
-			  "S8 iAIAgent.getLevel() - Get the agent level.")
-{
-	return object->getLevel();
-}
-
+//-------------------------------------------------------------------
+// Immersive AI :: Agent
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+#include "iAIAgent.h"
+#include "console/consoleInternal.h"
+#include "core/realComp.h"
+#include "math/mMatrix.h"
+#include "game/moveManager.h"
+#include "game/gameConnection.h"
+#include "platform/profiler.h"
+#include "immersiveAI/seek/path/iAIPathMap.h"
+#include "immersiveAI/seek/path/iAIPathGlobal.h"
+#include "immersiveAI/seek/path/iAIPathDensity.h"
+#include "immersiveAI/seek/path/iAIPathReservation.h"
+#include "immersiveAI/seek/avoid/iAIAvoidance.h"
+
+IMPLEMENT_CO_NETOBJECT_V1(iAIAgent);
+
+iAIAgent::iAIAgent()
+{
+	mTypeMask |= iAIAgentObjectType;
+	this->setMoveTolerance(1.00f);
+
+	this->mDamage = 0.00f;
+	this->mHappiness = 100;
+	this->mFatigue = 0;
+	this->mMoney = 100.0;
+	this->mBoredom = 0;
+	this->mPath = 0;
+	this->mDebugPath = 0;
+	this->mShowPath = false;
+	this->mRenderPathSpline = true;
+	this->mFollowingPath = false;
+	this->mPathTarget = IAIPATHGLOBAL_INVALID_POSITION;
+	this->mPathStuckLocation = IAIPATHGLOBAL_INVALID_POSITION;
+	this->mPathStuckTicks = 0;
+	this->mPathLookahead = IAIAGENT_PATH_LOOKAHEAD;
+	this->mCooperativePath = false;
+	this->mAvoidanceIndex = -1;
+	this->mCrowdNodeId = IAIPATHDENSITY_NO_NODE;
+	this->mCrowdGeneration = 0;
+	this->mCrowdPosition = IAIPATHGLOBAL_INVALID_POSITION;
+}
+
+iAIAgent::~iAIAgent()
+{
+	// nothing to destruct.. yet
+}
+
+bool iAIAgent::onAdd()
+{
+	if (!Parent::onAdd())
+		return false;
+
+	// only the server moves agents
+	if (this->isServerObject())
+		iAIAvoidance::getInstance()->addAgent(this);
+
+	return true;
+}
+
+void iAIAgent::onRemove()
+{
+	if (this->isServerObject())
+	{
+		iAIAvoidance::getInstance()->removeAgent(this);
+		iAIPathDensity::getInstance()->remove(this->mCrowdNodeId, IAIPATHDENSITY_AGENT_AMOUNT, this->mCrowdGeneration);
+		this->mCrowdNodeId = IAIPATHDENSITY_NO_NODE;
+	}
+
+	// the shown path must go before the handle it shows
+	if (!this->mDebugPath.isNull())
+		this->mDebugPath->deleteObject();
+
+	iAIPathHandle::destroy(this->mPath);
+	this->mPath = 0;
+
+	Parent::onRemove();
+}
+
+void iAIAgent::initPersistFields()
+{
+	Parent::initPersistFields();
+
+	addGroup("Path");
+		addField("showPath", TypeBool, Offset(mShowPath, iAIAgent), "Display the agent's paths on rendering.");
+		addField("renderPathSpline", TypeBool, Offset(mRenderPathSpline, iAIAgent), "Render the agent's paths as splines. If set to false, will render as linear.");
+		addField("pathLookahead", TypeF32, Offset(mPathLookahead, iAIAgent), "Distance from a path corner at which the agent turns for the next one.");
+		addField("cooperativePath", TypeBool, Offset(mCooperativePath, iAIAgent), "Plan paths around the other agents' reserved nodes, while $iAIPathMap::cooperative is on.");
+	endGroup("Path");
+}
+
+bool iAIAgent::findPath(const Point3F &destination, F32 radius, const char *profile)
+{
+	iAIPathMap* pathMap = 0;
+	if (!Sim::findObject(dAtoi(Con::getVariable("$iAIPathMap")), pathMap))
+	{
+		Con::errorf("Immersive AI :: Agent :: unable to find the iAIPathMap");
+		return false;
+	}
+
+	// the first path the agent finds takes a handle from the pool; it's reused from then on
+	if (!this->mPath)
+		this->mPath = iAIPathHandle::create(this);
+
+	// keep the path wide enough for the agent's bounds
+	if (radius < 0.0f)
+		radius = this->getRadius();
+
+	// costed by the agent type's profile, if one is registered
+	if (!profile || (dStrlen(profile) == 0))
+		profile = this->getAgentType();
+
+	// the old path is no longer followed; the new one must be started
+	this->mFollowingPath = false;
+
+	bool pathFound = this->mPath->createPath(pathMap, this->getPosition(), destination, true, radius, profile);
+	this->updateDebugPath();
+
+	return pathFound;
+}
+
+bool iAIAgent::requestCooperativePath(const Point3F &destination)
+{
+	if (!this->mCooperativePath || !iAIPathReservation::isEnabled())
+		return false;
+
+	return iAIPathReservation::getInstance()->requestPath(this, destination);
+}
+
+void iAIAgent::planCooperativePath(iAIPathMap *pathMap, const Point3F &destination, const U32 startStep)
+{
+	if (!this->mPath)
+		this->mPath = iAIPathHandle::create(this);
+
+	// the old path is no longer followed; the new one must be started
+	this->mFollowingPath = false;
+
+	bool pathFound = this->mPath->createCooperativePath(pathMap, this->getPosition(), destination, startStep, this->getRadius(), this->getAgentType());
+	this->updateDebugPath();
+
+	if (pathFound)
+	{
+		this->followPath();
+		return;
+	}
+
+	// find it alone instead, as script would have
+	char destinationString[256];
+	dSprintf(destinationString, sizeof(destinationString), "%f %f %f", destination.x, destination.y, destination.z);
+	Con::executef(this, 5, "generatePath", destinationString, "0", "1");
+}
+
+void iAIAgent::clearPath()
+{
+	this->mFollowingPath = false;
+
+	if (this->mPath)
+		this->mPath->clearPath();
+
+	this->updateDebugPath();
+}
+
+bool iAIAgent::followPath()
+{
+	if (!this->mPath || !this->mPath->hasNextNode())
+	{
+		this->mFollowingPath = false;
+		return false;
+	}
+
+	// head for the next position, slowing only for the last
+	this->mPathTarget = this->mPath->getNextPosition();
+	this->setMoveDestination(this->mPathTarget, !this->mPath->hasNextNode());
+
+	this->mPathStuckLocation = IAIPATHGLOBAL_INVALID_POSITION;
+	this->mFollowingPath = true;
+	return true;
+}
+
+void iAIAgent::processTick(const Move *move)
+{
+	// steer before AIPlayer moves, so it never sees the corners reached
+	if (this->isServerObject() && this->mFollowingPath)
+		this->updatePathFollow();
+
+	if (this->isServerObject())
+		this->updateCrowd();
+
+	Parent::processTick(move);
+}
+
+bool iAIAgent::getAIMove(Move *move)
+{
+	if (!Parent::getAIMove(move))
+		return false;
+
+	if (!iAIAvoidance::isEnabled())
+		return true;
+
+	PlayerData *data = dynamic_cast<PlayerData*>(this->getDataBlock());
+	if (!data || (data->maxForwardSpeed <= 0.0f))
+		return true;
+
+	PROFILE_START(iAIAgent_getAIMove);
+
+	// AIPlayer's move is in object space, after the yaw; turn it back into the world
+	Point3F rotation = this->getRotation();
+	F32 maxSpeed = data->maxForwardSpeed;
+	Point3F preferred;
+	MatrixF moveMatrix;
+	moveMatrix.set(EulerF(0, 0, rotation.z + move->yaw));
+	moveMatrix.mulV(Point3F(move->x * maxSpeed, move->y * maxSpeed, 0), &preferred);
+
+	Point2F velocity = iAIAvoidance::getInstance()->computeVelocity(this, Point2F(preferred.x, preferred.y), maxSpeed);
+
+	// and back again
+	Point3F newMove;
+	moveMatrix.set(EulerF(0, 0, -(rotation.z + move->yaw)));
+	moveMatrix.mulV(Point3F(velocity.x, velocity.y, 0), &newMove);
+	move->x = mClampF(newMove.x / maxSpeed, -1.0f, 1.0f);
+	move->y = mClampF(newMove.y / maxSpeed, -1.0f, 1.0f);
+
+	PROFILE_END();
+	return true;
+}
+
+F32 iAIAgent::getRadius()
+{
+	const Box3F &box = this->getWorldBox();
+	return getMax(box.len_x(), box.len_y()) / 2.0f;
+}
+
+void iAIAgent::updatePathFollow()
+{
+	Point3F location = this->getPosition();
+
+	// turn for the next corner once within the lookahead of this one
+	F32 lookaheadSquared = this->mPathLookahead * this->mPathLookahead;
+	U32 currentTime = Sim::getCurrentTime();
+	while (this->mPath->hasNextNode() && (this->mPath->getPointTime(1) <= currentTime))
+	{
+		F32 xDiff = this->mPathTarget.x - location.x;
+		F32 yDiff = this->mPathTarget.y - location.y;
+		if (((xDiff * xDiff) + (yDiff * yDiff)) > lookaheadSquared)
+			break;
+
+		this->mPathTarget = this->mPath->getNextPosition();
+		this->setMoveDestination(this->mPathTarget, !this->mPath->hasNextNode());
+	}
+
+	// time for the next cooperative window
+	if (this->mPath->needsReplan())
+		this->requestCooperativePath(this->mPath->getGoal());
+
+	// arrived at the end of the path; the same test as AIPlayer's, so stopping here keeps it quiet
+	if (!this->mPath->hasNextNode() &&
+		(mFabs(this->mPathTarget.x - location.x) < this->getMoveTolerance()) &&
+		(mFabs(this->mPathTarget.y - location.y) < this->getMoveTolerance()))
+	{
+		this->stopMove();
+		this->mFollowingPath = false;
+		this->executeDatablockFunction("onPathComplete");
+		return;
+	}
+
+	// waiting at the corner for the others to pass; not blocked
+	if (this->mPath->hasNextNode() && (this->mPath->getPointTime(1) > currentTime))
+	{
+		this->mPathStuckLocation = IAIPATHGLOBAL_INVALID_POSITION;
+		return;
+	}
+
+	// moving on; watch from here
+	F32 xMoved = location.x - this->mPathStuckLocation.x;
+	F32 yMoved = location.y - this->mPathStuckLocation.y;
+	if ((this->mPathStuckLocation == IAIPATHGLOBAL_INVALID_POSITION) ||
+		(((xMoved * xMoved) + (yMoved * yMoved)) > (IAIAGENT_PATH_STUCK_TOLERANCE * IAIAGENT_PATH_STUCK_TOLERANCE)))
+	{
+		this->mPathStuckLocation = location;
+		this->mPathStuckTicks = 0;
+		return;
+	}
+
+	// held up a tick by the crowd, or jittering against a wall; blocked only once it's gone on a while
+	if (++this->mPathStuckTicks >= IAIAGENT_PATH_STUCK_TICKS)
+	{
+		this->stopMove();
+		this->mFollowingPath = false;
+		this->executeDatablockFunction("onPathBlocked");
+	}
+}
+
+void iAIAgent::updateCrowd()
+{
+	iAIPathDensity *density = iAIPathDensity::getInstance();
+	Point3F location = this->getPosition();
+
+	// the node only changes once moved a step, unless the counts were cleared or it wasn't on the pathmap
+	if ((this->mCrowdGeneration == density->getGeneration()) && (this->mCrowdNodeId != IAIPATHDENSITY_NO_NODE))
+	{
+		F32 xDiff = location.x - this->mCrowdPosition.x;
+		F32 yDiff = location.y - this->mCrowdPosition.y;
+		if (((xDiff * xDiff) + (yDiff * yDiff)) < (IAIAGENT_CROWD_STEP * IAIAGENT_CROWD_STEP))
+			return;
+	}
+
+	this->mCrowdPosition = location;
+	U32 nodeId = density->findNodeId(location);
+	if ((nodeId == this->mCrowdNodeId) && (this->mCrowdGeneration == density->getGeneration()))
+		return;
+
+	density->remove(this->mCrowdNodeId, IAIPATHDENSITY_AGENT_AMOUNT, this->mCrowdGeneration);
+	density->add(nodeId, IAIPATHDENSITY_AGENT_AMOUNT);
+	this->mCrowdNodeId = nodeId;
+	this->mCrowdGeneration = density->getGeneration();
+}
+
+void iAIAgent::updateDebugPath()
+{
+	// only shown while there is a path and it's asked for
+	if (!this->mShowPath || !this->hasPath())
+	{
+		if (!this->mDebugPath.isNull())
+			this->mDebugPath->deleteObject();
+
+		this->mDebugPath = 0;
+		return;
+	}
+
+	if (this->mDebugPath.isNull())
+	{
+		iAIPath *debugPath = new iAIPath();
+		debugPath->attachHandle(this->mPath);
+		debugPath->mShow = true;
+
+		if (!debugPath->registerObject())
+		{
+			delete debugPath;
+			return;
+		}
+
+		// cleaned up with the mission, if the agent isn't first
+		SimGroup *missionCleanup = 0;
+		if (Sim::findObject("MissionCleanup", missionCleanup))
+			missionCleanup->addObject(debugPath);
+
+		this->mDebugPath = debugPath;
+	}
+
+	this->mDebugPath->mRenderSpline = this->mRenderPathSpline;
+	this->mDebugPath->updateWorldBox();
+}
+
+void iAIAgent::executeFunction(const char *name)
+{
+	Con::executef(2, name);
+}
+
+void iAIAgent::executeDatablockFunction(const char *name)
+{
+	Con::executef(this->getDataBlock(), 2, name, this->scriptThis());
+}
+
+void iAIAgent::setHealth(const S32 health)
+{
+	if ((health >= 0) && (health <= 100))
+	{
+		this->setDamageLevel(100 - health);
+	} else
+	{
+		if (health < 0)
+			this->setDamageLevel(100);
+		else
+			this->setDamageLevel(0);
+	}
+}
+
+const S32 iAIAgent::getHealth()
+{
+	return (100 - this->getDamageLevel());
+}
+
+void iAIAgent::setHappiness(const S32 happiness)
+{
+	if ((happiness >= 0) && (happiness <= 100))
+	{
+		this->mHappiness = happiness;
+	} else
+	{
+		if (happiness < 0)
+			this->mHappiness = 0;
+		else
+			this->mHappiness = 100;
+	}
+}
+
+const S32 iAIAgent::getHappiness()
+{
+	return this->mHappiness;
+}
+
+void iAIAgent::setFatigue(const S32 fatigue)
+{
+	if ((fatigue >= 0) && (fatigue <= 100))
+	{
+		this->mFatigue = fatigue;
+	} else
+	{
+		if (fatigue < 0)
+			this->mFatigue = 0;
+		else
+			this->mFatigue = 100;
+	}
+}
+
+const S32 iAIAgent::getFatigue()
+{
+	return this->mFatigue;
+}
+
+void iAIAgent::setMoney(const F32 money)
+{
+	if ((money >= 0) && (money <= 10000))
+	{
+		this->mMoney = money;
+	} else
+	{
+		if (money < 0)
+			this->mMoney = 0;
+		else
+			this->mMoney = 10000;
+	}
+}
+
+const F32 iAIAgent::getMoney()
+{
+	return this->mMoney;
+}
+
+void iAIAgent::setBoredom(const S32 boredom)
+{
+	if ((boredom >= 0) && (boredom <= 100))
+	{
+		this->mBoredom = boredom;
+	} else
+	{
+		if (boredom < 0)
+			this->mBoredom = 0;
+		else
+			this->mBoredom = 100;
+	}
+}
+
+const S32 iAIAgent::getBoredom()
+{
+	return this->mBoredom;
+}
+
+void iAIAgent::setLevel(const S32 level)
+{
+	if ((level >= 1) && (level <= 100))
+	{
+		this->mLevel = level;
+	} else
+	{
+		if (level < 1)
+			this->mLevel = 1;
+		else
+			this->mLevel = 100;
+	}
+}
+
+const S32 iAIAgent::getLevel()
+{
+	return this->mLevel;
+}
+
+ConsoleMethodGroupBegin(iAIAgent, ScriptFunctions, "iAIAgent Script Functions");
+
+ConsoleMethod( iAIAgent, getCurrentPath, S32, 2, 2,
+			  "S32 iAIAgent.getCurrentPath() - Retrieves the iAIPath showing the agent's path; 0 unless showPath is set.")
+{
+	iAIPath *debugPath = object->getDebugPath();
+	if (debugPath)
+		return (debugPath->getId());
+	else
+		return 0;
+}
+
+ConsoleMethod( iAIAgent, findPath, bool, 3, 5,
+			  "bool iAIAgent.findPath(Point3F destination, float radius = -1, string profile = \"\") - Finds a path from the agent to the destination, fitted to the agent's bounds and costed by its type's profile unless given.")
+{
+	// ensure pos passed
+	if (dStrlen(argv[2]) != 0)
+	{
+		Point3F destination;
+		dSscanf(argv[2], "%f %f %f", &destination.x, &destination.y, &destination.z);
+
+		F32 radius = (argc > 3) && (dStrlen(argv[3]) != 0) ? dAtof(argv[3]) : -1.0f;
+		const char *profile = (argc > 4) ? argv[4] : 0;
+		return (object->findPath(destination, radius, profile));
+	} else
+	{
+		Con::errorf("Immersive AI :: Agent :: destination not passed!");
+		return false;
+	}
+}
+
+ConsoleMethod( iAIAgent, requestCooperativePath, bool, 3, 3,
+			  "bool iAIAgent.requestCooperativePath(Point3F destination) - Queues the agent to plan a path around the other agents' reservations, followed once planned. Returns false if cooperativePath or $iAIPathMap::cooperative is off.")
+{
+	Point3F destination;
+	dSscanf(argv[2], "%f %f %f", &destination.x, &destination.y, &destination.z);
+	return (object->requestCooperativePath(destination));
+}
+
+ConsoleMethod( iAIAgent, followPath, bool, 2, 2,
+			  "bool iAIAgent.followPath() - Starts the agent moving along its path; onPathComplete or onPathBlocked is called on the datablock when done.")
+{
+	return (object->followPath());
+}
+
+ConsoleMethod( iAIAgent, isFollowingPath, bool, 2, 2,
+			  "bool iAIAgent.isFollowingPath() - Returns if the agent is moving along its path.")
+{
+	return (object->isFollowingPath());
+}
+
+ConsoleMethod( iAIAgent, clearPath, void, 2, 2,
+			  "void iAIAgent.clearPath() - Lets go of the agent's current path.")
+{
+	object->clearPath();
+}
+
+ConsoleMethod( iAIAgent, hasPath, bool, 2, 2,
+			  "bool iAIAgent.hasPath() - Returns if the agent has a path which hasn't been cleared, finished or not.")
+{
+	return (object->hasPath());
+}
+
+ConsoleMethod( iAIAgent, hasNextPathNode, bool, 2, 2,
+			  "bool iAIAgent.hasNextPathNode() - Returns if the agent's path has another position.")
+{
+	return (object->hasPath() && object->getPath()->hasNextNode());
+}
+
+ConsoleMethod( iAIAgent, nextPathPosition, const char*, 2, 2,
+			  "Point3F iAIAgent.nextPathPosition() - Get the next position on the agent's path.")
+{
+	char *returnBuffer = Con::getReturnBuffer(256);
+
+	Point3F nextPosition = object->hasPath() ? object->getPath()->getNextPosition() : IAIPATHGLOBAL_INVALID_POSITION;
+	if (nextPosition != IAIPATHGLOBAL_INVALID_POSITION)
+	{
+		dSprintf(returnBuffer, 256, "%f %f %f", nextPosition.x, nextPosition.y, nextPosition.z);
+	} else
+	{
+		dSprintf(returnBuffer, 256, "");
+	}
+
+	return returnBuffer;
+}
+
+ConsoleMethod( iAIAgent, isPathPending, bool, 2, 2,
+			  "bool iAIAgent.isPathPending() - Returns if findPath failed waiting on pathmap tiles to load; try again shortly.")
+{
+	return (object->getPath() && object->getPath()->isPending());
+}
+
+ConsoleMethod( iAIAgent, getPathGoal, const char*, 2, 2,
+			  "Point3F iAIAgent.getPathGoal() - Returns the position the agent's path was found to reach.")
+{
+	char *returnBuffer = Con::getReturnBuffer(256);
+
+	Point3F goal = object->getPath() ? object->getPath()->getGoal() : Point3F(0,0,0);
+	dSprintf(returnBuffer, 256, "%f %f %f", goal.x, goal.y, goal.z);
+
+	return returnBuffer;
+}
+
+//-------------------------------------------------------------------
+// Variable accessors/mutators
+//-------------------------------------------------------------------
+
+ConsoleMethod( iAIAgent, setAgentType, void, 3, 3,
+			  "void iAIAgent.setAgentType(string agentType) - Set the type of agent.")
+{
+	object->setAgentType(argv[2]);
+}
+
+ConsoleMethod( iAIAgent, getAgentType, const char*, 2, 2,
+			  "string iAIAgent.getAgentType() - Get the type of agent.")
+{
+	const char *agentType = object->getAgentType();
+	char *returnBuffer = Con::getReturnBuffer(dStrlen(agentType) + 1);
+	dSprintf(returnBuffer, sizeof(returnBuffer), "%s", agentType);
+
+	return returnBuffer;
+}
+
+ConsoleMethod( iAIAgent, setHealth, void, 3, 3,
+			  "void iAIAgent.setHealth(S8 health) - Set the health level.")
+{
+	object->setHealth(dAtoi(argv[2]));
+}
+
+ConsoleMethod( iAIAgent, getHealth, S32, 2, 2,
+			  "S8 iAIAgent.getHealth() - Get the health level.")
+{
+	return object->getHealth();
+}
+
+ConsoleMethod( iAIAgent, setHappiness, void, 3, 3,
+			  "void iAIAgent.setHappiness(S32 happiness) - Set the happiness level.")
+{
+	object->setHappiness(dAtoi(argv[2]));
+}
+
+ConsoleMethod( iAIAgent, getHappiness, S32, 2, 2,
+			  "S8 iAIAgent.getHappiness() - Get the happiness level.")
+{
+	return object->getHappiness();
+}
+
+ConsoleMethod( iAIAgent, setFatigue, void, 3, 3,
+			  "void iAIAgent.setFatigue(S32 fatigue) - Set the fatigue level.")
+{
+	object->setFatigue(dAtoi(argv[2]));
+}
+
+ConsoleMethod( iAIAgent, getFatigue, S32, 2, 2,
+			  "S8 iAIAgent.getFatigue() - Get the fatigue level.")
+{
+	return object->getFatigue();
+}
+
+ConsoleMethod( iAIAgent, setMoney, void, 3, 3,
+			  "void iAIAgent.setMoney(F32 money) - Set the money level.")
+{
+	object->setMoney(dAtof(argv[2]));
+}
+
+ConsoleMethod( iAIAgent, getMoney, S32, 2, 2,
+			  "F32 iAIAgent.getMoney() - Get the money level.")
+{
+	return object->getMoney();
+}
+
+ConsoleMethod( iAIAgent, setBoredom, void, 3, 3,
+			  "void iAIAgent.setBoredom(S32 boredom) - Set the boredom level.")
+{
+	object->setBoredom(dAtoi(argv[2]));
+}
+
+ConsoleMethod( iAIAgent, getBoredom, S32, 2, 2,
+			  "S8 iAIAgent.getBoredom() - Get the boredom level.")
+{
+	return object->getBoredom();
+}
+
+ConsoleMethod( iAIAgent, setLevel, void, 3, 3,
+			  "void iAIAgent.setLevel(S32 level) - Set the agent level.")
+{
+	object->setLevel(dAtoi(argv[2]));
+}
+
+ConsoleMethod( iAIAgent, getLevel, S32, 2, 2,
+			  "S8 iAIAgent.getLevel() - Get the agent level.")
+{
+	return object->getLevel();
+}
+
 ConsoleMethodGroupEnd(iAIAgent, ScriptFunctions);
\ No newline at end of file
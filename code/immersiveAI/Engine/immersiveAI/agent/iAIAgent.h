@@ -1,259 +1,526 @@
-//-------------------------------------------------------------------
-// Immersive AI :: Agent
-// Copyright (c) 2006 Gavin Bunney & Tom Romano
-//-------------------------------------------------------------------
-
-//-------------------------------------------------------------------
-/// @file iAIAgent.h
-//-------------------------------------------------------------------
-/// @class iAIAgent
-/// @author Gavin Bunney
-/// @version 1.0
-/// @brief The AI Agent within the game world.
-/// 
-/// The iAIAgent class holds all information about an agent within
-/// the game world. It maintains its current goal list, state and
-/// vital statistics.<br><br>
-/// It is an extension to the standard Torque AIPlayer class. The
-/// AIPlayer class handles the movement within the game world and
-/// the process of aiming towards an object. All other agent logic is
-/// contained within this iAIAgent class.<br><br>
-///
-/// TypeMask |= iAIAgentObjectType
-//-------------------------------------------------------------------
-
-#ifndef _IAIAGENT_H_
-#define _IAIAGENT_H_
-
-#include "game/aiPlayer.h"
-#include "immersiveAI/seek/path/iAIPath.h"
-
-class iAIAgent : public AIPlayer
-{
-	typedef AIPlayer Parent;
-	friend class iAIGoalManager;
-
-public:
-
-	//-------------------------------------------------------------------
-	/// @var DECLARE_CONOBJECT(iAIAgent)
-	/// @brief TorqueScript object.
-	//-------------------------------------------------------------------
-	DECLARE_CONOBJECT(iAIAgent);
-	
-	//-------------------------------------------------------------------
-	/// @fn iAIAgent() 
-	/// @brief Default constructor.
-	//-------------------------------------------------------------------
-	iAIAgent();
-
-	//-------------------------------------------------------------------
-	/// @fn ~iAIAgent() 
-	/// @brief Destructor.
-	//-------------------------------------------------------------------
-	~iAIAgent();
-
-	//-------------------------------------------------------------------
-	/// @fn static void initPersistFields()
-	/// @brief Exposes some variables to TorqueScript.
-	//-------------------------------------------------------------------
-	static void initPersistFields();
-
-	//-------------------------------------------------------------------
-	/// @fn void setCurrentPath(iAIPath* path)
-	/// @brief Sets the Agent's path to the parsed path.
-	///
-	/// @param path Pointer to the iAIPath for this agent.
-	//-------------------------------------------------------------------
-	void setCurrentPath(iAIPath* path) { this->mCurrentPath = path; }
-
-	//-------------------------------------------------------------------
-	/// @fn iAIPath* getCurrentPath()
-	/// @brief Returns the Agent's current path.
-	///
-	/// @return iAIPath Pointer to the Agent's current path.
-	//-------------------------------------------------------------------
-	iAIPath* getCurrentPath() { return this->mCurrentPath; }
-
-	//-------------------------------------------------------------------
-	/// @fn void setAgentType(const char* agentType)
-	/// @brief Set the type of agent.
-	///
-	/// @param agentType Type of the agent.
-	//-------------------------------------------------------------------
-	void setAgentType(const char* agentType) { dSprintf(this->mAgentType, sizeof(this->mAgentType), "%s", agentType); }
-	
-	//-------------------------------------------------------------------
-	/// @fn const char* getAgentType()
-	/// @brief Retrieve the type of agent.
-	///
-	/// @return char* Type of the agent.
-	//-------------------------------------------------------------------
-	const char* getAgentType() const { return this->mAgentType; }
-
-	//-------------------------------------------------------------------
-	/// @fn void setHealth(const S32 health)
-	/// @brief Set the current health value.
-	///
-	/// @param health Health value to set to.
-	//-------------------------------------------------------------------
-	void setHealth(const S32 health);
-
-	//-------------------------------------------------------------------
-	/// @fn const S32 getHealth()
-	/// @brief Retrieve the current health value.
-	///
-	/// @return S32 Health value.
-	//-------------------------------------------------------------------
-	const S32 getHealth();
-
-	//-------------------------------------------------------------------
-	/// @fn void setHappiness(const S32 happiness)
-	/// @brief Set the current happiness value.
-	///
-	/// @param happiness Happiness value to set to.
-	//-------------------------------------------------------------------
-	void setHappiness(const S32 happiness);
-
-	//-------------------------------------------------------------------
-	/// @fn const S32 getHappiness()
-	/// @brief Retrieve the current happiness value.
-	///
-	/// @return S8 Happiness value.
-	//-------------------------------------------------------------------
-	const S32 getHappiness();
-
-	//-------------------------------------------------------------------
-	/// @fn void setFatigue(const S32 fatigue)
-	/// @brief Set the current fatigue value.
-	///
-	/// @param fatigue Fatigue value to set to.
-	//-------------------------------------------------------------------
-	void setFatigue(const S32 fatigue);
-
-	//-------------------------------------------------------------------
-	/// @fn const S32 getFatigue()
-	/// @brief Retrieve the current fatigue value.
-	///
-	/// @return S8 Fatigue value.
-	//-------------------------------------------------------------------
-	const S32 getFatigue();
-
-	//-------------------------------------------------------------------
-	/// @fn void setMoney(const F32 money)
-	/// @brief Set the current money value.
-	///
-	/// @param money Money value to set to.
-	//-------------------------------------------------------------------
-	void setMoney(const F32 money);
-	
-	//-------------------------------------------------------------------
-	/// @fn const F32 getMoney()
-	/// @brief Retrieve the current money value.
-	///
-	/// @return F32 Money value.
-	//-------------------------------------------------------------------
-	const F32 getMoney();
-
-	//-------------------------------------------------------------------
-	/// @fn void setBoredom(const S32 boredom)
-	/// @brief Set the current boredom value.
-	///
-	/// @param boredom Boredom value to set to.
-	//-------------------------------------------------------------------
-	void setBoredom(const S32 boredom);
-	
-	//-------------------------------------------------------------------
-	/// @fn const S32 getBoredom()
-	/// @brief Retrieve the current boredom value.
-	///
-	/// @return S32 Boredom value.
-	//-------------------------------------------------------------------
-	const S32 getBoredom();
-
-	//-------------------------------------------------------------------
-	/// @fn void setLevel(const S32 level)
-	/// @brief Set the current level value.
-	///
-	/// @param level Level value to set to.
-	//-------------------------------------------------------------------
-	void setLevel(const S32 level);
-	
-	//-------------------------------------------------------------------
-	/// @fn const S32 getLevel()
-	/// @brief Retrieve the current level value.
-	///
-	/// @return S32 Level value.
-	//-------------------------------------------------------------------
-	const S32 getLevel();
-
-protected:
-
-	//-------------------------------------------------------------------
-	/// @var char mAgentType[255]
-	/// @brief Name of the agent's type.
-	//-------------------------------------------------------------------
-	char mAgentType[255];
-
-	//-------------------------------------------------------------------
-	/// @var iAIPath* mCurrentPath
-	/// @brief Pointer to the Agent's current path.
-	//-------------------------------------------------------------------
-	iAIPath* mCurrentPath;
-
-	//-------------------------------------------------------------------
-	/// @var S32 mHappiness
-	/// @brief Happiness level of the agent. 0 is really angry, 100 is
-	///        really happy.
-	//-------------------------------------------------------------------
-	S32 mHappiness;
-
-	//-------------------------------------------------------------------
-	/// @var S32 mFatigue
-	/// @brief Fatigue level of the agent. 0 is really awake, 100 is 
-	///        really tired.
-	//-------------------------------------------------------------------
-	S32 mFatigue;
-
-	//-------------------------------------------------------------------
-	/// @var F32 mMoney
-	/// @brief Amount of money the agent has. 0 is really poor, 10 000 is
-	///        really rich.
-	//-------------------------------------------------------------------
-	F32 mMoney;
-
-	//-------------------------------------------------------------------
-	/// @var S32 mBoredom
-	/// @brief Boredom level of the agent. 0 is really excited, 100 is 
-	///        really bored.
-	//-------------------------------------------------------------------
-	S32 mBoredom;
-
-	//-------------------------------------------------------------------
-	/// @var S32 mLevel
-	/// @brief Level of the agent. 1 is really weak, 100 is really
-	///        strong.
-	//-------------------------------------------------------------------
-	S32 mLevel;
-
-private:
-	
-	//-------------------------------------------------------------------
-	/// @fn void executeFunction(const char *name)
-	/// @brief Executes a TorqueScript function
-	///
-	/// @param name The name of the function to execute.
-	//-------------------------------------------------------------------
-	void executeFunction(const char *name);
-
-	//-------------------------------------------------------------------
-	/// @fn void executeDatablockFunction(const char *name)
-	/// @brief Executes a TorqueScript function contained within the
-	///        agent's datablock.
-	///
-	/// @param name The name of the function to execute.
-	//-------------------------------------------------------------------
-	void executeDatablockFunction(const char *name);
-};
-
-#endif
+//-------------------------------------------------------------------
+// Immersive AI :: Agent
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+//-------------------------------------------------------------------
+/// @file iAIAgent.h
+//-------------------------------------------------------------------
+/// @class iAIAgent
+/// @author Gavin Bunney
+/// @version 1.0
+/// @brief The AI Agent within the game world.
+/// 
+/// The iAIAgent class holds all information about an agent within
+/// the game world. It maintains its current goal list, state and
+/// vital statistics.<br><br>
+/// It is an extension to the standard Torque AIPlayer class. The
+/// AIPlayer class handles the movement within the game world and
+/// the process of aiming towards an object. All other agent logic is
+/// contained within this iAIAgent class.<br><br>
+/// Paths are followed natively each tick; the agent steers for the
+/// next corner once within its lookahead of the current one, and
+/// only calls back to script when the path is complete or blocked.
+/// <br><br>
+/// Each tick the agent's move is steered around the agents near it
+/// by iAIAvoidance, unless $iAIAvoidance::enabled is false. The
+/// agent is counted on the node it stands on in iAIPathDensity, so
+/// paths found by others are routed around crowds.
+/// <br><br>
+/// Agents with cooperativePath set plan around each other's reserved
+/// nodes through iAIPathReservation, while $iAIPathMap::cooperative
+/// is on, waiting on their path for the time planned.
+/// <br><br>
+///
+/// TypeMask |= iAIAgentObjectType
+//-------------------------------------------------------------------
+
+#ifndef _IAIAGENT_H_
+#define _IAIAGENT_H_
+
+#include "game/aiPlayer.h"
+#include "immersiveAI/seek/path/iAIPath.h"
+
+//-------------------------------------------------------------------
+/// @def IAIAGENT_PATH_LOOKAHEAD
+/// @brief Default distance in X & Y from a path corner at which the
+///        agent turns for the next one, cutting the corner. Can be
+///        changed per agent via the pathLookahead field.
+//-------------------------------------------------------------------
+#define IAIAGENT_PATH_LOOKAHEAD		3.0f
+
+//-------------------------------------------------------------------
+/// @def IAIAGENT_PATH_STUCK_TOLERANCE
+/// @brief Distance the agent must move from where it was last seen
+///        moving for it not to count as stuck on its path.
+//-------------------------------------------------------------------
+#define IAIAGENT_PATH_STUCK_TOLERANCE	0.5f
+
+//-------------------------------------------------------------------
+/// @def IAIAGENT_PATH_STUCK_TICKS
+/// @brief Ticks the agent stays within IAIAGENT_PATH_STUCK_TOLERANCE
+///        before its path is reported blocked; long enough to give way
+///        to others in a crowd.
+//-------------------------------------------------------------------
+#define IAIAGENT_PATH_STUCK_TICKS		64
+
+//-------------------------------------------------------------------
+/// @def IAIAGENT_CROWD_STEP
+/// @brief Distance in X & Y the agent moves before the node it is
+///        counted on in the crowd density is looked up again.
+//-------------------------------------------------------------------
+#define IAIAGENT_CROWD_STEP			1.0f
+
+class iAIAgent : public AIPlayer
+{
+	typedef AIPlayer Parent;
+	friend class iAIGoalManager;
+	friend class iAIAvoidance;
+
+public:
+
+	//-------------------------------------------------------------------
+	/// @var DECLARE_CONOBJECT(iAIAgent)
+	/// @brief TorqueScript object.
+	//-------------------------------------------------------------------
+	DECLARE_CONOBJECT(iAIAgent);
+	
+	//-------------------------------------------------------------------
+	/// @fn iAIAgent() 
+	/// @brief Default constructor.
+	//-------------------------------------------------------------------
+	iAIAgent();
+
+	//-------------------------------------------------------------------
+	/// @fn ~iAIAgent() 
+	/// @brief Destructor.
+	//-------------------------------------------------------------------
+	~iAIAgent();
+
+	//-------------------------------------------------------------------
+	/// @fn static void initPersistFields()
+	/// @brief Exposes some variables to TorqueScript.
+	//-------------------------------------------------------------------
+	static void initPersistFields();
+
+	//-------------------------------------------------------------------
+	/// @fn bool onAdd()
+	/// @brief Called on addition to Sim. Adds the agent to be avoided.
+	///
+	/// @return Addition success.
+	//-------------------------------------------------------------------
+	bool onAdd();
+
+	//-------------------------------------------------------------------
+	/// @fn void onRemove()
+	/// @brief Called on removal from Sim. Gives back the agent's path,
+	///        and stops others avoiding it.
+	//-------------------------------------------------------------------
+	void onRemove();
+
+	//-------------------------------------------------------------------
+	/// @fn F32 getRadius()
+	/// @brief Retrieves the radius of the agent's bounds in X & Y.
+	///
+	/// @return F32 radius.
+	//-------------------------------------------------------------------
+	F32 getRadius();
+
+	//-------------------------------------------------------------------
+	/// @fn bool findPath(const Point3F &destination, F32 radius = -1.0f,
+	///                   const char *profile = 0)
+	/// @brief Finds a path from the agent's position to the destination,
+	///        replacing its current path.
+	///
+	/// @param destination Point3F to find the path to.
+	/// @param radius Radius to fit the path to. If negative, fits it to
+	///        the agent's bounds.
+	/// @param profile Name of the cost profile. If not set, the profile
+	///        named after the agent's type.
+	/// @return Path found. If the pathmap is paging in tiles, fails with
+	///         isPathPending() set.
+	//-------------------------------------------------------------------
+	bool findPath(const Point3F &destination, F32 radius = -1.0f, const char *profile = 0);
+
+	//-------------------------------------------------------------------
+	/// @fn bool requestCooperativePath(const Point3F &destination)
+	/// @brief Queues the agent to plan a cooperative path with the
+	///        others asking this tick; followed once planned.
+	///
+	/// @param destination Point3F to plan the path to.
+	/// @return false if cooperativePath or $iAIPathMap::cooperative is
+	///         off, or there's no pathmap; find the path as usual.
+	//-------------------------------------------------------------------
+	bool requestCooperativePath(const Point3F &destination);
+
+	//-------------------------------------------------------------------
+	/// @fn void planCooperativePath(iAIPathMap *pathMap,
+	///                              const Point3F &destination,
+	///                              const U32 startStep)
+	/// @brief Plans the cooperative path requested, then follows it. If
+	///        it can't be planned, generatePath is called on the agent
+	///        to find one on its own. Called by iAIPathReservation.
+	///
+	/// @param pathMap pathmap to plan on.
+	/// @param destination Point3F to plan the path to.
+	/// @param startStep step of time the path starts at.
+	//-------------------------------------------------------------------
+	void planCooperativePath(iAIPathMap *pathMap, const Point3F &destination, const U32 startStep);
+
+	//-------------------------------------------------------------------
+	/// @fn void clearPath()
+	/// @brief Lets go of the agent's current path.
+	//-------------------------------------------------------------------
+	void clearPath();
+
+	//-------------------------------------------------------------------
+	/// @fn bool followPath()
+	/// @brief Starts the agent moving along its path, from the next
+	///        position on it. Followed each tick until complete, when
+	///        onPathComplete is called on the datablock, or blocked, when
+	///        onPathBlocked is.
+	///
+	/// @return true if there was a position left to move to.
+	//-------------------------------------------------------------------
+	bool followPath();
+
+	//-------------------------------------------------------------------
+	/// @fn bool isFollowingPath()
+	/// @brief Checks if the agent is moving along its path.
+	///
+	/// @return true if following the path.
+	//-------------------------------------------------------------------
+	bool isFollowingPath() { return this->mFollowingPath; }
+
+	//-------------------------------------------------------------------
+	/// @fn void processTick(const Move *move)
+	/// @brief Steps the agent along its path, then moves it.
+	///
+	/// @param move Move for the tick.
+	//-------------------------------------------------------------------
+	void processTick(const Move *move);
+
+	//-------------------------------------------------------------------
+	/// @fn bool getAIMove(Move *move)
+	/// @brief Gets AIPlayer's move towards the destination, then steers
+	///        it around the agents nearby.
+	///
+	/// @param move Move to fill in.
+	/// @return true if the move was filled in.
+	//-------------------------------------------------------------------
+	bool getAIMove(Move *move);
+
+	//-------------------------------------------------------------------
+	/// @fn bool hasPath()
+	/// @brief Checks if the agent has a path, finished or not, which
+	///        hasn't been cleared.
+	///
+	/// @return true if the agent has a path.
+	//-------------------------------------------------------------------
+	bool hasPath() { return (this->mPath && this->mPath->hasPath()); }
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathHandle* getPath()
+	/// @brief Returns the handle of the Agent's path.
+	///
+	/// @return iAIPathHandle pointer; 0 if no path has been found yet.
+	//-------------------------------------------------------------------
+	iAIPathHandle* getPath() { return this->mPath; }
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPath* getDebugPath()
+	/// @brief Returns the path object showing the Agent's path.
+	///
+	/// @return iAIPath pointer; 0 unless showPath is set.
+	//-------------------------------------------------------------------
+	iAIPath* getDebugPath() { return this->mDebugPath; }
+
+	//-------------------------------------------------------------------
+	/// @fn void setAgentType(const char* agentType)
+	/// @brief Set the type of agent.
+	///
+	/// @param agentType Type of the agent.
+	//-------------------------------------------------------------------
+	void setAgentType(const char* agentType) { dSprintf(this->mAgentType, sizeof(this->mAgentType), "%s", agentType); }
+	
+	//-------------------------------------------------------------------
+	/// @fn const char* getAgentType()
+	/// @brief Retrieve the type of agent.
+	///
+	/// @return char* Type of the agent.
+	//-------------------------------------------------------------------
+	const char* getAgentType() const { return this->mAgentType; }
+
+	//-------------------------------------------------------------------
+	/// @fn void setHealth(const S32 health)
+	/// @brief Set the current health value.
+	///
+	/// @param health Health value to set to.
+	//-------------------------------------------------------------------
+	void setHealth(const S32 health);
+
+	//-------------------------------------------------------------------
+	/// @fn const S32 getHealth()
+	/// @brief Retrieve the current health value.
+	///
+	/// @return S32 Health value.
+	//-------------------------------------------------------------------
+	const S32 getHealth();
+
+	//-------------------------------------------------------------------
+	/// @fn void setHappiness(const S32 happiness)
+	/// @brief Set the current happiness value.
+	///
+	/// @param happiness Happiness value to set to.
+	//-------------------------------------------------------------------
+	void setHappiness(const S32 happiness);
+
+	//-------------------------------------------------------------------
+	/// @fn const S32 getHappiness()
+	/// @brief Retrieve the current happiness value.
+	///
+	/// @return S8 Happiness value.
+	//-------------------------------------------------------------------
+	const S32 getHappiness();
+
+	//-------------------------------------------------------------------
+	/// @fn void setFatigue(const S32 fatigue)
+	/// @brief Set the current fatigue value.
+	///
+	/// @param fatigue Fatigue value to set to.
+	//-------------------------------------------------------------------
+	void setFatigue(const S32 fatigue);
+
+	//-------------------------------------------------------------------
+	/// @fn const S32 getFatigue()
+	/// @brief Retrieve the current fatigue value.
+	///
+	/// @return S8 Fatigue value.
+	//-------------------------------------------------------------------
+	const S32 getFatigue();
+
+	//-------------------------------------------------------------------
+	/// @fn void setMoney(const F32 money)
+	/// @brief Set the current money value.
+	///
+	/// @param money Money value to set to.
+	//-------------------------------------------------------------------
+	void setMoney(const F32 money);
+	
+	//-------------------------------------------------------------------
+	/// @fn const F32 getMoney()
+	/// @brief Retrieve the current money value.
+	///
+	/// @return F32 Money value.
+	//-------------------------------------------------------------------
+	const F32 getMoney();
+
+	//-------------------------------------------------------------------
+	/// @fn void setBoredom(const S32 boredom)
+	/// @brief Set the current boredom value.
+	///
+	/// @param boredom Boredom value to set to.
+	//-------------------------------------------------------------------
+	void setBoredom(const S32 boredom);
+	
+	//-------------------------------------------------------------------
+	/// @fn const S32 getBoredom()
+	/// @brief Retrieve the current boredom value.
+	///
+	/// @return S32 Boredom value.
+	//-------------------------------------------------------------------
+	const S32 getBoredom();
+
+	//-------------------------------------------------------------------
+	/// @fn void setLevel(const S32 level)
+	/// @brief Set the current level value.
+	///
+	/// @param level Level value to set to.
+	//-------------------------------------------------------------------
+	void setLevel(const S32 level);
+	
+	//-------------------------------------------------------------------
+	/// @fn const S32 getLevel()
+	/// @brief Retrieve the current level value.
+	///
+	/// @return S32 Level value.
+	//-------------------------------------------------------------------
+	const S32 getLevel();
+
+protected:
+
+	//-------------------------------------------------------------------
+	/// @var char mAgentType[255]
+	/// @brief Name of the agent's type.
+	//-------------------------------------------------------------------
+	char mAgentType[255];
+
+	//-------------------------------------------------------------------
+	/// @var iAIPathHandle* mPath
+	/// @brief The Agent's current path; taken from the pool on the
+	///        first path found, given back on removal.
+	//-------------------------------------------------------------------
+	iAIPathHandle* mPath;
+
+	//-------------------------------------------------------------------
+	/// @var SimObjectPtr<iAIPath> mDebugPath
+	/// @brief Path object showing mPath in the world, made only while
+	///        mShowPath is set.
+	//-------------------------------------------------------------------
+	SimObjectPtr<iAIPath> mDebugPath;
+
+	//-------------------------------------------------------------------
+	/// @var bool mShowPath
+	/// @brief Show the agent's paths in the world.
+	//-------------------------------------------------------------------
+	bool mShowPath;
+
+	//-------------------------------------------------------------------
+	/// @var bool mFollowingPath
+	/// @brief Set while the agent is moving along its path.
+	//-------------------------------------------------------------------
+	bool mFollowingPath;
+
+	//-------------------------------------------------------------------
+	/// @var Point3F mPathTarget
+	/// @brief Position on the path the agent is moving to.
+	//-------------------------------------------------------------------
+	Point3F mPathTarget;
+
+	//-------------------------------------------------------------------
+	/// @var Point3F mPathStuckLocation
+	/// @brief Agent's position when last seen moving along the path, or
+	///        IAIPATHGLOBAL_INVALID_POSITION on the first tick.
+	//-------------------------------------------------------------------
+	Point3F mPathStuckLocation;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mPathStuckTicks
+	/// @brief Ticks the agent has stayed near mPathStuckLocation.
+	//-------------------------------------------------------------------
+	U32 mPathStuckTicks;
+
+	//-------------------------------------------------------------------
+	/// @var F32 mPathLookahead
+	/// @brief Distance in X & Y from a path corner at which the agent
+	///        turns for the next one.
+	//-------------------------------------------------------------------
+	F32 mPathLookahead;
+
+	//-------------------------------------------------------------------
+	/// @var bool mRenderPathSpline
+	/// @brief Render the shown paths as splines, rather than linear.
+	//-------------------------------------------------------------------
+	bool mRenderPathSpline;
+
+	//-------------------------------------------------------------------
+	/// @var bool mCooperativePath
+	/// @brief Plan paths around the other agents' reservations, while
+	///        $iAIPathMap::cooperative is on.
+	//-------------------------------------------------------------------
+	bool mCooperativePath;
+
+	//-------------------------------------------------------------------
+	/// @var S32 mAvoidanceIndex
+	/// @brief Index of the agent in iAIAvoidance's snapshot, or -1.
+	//-------------------------------------------------------------------
+	S32 mAvoidanceIndex;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mCrowdNodeId
+	/// @brief Id of the node the agent is counted on in the crowd
+	///        density, or IAIPATHDENSITY_NO_NODE.
+	//-------------------------------------------------------------------
+	U32 mCrowdNodeId;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mCrowdGeneration
+	/// @brief iAIPathDensity generation the agent was counted in.
+	//-------------------------------------------------------------------
+	U32 mCrowdGeneration;
+
+	//-------------------------------------------------------------------
+	/// @var Point3F mCrowdPosition
+	/// @brief Agent's position when mCrowdNodeId was looked up.
+	//-------------------------------------------------------------------
+	Point3F mCrowdPosition;
+
+	//-------------------------------------------------------------------
+	/// @var S32 mHappiness
+	/// @brief Happiness level of the agent. 0 is really angry, 100 is
+	///        really happy.
+	//-------------------------------------------------------------------
+	S32 mHappiness;
+
+	//-------------------------------------------------------------------
+	/// @var S32 mFatigue
+	/// @brief Fatigue level of the agent. 0 is really awake, 100 is 
+	///        really tired.
+	//-------------------------------------------------------------------
+	S32 mFatigue;
+
+	//-------------------------------------------------------------------
+	/// @var F32 mMoney
+	/// @brief Amount of money the agent has. 0 is really poor, 10 000 is
+	///        really rich.
+	//-------------------------------------------------------------------
+	F32 mMoney;
+
+	//-------------------------------------------------------------------
+	/// @var S32 mBoredom
+	/// @brief Boredom level of the agent. 0 is really excited, 100 is 
+	///        really bored.
+	//-------------------------------------------------------------------
+	S32 mBoredom;
+
+	//-------------------------------------------------------------------
+	/// @var S32 mLevel
+	/// @brief Level of the agent. 1 is really weak, 100 is really
+	///        strong.
+	//-------------------------------------------------------------------
+	S32 mLevel;
+
+private:
+
+	//-------------------------------------------------------------------
+	/// @fn void updateDebugPath()
+	/// @brief Makes, refreshes or deletes the path object showing the
+	///        agent's path, as mShowPath asks.
+	//-------------------------------------------------------------------
+	void updateDebugPath();
+
+	//-------------------------------------------------------------------
+	/// @fn void updatePathFollow()
+	/// @brief Steers the agent along its path for the tick; turning for
+	///        the next corner within the lookahead, and stopping on
+	///        completing the path or staying put for
+	///        IAIAGENT_PATH_STUCK_TICKS.
+	//-------------------------------------------------------------------
+	void updatePathFollow();
+
+	//-------------------------------------------------------------------
+	/// @fn void updateCrowd()
+	/// @brief Moves the agent's count in the crowd density to the node
+	///        it now stands on, once it has moved a step.
+	//-------------------------------------------------------------------
+	void updateCrowd();
+	
+	//-------------------------------------------------------------------
+	/// @fn void executeFunction(const char *name)
+	/// @brief Executes a TorqueScript function
+	///
+	/// @param name The name of the function to execute.
+	//-------------------------------------------------------------------
+	void executeFunction(const char *name);
+
+	//-------------------------------------------------------------------
+	/// @fn void executeDatablockFunction(const char *name)
+	/// @brief Executes a TorqueScript function contained within the
+	///        agent's datablock.
+	///
+	/// @param name The name of the function to execute.
+	//-------------------------------------------------------------------
+	void executeDatablockFunction(const char *name);
+};
+
+#endif
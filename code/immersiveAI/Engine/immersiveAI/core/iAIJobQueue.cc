@@ -0,0 +1,102 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Core :: iAIJobQueue
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+#include "platform/platformThread.h"
+#include "platform/platformMutex.h"
+
+#include "iAIJobQueue.h"
+
+//-------------------------------------------------------------------
+/// @class iAIJobThread
+/// @brief Worker thread which processes an iAIJobQueue.
+//-------------------------------------------------------------------
+class iAIJobThread : public Thread
+{
+public:
+
+	iAIJobThread(iAIJobQueue *queue) : Thread(0, 0, false)
+	{
+		this->mQueue = queue;
+	}
+
+	void run(S32 arg)
+	{
+		this->mQueue->process();
+	}
+
+private:
+
+	iAIJobQueue *mQueue;
+};
+
+iAIJobQueue::iAIJobQueue(const U32 jobCount, JobFunction function, void *context)
+{
+	this->mJobCount = jobCount;
+	this->mNextJob = 0;
+	this->mFunction = function;
+	this->mContext = context;
+	this->mMutex = Mutex::createMutex();
+}
+
+iAIJobQueue::~iAIJobQueue()
+{
+	Mutex::destroyMutex(this->mMutex);
+	this->mMutex = 0;
+}
+
+void iAIJobQueue::process()
+{
+	while (true)
+	{
+		// grab the next job number
+		Mutex::lockMutex(this->mMutex);
+		U32 job = this->mNextJob;
+		if (job < this->mJobCount)
+			++this->mNextJob;
+		Mutex::unlockMutex(this->mMutex);
+
+		// all jobs handed out
+		if (job >= this->mJobCount)
+			return;
+
+		this->mFunction(this->mContext, job);
+	}
+}
+
+void iAIJobQueue::run(const U32 jobCount, JobFunction function, void *context, const U32 threadCount)
+{
+	if (jobCount == 0)
+		return;
+
+	// no point having more threads than jobs
+	U32 threads = getMin(getMin(threadCount, jobCount), (U32)IAIJOBQUEUE_MAX_THREADS);
+
+	// single threaded, just run them in order
+	if (threads <= 1)
+	{
+		for (U32 i = 0; i < jobCount; ++i)
+			function(context, i);
+		return;
+	}
+
+	iAIJobQueue queue(jobCount, function, context);
+
+	// start the workers; the calling thread is the last worker
+	iAIJobThread *workers[IAIJOBQUEUE_MAX_THREADS];
+	for (U32 i = 0; i < threads - 1; ++i)
+	{
+		workers[i] = new iAIJobThread(&queue);
+		workers[i]->start();
+	}
+
+	queue.process();
+
+	// wait for everyone to finish
+	for (U32 i = 0; i < threads - 1; ++i)
+	{
+		workers[i]->join();
+		delete workers[i];
+	}
+}
@@ -0,0 +1,113 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Core :: iAIJobQueue
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+//-------------------------------------------------------------------
+/// @file iAIJobQueue.h
+//-------------------------------------------------------------------
+/// @class iAIJobQueue
+/// @author Gavin Bunney
+/// @version 1.0
+/// @brief Runs a batch of independent jobs over worker threads.
+///
+/// Jobs are numbered 0 to jobCount-1 and handed out in order to
+/// whichever thread is free next. The calling thread works on the
+/// batch too, and run() only returns once every job has finished.
+/// Jobs must only write to data owned by their own job number for
+/// the result to be independent of the thread count.
+//-------------------------------------------------------------------
+#ifndef _IAIJOBQUEUE_H_
+#define _IAIJOBQUEUE_H_
+
+#ifndef _PLATFORM_H_
+	#include "platform/platform.h"
+#endif
+
+//-------------------------------------------------------------------
+/// @def IAIJOBQUEUE_MAX_THREADS
+/// @brief Maximum number of threads working on a batch.
+//-------------------------------------------------------------------
+#define IAIJOBQUEUE_MAX_THREADS		16
+
+class iAIJobQueue
+{
+	friend class iAIJobThread;
+
+public:
+
+	//-------------------------------------------------------------------
+	/// @typedef void (*JobFunction)(void *context, const U32 job)
+	/// @brief Function executed for each job in the batch.
+	//-------------------------------------------------------------------
+	typedef void (*JobFunction)(void *context, const U32 job);
+
+	//-------------------------------------------------------------------
+	/// @fn static void run(const U32 jobCount, JobFunction function,
+	///                     void *context, const U32 threadCount)
+	/// @brief Executes the function for every job, spread over the
+	///        parsed number of threads. A thread count of 1 or less
+	///        runs every job on the calling thread.
+	///
+	/// @param jobCount Number of jobs in the batch.
+	/// @param function Function to execute for each job.
+	/// @param context Pointer parsed through to the function.
+	/// @param threadCount Number of threads to use, including the
+	///        calling thread.
+	//-------------------------------------------------------------------
+	static void run(const U32 jobCount, JobFunction function, void *context, const U32 threadCount);
+
+private:
+
+	//-------------------------------------------------------------------
+	/// @fn iAIJobQueue(const U32 jobCount, JobFunction function,
+	///                 void *context)
+	/// @brief Creates the queue for a single batch.
+	//-------------------------------------------------------------------
+	iAIJobQueue(const U32 jobCount, JobFunction function, void *context);
+
+	//-------------------------------------------------------------------
+	/// @fn ~iAIJobQueue()
+	/// @brief Deconstructor which frees the queue mutex.
+	//-------------------------------------------------------------------
+	~iAIJobQueue();
+
+	//-------------------------------------------------------------------
+	/// @fn void process()
+	/// @brief Takes jobs off the queue and executes them until the
+	///        queue is empty.
+	//-------------------------------------------------------------------
+	void process();
+
+	//-------------------------------------------------------------------
+	/// @var U32 mJobCount
+	/// @brief Number of jobs in the batch.
+	//-------------------------------------------------------------------
+	U32 mJobCount;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mNextJob
+	/// @brief Number of the next job to hand out.
+	//-------------------------------------------------------------------
+	U32 mNextJob;
+
+	//-------------------------------------------------------------------
+	/// @var JobFunction mFunction
+	/// @brief Function executed for each job.
+	//-------------------------------------------------------------------
+	JobFunction mFunction;
+
+	//-------------------------------------------------------------------
+	/// @var void* mContext
+	/// @brief Pointer parsed through to the job function.
+	//-------------------------------------------------------------------
+	void *mContext;
+
+	//-------------------------------------------------------------------
+	/// @var void* mMutex
+	/// @brief Guards mNextJob.
+	//-------------------------------------------------------------------
+	void *mMutex;
+};
+
+#endif
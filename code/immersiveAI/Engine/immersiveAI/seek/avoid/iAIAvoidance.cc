@@ -0,0 +1,443 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIAvoidance
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+#include "platform/profiler.h"
+
+#include "iAIAvoidance.h"
+#include "immersiveAI/agent/iAIAgent.h"
+
+iAIAvoidance* iAIAvoidance::mInstance = 0;
+
+iAIAvoidance* iAIAvoidance::getInstance()
+{
+	// if an instance doesn't exist yet, create one!
+	if (!mInstance)
+	{
+		mInstance = new iAIAvoidance();
+	}
+	return mInstance;
+}
+
+iAIAvoidance::iAIAvoidance()
+{
+	this->mBuildTime = 0;
+	this->mDirty = true;
+	this->mNeighbourDist = IAIAVOIDANCE_NEIGHBOUR_DIST;
+	this->mMaxNeighbours = IAIAVOIDANCE_MAX_NEIGHBOURS;
+	this->mTimeHorizon = IAIAVOIDANCE_TIME_HORIZON;
+
+	for (U32 i = 0; i < IAIAVOIDANCE_HASH_SIZE; ++i)
+		this->mBuckets[i] = -1;
+}
+
+bool iAIAvoidance::isEnabled()
+{
+	return Con::getBoolVariable("$iAIAvoidance::enabled", true);
+}
+
+void iAIAvoidance::addAgent(iAIAgent *agent)
+{
+	agent->mAvoidanceIndex = -1;
+	this->mAgents.push_back(agent);
+	this->mDirty = true;
+}
+
+void iAIAvoidance::removeAgent(iAIAgent *agent)
+{
+	for (U32 i = 0; i < this->mAgents.size(); ++i)
+	{
+		if (this->mAgents[i] == agent)
+		{
+			this->mAgents.erase_fast(i);
+			break;
+		}
+	}
+
+	// the snapshot points at the agent; retake it before it's used again
+	this->mEntries.clear();
+	for (U32 i = 0; i < IAIAVOIDANCE_HASH_SIZE; ++i)
+		this->mBuckets[i] = -1;
+
+	for (U32 i = 0; i < this->mAgents.size(); ++i)
+		this->mAgents[i]->mAvoidanceIndex = -1;
+
+	this->mDirty = true;
+}
+
+inline U32 iAIAvoidance::getBucket(const S32 cellX, const S32 cellY)
+{
+	return (U32(cellX * 73856093) ^ U32(cellY * 19349663)) & (IAIAVOIDANCE_HASH_SIZE - 1);
+}
+
+inline F32 iAIAvoidance::det(const Point2F &a, const Point2F &b)
+{
+	return (a.x * b.y) - (a.y * b.x);
+}
+
+inline F32 iAIAvoidance::dot(const Point2F &a, const Point2F &b)
+{
+	return (a.x * b.x) + (a.y * b.y);
+}
+
+void iAIAvoidance::rebuild()
+{
+	// once per tick is enough; every agent moves from where they all were
+	if (!this->mDirty && (this->mBuildTime == Sim::getCurrentTime()))
+		return;
+
+	PROFILE_START(iAIAvoidance_rebuild);
+
+	this->mBuildTime = Sim::getCurrentTime();
+	this->mDirty = false;
+
+	this->mNeighbourDist = getMax(Con::getFloatVariable("$iAIAvoidance::neighbourDist", IAIAVOIDANCE_NEIGHBOUR_DIST), 1.0f);
+	this->mMaxNeighbours = getMax(Con::getIntVariable("$iAIAvoidance::maxNeighbours", IAIAVOIDANCE_MAX_NEIGHBOURS), 1);
+	this->mTimeHorizon = getMax(Con::getFloatVariable("$iAIAvoidance::timeHorizon", IAIAVOIDANCE_TIME_HORIZON), 0.1f);
+
+	for (U32 i = 0; i < IAIAVOIDANCE_HASH_SIZE; ++i)
+		this->mBuckets[i] = -1;
+
+	this->mEntries.clear();
+	this->mEntries.reserve(this->mAgents.size());
+
+	for (U32 i = 0; i < this->mAgents.size(); ++i)
+	{
+		iAIAgent *agent = this->mAgents[i];
+		agent->mAvoidanceIndex = -1;
+
+		// the dead don't get in the way
+		if (agent->getDamageState() != ShapeBase::Enabled)
+			continue;
+
+		Point3F position = agent->getPosition();
+		Point3F velocity = agent->getVelocity();
+
+		Entry entry;
+		entry.mAgent = agent;
+		entry.mPosition.set(position.x, position.y);
+		entry.mVelocity.set(velocity.x, velocity.y);
+		entry.mRadius = agent->getRadius();
+		entry.mMoving = (dot(entry.mVelocity, entry.mVelocity) > (IAIAVOIDANCE_MOVING_SPEED * IAIAVOIDANCE_MOVING_SPEED));
+
+		// link into the bucket of its cell
+		S32 cellX = (S32)mFloor(position.x / this->mNeighbourDist);
+		S32 cellY = (S32)mFloor(position.y / this->mNeighbourDist);
+		U32 bucket = this->getBucket(cellX, cellY);
+		entry.mNext = this->mBuckets[bucket];
+		this->mBuckets[bucket] = this->mEntries.size();
+
+		agent->mAvoidanceIndex = this->mEntries.size();
+		this->mEntries.push_back(entry);
+	}
+
+	PROFILE_END();
+}
+
+void iAIAvoidance::findNeighbours(const S32 entryIndex, Vector<S32> &neighbours)
+{
+	const Entry &self = this->mEntries[entryIndex];
+	F32 rangeSquared = this->mNeighbourDist * this->mNeighbourDist;
+
+	// closest first, so the furthest makes way once full
+	Vector<F32> distances;
+
+	S32 cellX = (S32)mFloor(self.mPosition.x / this->mNeighbourDist);
+	S32 cellY = (S32)mFloor(self.mPosition.y / this->mNeighbourDist);
+
+	// anything within the neighbour distance is in this cell or one beside it
+	for (S32 y = cellY - 1; y <= cellY + 1; ++y)
+	{
+		for (S32 x = cellX - 1; x <= cellX + 1; ++x)
+		{
+			for (S32 i = this->mBuckets[this->getBucket(x, y)]; i != -1; i = this->mEntries[i].mNext)
+			{
+				if (i == entryIndex)
+					continue;
+
+				// other cells share the bucket; the distance weeds them out
+				Point2F offset = this->mEntries[i].mPosition - self.mPosition;
+				F32 distSquared = dot(offset, offset);
+				if (distSquared >= rangeSquared)
+					continue;
+
+				if ((neighbours.size() == this->mMaxNeighbours) && (distSquared >= distances.last()))
+					continue;
+
+				// the cells around can share a bucket, so the same entry can come up twice
+				bool found = false;
+				for (U32 j = 0; j < neighbours.size(); ++j)
+				{
+					if (neighbours[j] == i)
+					{
+						found = true;
+						break;
+					}
+				}
+				if (found)
+					continue;
+
+				if (neighbours.size() == this->mMaxNeighbours)
+				{
+					neighbours.pop_back();
+					distances.pop_back();
+				}
+
+				// insert in order of distance
+				U32 j = neighbours.size();
+				neighbours.push_back(i);
+				distances.push_back(distSquared);
+				while ((j > 0) && (distances[j - 1] > distSquared))
+				{
+					neighbours[j] = neighbours[j - 1];
+					distances[j] = distances[j - 1];
+					--j;
+				}
+				neighbours[j] = i;
+				distances[j] = distSquared;
+			}
+		}
+	}
+}
+
+Point2F iAIAvoidance::computeVelocity(iAIAgent *agent, const Point2F &preferredVelocity, const F32 maxSpeed)
+{
+	this->rebuild();
+
+	// added since the snapshot, or dead
+	S32 entryIndex = agent->mAvoidanceIndex;
+	if ((entryIndex < 0) || (entryIndex >= (S32)this->mEntries.size()) || (this->mEntries[entryIndex].mAgent != agent))
+		return preferredVelocity;
+
+	PROFILE_START(iAIAvoidance_computeVelocity);
+
+	Vector<S32> neighbours;
+	this->findNeighbours(entryIndex, neighbours);
+
+	if (neighbours.size() == 0)
+	{
+		PROFILE_END();
+		return preferredVelocity;
+	}
+
+	const Entry &self = this->mEntries[entryIndex];
+	F32 invTimeHorizon = 1.0f / this->mTimeHorizon;
+
+	// a half plane of allowed velocities for each neighbour
+	Vector<Line> lines;
+	lines.reserve(neighbours.size());
+	for (U32 i = 0; i < neighbours.size(); ++i)
+	{
+		const Entry &other = this->mEntries[neighbours[i]];
+
+		Point2F relativePosition = other.mPosition - self.mPosition;
+		Point2F relativeVelocity = self.mVelocity - other.mVelocity;
+		F32 distSquared = dot(relativePosition, relativePosition);
+		F32 combinedRadius = self.mRadius + other.mRadius;
+		F32 combinedRadiusSquared = combinedRadius * combinedRadius;
+
+		Line line;
+		Point2F u;
+
+		if (distSquared > combinedRadiusSquared)
+		{
+			// no collision yet; vector from the cutoff centre to the relative velocity
+			Point2F w = relativeVelocity - (relativePosition * invTimeHorizon);
+			F32 wLengthSquared = dot(w, w);
+			F32 dotProduct1 = dot(w, relativePosition);
+
+			if ((dotProduct1 < 0.0f) && ((dotProduct1 * dotProduct1) > (combinedRadiusSquared * wLengthSquared)))
+			{
+				// project on the cutoff circle
+				F32 wLength = mSqrt(wLengthSquared);
+				Point2F unitW = w / wLength;
+
+				line.mDirection.set(unitW.y, -unitW.x);
+				u = unitW * ((combinedRadius * invTimeHorizon) - wLength);
+			} else
+			{
+				// project on the legs of the cone
+				F32 leg = mSqrt(distSquared - combinedRadiusSquared);
+
+				if (det(relativePosition, w) > 0.0f)
+				{
+					// left leg
+					line.mDirection.set((relativePosition.x * leg) - (relativePosition.y * combinedRadius),
+										(relativePosition.x * combinedRadius) + (relativePosition.y * leg));
+				} else
+				{
+					// right leg
+					line.mDirection.set(-((relativePosition.x * leg) + (relativePosition.y * combinedRadius)),
+										-(-(relativePosition.x * combinedRadius) + (relativePosition.y * leg)));
+				}
+				line.mDirection = line.mDirection * (1.0f / distSquared);
+
+				F32 dotProduct2 = dot(relativeVelocity, line.mDirection);
+				u = (line.mDirection * dotProduct2) - relativeVelocity;
+			}
+		} else
+		{
+			// already overlapping; get apart within the tick
+			F32 invTimeStep = 1.0f / TickSec;
+
+			Point2F w = relativeVelocity - (relativePosition * invTimeStep);
+			F32 wLength = mSqrt(dot(w, w));
+			if (wLength < IAIAVOIDANCE_EPSILON)
+				continue;
+
+			Point2F unitW = w / wLength;
+
+			line.mDirection.set(unitW.y, -unitW.x);
+			u = unitW * ((combinedRadius * invTimeStep) - wLength);
+		}
+
+		// share the avoiding with agents on the move; walk around those standing still
+		line.mPoint = self.mVelocity + (u * (other.mMoving ? 0.5f : 1.0f));
+		lines.push_back(line);
+	}
+
+	Point2F result;
+	U32 lineFail = linearProgram2(lines, maxSpeed, preferredVelocity, false, result);
+	if (lineFail < lines.size())
+		linearProgram3(lines, lineFail, maxSpeed, result);
+
+	PROFILE_END();
+	return result;
+}
+
+bool iAIAvoidance::linearProgram1(const Vector<Line> &lines, const U32 lineNo, const F32 radius, const Point2F &optVelocity, const bool directionOpt, Point2F &result)
+{
+	const Line &line = lines[lineNo];
+
+	F32 dotProduct = dot(line.mPoint, line.mDirection);
+	F32 discriminant = (dotProduct * dotProduct) + (radius * radius) - dot(line.mPoint, line.mPoint);
+
+	// the speed circle misses the line completely
+	if (discriminant < 0.0f)
+		return false;
+
+	F32 sqrtDiscriminant = mSqrt(discriminant);
+	F32 tLeft = -dotProduct - sqrtDiscriminant;
+	F32 tRight = -dotProduct + sqrtDiscriminant;
+
+	// cut down the segment by each earlier line
+	for (U32 i = 0; i < lineNo; ++i)
+	{
+		F32 denominator = det(line.mDirection, lines[i].mDirection);
+		F32 numerator = det(lines[i].mDirection, line.mPoint - lines[i].mPoint);
+
+		if (mFabs(denominator) <= IAIAVOIDANCE_EPSILON)
+		{
+			// parallel; either all of it is allowed or none
+			if (numerator < 0.0f)
+				return false;
+			else
+				continue;
+		}
+
+		F32 t = numerator / denominator;
+		if (denominator >= 0.0f)
+			tRight = getMin(tRight, t);
+		else
+			tLeft = getMax(tLeft, t);
+
+		if (tLeft > tRight)
+			return false;
+	}
+
+	if (directionOpt)
+	{
+		// furthest along the direction
+		if (dot(optVelocity, line.mDirection) > 0.0f)
+			result = line.mPoint + (line.mDirection * tRight);
+		else
+			result = line.mPoint + (line.mDirection * tLeft);
+	} else
+	{
+		// closest to the optimal velocity
+		F32 t = mClampF(dot(line.mDirection, optVelocity - line.mPoint), tLeft, tRight);
+		result = line.mPoint + (line.mDirection * t);
+	}
+
+	return true;
+}
+
+U32 iAIAvoidance::linearProgram2(const Vector<Line> &lines, const F32 radius, const Point2F &optVelocity, const bool directionOpt, Point2F &result)
+{
+	if (directionOpt)
+	{
+		// optVelocity is a unit direction
+		result = optVelocity * radius;
+	} else if (dot(optVelocity, optVelocity) > (radius * radius))
+	{
+		// outside the speed circle; the closest point on it
+		result = optVelocity * (radius / mSqrt(dot(optVelocity, optVelocity)));
+	} else
+	{
+		result = optVelocity;
+	}
+
+	for (U32 i = 0; i < lines.size(); ++i)
+	{
+		// result breaks this line; the best is somewhere on it
+		if (det(lines[i].mDirection, lines[i].mPoint - result) > 0.0f)
+		{
+			Point2F tempResult = result;
+			if (!linearProgram1(lines, i, radius, optVelocity, directionOpt, result))
+			{
+				result = tempResult;
+				return i;
+			}
+		}
+	}
+
+	return lines.size();
+}
+
+void iAIAvoidance::linearProgram3(const Vector<Line> &lines, const U32 beginLine, const F32 radius, Point2F &result)
+{
+	F32 distance = 0.0f;
+
+	for (U32 i = beginLine; i < lines.size(); ++i)
+	{
+		if (det(lines[i].mDirection, lines[i].mPoint - result) <= distance)
+			continue;
+
+		// result breaks this line by more than any yet; find where it breaks them all the least
+		Vector<Line> projLines;
+		projLines.reserve(i);
+
+		for (U32 j = 0; j < i; ++j)
+		{
+			Line line;
+			F32 determinant = det(lines[i].mDirection, lines[j].mDirection);
+
+			if (mFabs(determinant) <= IAIAVOIDANCE_EPSILON)
+			{
+				// parallel and pointing the same way; no limit
+				if (dot(lines[i].mDirection, lines[j].mDirection) > 0.0f)
+					continue;
+
+				// opposite; half way between
+				line.mPoint = (lines[i].mPoint + lines[j].mPoint) * 0.5f;
+			} else
+			{
+				line.mPoint = lines[i].mPoint + (lines[i].mDirection * (det(lines[j].mDirection, lines[i].mPoint - lines[j].mPoint) / determinant));
+			}
+
+			line.mDirection = lines[j].mDirection - lines[i].mDirection;
+			line.mDirection = line.mDirection * (1.0f / mSqrt(dot(line.mDirection, line.mDirection)));
+			projLines.push_back(line);
+		}
+
+		Point2F tempResult = result;
+		if (linearProgram2(projLines, radius, Point2F(-lines[i].mDirection.y, lines[i].mDirection.x), true, result) < projLines.size())
+		{
+			// can only fail through rounding; keep the last result
+			result = tempResult;
+		}
+
+		distance = det(lines[i].mDirection, lines[i].mPoint - result);
+	}
+}
@@ -0,0 +1,292 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIAvoidance
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+//-------------------------------------------------------------------
+/// @file iAIAvoidance.h
+//-------------------------------------------------------------------
+/// @class iAIAvoidance
+/// @author Gavin Bunney
+/// @version 1.0
+/// @brief Steers moving agents around each other.
+///
+/// A Singleton class which adjusts each agent's velocity every tick
+/// so it won't walk into the agents around it, using optimal
+/// reciprocal collision avoidance (ORCA). Each pair of agents takes
+/// half the responsibility for missing each other; agents standing
+/// still are walked around completely.
+/// <br><br>
+/// Agents are found through a spatial hash of cells as wide as the
+/// neighbour distance, rebuilt once per tick by the first agent to
+/// move in it.
+//-------------------------------------------------------------------
+#ifndef _IAIAVOIDANCE_H_
+#define _IAIAVOIDANCE_H_
+
+#include "core/tVector.h"
+#include "math/mPoint.h"
+
+class iAIAgent;
+
+//-------------------------------------------------------------------
+/// @def IAIAVOIDANCE_NEIGHBOUR_DIST
+/// @brief Default distance within which other agents are avoided. Can
+///        be changed via $iAIAvoidance::neighbourDist.
+//-------------------------------------------------------------------
+#define IAIAVOIDANCE_NEIGHBOUR_DIST		10.0f
+
+//-------------------------------------------------------------------
+/// @def IAIAVOIDANCE_MAX_NEIGHBOURS
+/// @brief Default number of the closest agents avoided. Can be
+///        changed via $iAIAvoidance::maxNeighbours.
+//-------------------------------------------------------------------
+#define IAIAVOIDANCE_MAX_NEIGHBOURS		10
+
+//-------------------------------------------------------------------
+/// @def IAIAVOIDANCE_TIME_HORIZON
+/// @brief Default seconds ahead agents are kept from colliding. Can
+///        be changed via $iAIAvoidance::timeHorizon.
+//-------------------------------------------------------------------
+#define IAIAVOIDANCE_TIME_HORIZON		2.0f
+
+//-------------------------------------------------------------------
+/// @def IAIAVOIDANCE_MOVING_SPEED
+/// @brief Slowest an agent can go and still be on the move; agents
+///        slower than this are walked around, not shared with.
+//-------------------------------------------------------------------
+#define IAIAVOIDANCE_MOVING_SPEED		0.1f
+
+//-------------------------------------------------------------------
+/// @def IAIAVOIDANCE_HASH_SIZE
+/// @brief Number of buckets in the spatial hash; a power of two.
+//-------------------------------------------------------------------
+#define IAIAVOIDANCE_HASH_SIZE			256
+
+//-------------------------------------------------------------------
+/// @def IAIAVOIDANCE_EPSILON
+/// @brief Lines closer to parallel than this are treated as parallel.
+//-------------------------------------------------------------------
+#define IAIAVOIDANCE_EPSILON			0.00001f
+
+class iAIAvoidance {
+
+public:
+
+	//-------------------------------------------------------------------
+	/// @fn ~iAIAvoidance()
+	/// @brief Default deconstructor.
+	//-------------------------------------------------------------------
+	~iAIAvoidance() { };
+
+	//-------------------------------------------------------------------
+	/// @fn static iAIAvoidance* getInstance()
+	/// @brief Retrieves the instance of the singleton. Creates a new
+	///        instance if one doesn't exist.
+	///
+	/// @return Singleton instance pointer.
+	//-------------------------------------------------------------------
+	static iAIAvoidance* getInstance();
+
+	//-------------------------------------------------------------------
+	/// @fn static bool isEnabled()
+	/// @brief Checks if avoidance is turned on, via
+	///        $iAIAvoidance::enabled.
+	//-------------------------------------------------------------------
+	static bool isEnabled();
+
+	//-------------------------------------------------------------------
+	/// @fn void addAgent(iAIAgent *agent)
+	/// @brief Adds an agent to be avoided, and avoid others.
+	///
+	/// @param agent agent added to the Sim.
+	//-------------------------------------------------------------------
+	void addAgent(iAIAgent *agent);
+
+	//-------------------------------------------------------------------
+	/// @fn void removeAgent(iAIAgent *agent)
+	/// @brief Removes an agent added with addAgent.
+	///
+	/// @param agent agent being removed from the Sim.
+	//-------------------------------------------------------------------
+	void removeAgent(iAIAgent *agent);
+
+	//-------------------------------------------------------------------
+	/// @fn Point2F computeVelocity(iAIAgent *agent,
+	///                             const Point2F &preferredVelocity,
+	///                             const F32 maxSpeed)
+	/// @brief Finds the velocity closest to the one the agent wants
+	///        which keeps it from colliding with its neighbours within
+	///        the time horizon.
+	///
+	/// @param agent agent to steer.
+	/// @param preferredVelocity velocity in X & Y the agent wants.
+	/// @param maxSpeed fastest the agent can move.
+	/// @return Point2F velocity to move at.
+	//-------------------------------------------------------------------
+	Point2F computeVelocity(iAIAgent *agent, const Point2F &preferredVelocity, const F32 maxSpeed);
+
+private:
+
+	//-------------------------------------------------------------------
+	/// @fn iAIAvoidance::iAIAvoidance()
+	/// @brief Default constructor.
+	//-------------------------------------------------------------------
+	iAIAvoidance();
+
+	//-------------------------------------------------------------------
+	/// @var static iAIAvoidance* mInstance
+	/// @brief Instance of the singleton.
+	//-------------------------------------------------------------------
+	static iAIAvoidance* mInstance;
+
+	//-------------------------------------------------------------------
+	/// @struct Line
+	/// @brief A directed line; the velocities on its left are allowed.
+	//-------------------------------------------------------------------
+	struct Line
+	{
+		Point2F mPoint;			///< point on the line
+		Point2F mDirection;		///< unit direction of the line
+	};
+
+	//-------------------------------------------------------------------
+	/// @struct Entry
+	/// @brief An agent as it was at the start of the tick.
+	//-------------------------------------------------------------------
+	struct Entry
+	{
+		iAIAgent *mAgent;		///< the agent
+		Point2F mPosition;		///< position in X & Y
+		Point2F mVelocity;		///< velocity in X & Y
+		F32 mRadius;			///< radius of the agent's bounds
+		bool mMoving;			///< agent is faster than IAIAVOIDANCE_MOVING_SPEED
+		S32 mNext;				///< next entry in the same bucket, or -1
+	};
+
+	//-------------------------------------------------------------------
+	/// @fn void rebuild()
+	/// @brief Snapshots every agent into the spatial hash, if not done
+	///        already this tick.
+	//-------------------------------------------------------------------
+	void rebuild();
+
+	//-------------------------------------------------------------------
+	/// @fn inline U32 getBucket(const S32 cellX, const S32 cellY)
+	/// @brief Hashes a cell into a bucket index.
+	//-------------------------------------------------------------------
+	inline U32 getBucket(const S32 cellX, const S32 cellY);
+
+	//-------------------------------------------------------------------
+	/// @fn void findNeighbours(const S32 entryIndex,
+	///                         Vector<S32> &neighbours)
+	/// @brief Finds the closest entries within the neighbour distance,
+	///        up to the max neighbours, closest first.
+	///
+	/// @param entryIndex entry to find the neighbours of.
+	/// @param neighbours Vector to place the neighbour entries in.
+	//-------------------------------------------------------------------
+	void findNeighbours(const S32 entryIndex, Vector<S32> &neighbours);
+
+	//-------------------------------------------------------------------
+	/// @fn static inline F32 det(const Point2F &a, const Point2F &b)
+	/// @brief Determinant of the two vectors; positive when b is to the
+	///        left of a.
+	//-------------------------------------------------------------------
+	static inline F32 det(const Point2F &a, const Point2F &b);
+
+	//-------------------------------------------------------------------
+	/// @fn static inline F32 dot(const Point2F &a, const Point2F &b)
+	/// @brief Dot product of the two vectors.
+	//-------------------------------------------------------------------
+	static inline F32 dot(const Point2F &a, const Point2F &b);
+
+	//-------------------------------------------------------------------
+	/// @fn static bool linearProgram1(const Vector<Line> &lines,
+	///          const U32 lineNo, const F32 radius,
+	///          const Point2F &optVelocity, const bool directionOpt,
+	///          Point2F &result)
+	/// @brief Finds the velocity on one line closest to the optimal,
+	///        within the speed circle and on the allowed side of every
+	///        earlier line.
+	///
+	/// @return false if no such velocity exists.
+	//-------------------------------------------------------------------
+	static bool linearProgram1(const Vector<Line> &lines, const U32 lineNo, const F32 radius, const Point2F &optVelocity, const bool directionOpt, Point2F &result);
+
+	//-------------------------------------------------------------------
+	/// @fn static U32 linearProgram2(const Vector<Line> &lines,
+	///          const F32 radius, const Point2F &optVelocity,
+	///          const bool directionOpt, Point2F &result)
+	/// @brief Finds the velocity closest to the optimal, within the
+	///        speed circle and on the allowed side of every line.
+	///
+	/// @param directionOpt if set, optVelocity is a unit direction to go
+	///        furthest in, rather than a velocity to be closest to.
+	/// @return U32 index of the line which couldn't be met, or the
+	///         number of lines on success.
+	//-------------------------------------------------------------------
+	static U32 linearProgram2(const Vector<Line> &lines, const F32 radius, const Point2F &optVelocity, const bool directionOpt, Point2F &result);
+
+	//-------------------------------------------------------------------
+	/// @fn static void linearProgram3(const Vector<Line> &lines,
+	///          const U32 beginLine, const F32 radius, Point2F &result)
+	/// @brief When the lines can't all be met, finds the velocity which
+	///        breaks them the least.
+	///
+	/// @param beginLine line linearProgram2 failed on.
+	//-------------------------------------------------------------------
+	static void linearProgram3(const Vector<Line> &lines, const U32 beginLine, const F32 radius, Point2F &result);
+
+	//-------------------------------------------------------------------
+	/// @var Vector<iAIAgent*> mAgents
+	/// @brief Every agent added.
+	//-------------------------------------------------------------------
+	Vector<iAIAgent*> mAgents;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<Entry> mEntries
+	/// @brief Snapshot of the agents taken this tick.
+	//-------------------------------------------------------------------
+	Vector<Entry> mEntries;
+
+	//-------------------------------------------------------------------
+	/// @var S32 mBuckets[IAIAVOIDANCE_HASH_SIZE]
+	/// @brief First entry in each bucket of the spatial hash, or -1.
+	//-------------------------------------------------------------------
+	S32 mBuckets[IAIAVOIDANCE_HASH_SIZE];
+
+	//-------------------------------------------------------------------
+	/// @var U32 mBuildTime
+	/// @brief Sim time the snapshot was taken at.
+	//-------------------------------------------------------------------
+	U32 mBuildTime;
+
+	//-------------------------------------------------------------------
+	/// @var bool mDirty
+	/// @brief Set when agents are added or removed, so the snapshot
+	///        must be retaken.
+	//-------------------------------------------------------------------
+	bool mDirty;
+
+	//-------------------------------------------------------------------
+	/// @var F32 mNeighbourDist
+	/// @brief $iAIAvoidance::neighbourDist when the snapshot was taken;
+	///        also the width of the hash cells.
+	//-------------------------------------------------------------------
+	F32 mNeighbourDist;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mMaxNeighbours
+	/// @brief $iAIAvoidance::maxNeighbours when the snapshot was taken.
+	//-------------------------------------------------------------------
+	U32 mMaxNeighbours;
+
+	//-------------------------------------------------------------------
+	/// @var F32 mTimeHorizon
+	/// @brief $iAIAvoidance::timeHorizon when the snapshot was taken.
+	//-------------------------------------------------------------------
+	F32 mTimeHorizon;
+};
+
+#endif
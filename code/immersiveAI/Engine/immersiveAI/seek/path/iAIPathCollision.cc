@@ -0,0 +1,523 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathCollision
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+#include "sceneGraph/sceneGraph.h"
+#include "platform/profiler.h"
+#include "immersiveAI/core/iAIJobQueue.h"
+
+#include "iAIPathCollision.h"
+
+iAIPathCollision::iAIPathCollision()
+{
+	this->mArea = Box3F(0,0,0, 0,0,0);
+	this->mCellsX = 0;
+	this->mCellsY = 0;
+	this->mVoxelOriginZ = 0.0f;
+	this->mVoxelized = false;
+}
+
+iAIPathCollision::~iAIPathCollision()
+{
+	this->clear();
+}
+
+void iAIPathCollision::clear()
+{
+	this->mEntries.clear();
+	this->mPolys.clear();
+	this->mCellStart.clear();
+	this->mCellEntries.clear();
+	this->mVoxels.clear();
+	this->mVoxelStart.clear();
+	this->mVoxelFirstLayer.clear();
+	this->mVoxelLayers.clear();
+	this->mArea = Box3F(0,0,0, 0,0,0);
+	this->mCellsX = 0;
+	this->mCellsY = 0;
+	this->mVoxelOriginZ = 0.0f;
+	this->mVoxelized = false;
+}
+
+void iAIPathCollision::findCallback(SceneObject *object, void *key)
+{
+	iAIPathCollision *collision = static_cast<iAIPathCollision*>(key);
+
+	Entry entry;
+	entry.mObject = 0;
+	entry.mWorldBox = object->getWorldBox();
+	entry.mWorldToObj = object->getWorldTransform();
+	entry.mScale = object->getScale();
+	entry.mPolyStart = collision->mPolys.mPolyList.size();
+	entry.mPolyCount = 0;
+
+	// interiors are read only when cast against; shapes keep scratch data & can be deleted mid build, so are copied
+	if (object->getTypeMask() & InteriorObjectType)
+	{
+		entry.mObject = object;
+	} else
+	{
+		const Box3F &box = entry.mWorldBox;
+		object->buildPolyList(&collision->mPolys, box, SphereF(box.getCenter(), (box.max - box.min).len() * 0.5f));
+		entry.mPolyCount = collision->mPolys.mPolyList.size() - entry.mPolyStart;
+
+		// nothing to collide with
+		if (entry.mPolyCount == 0)
+			return;
+	}
+
+	// only objects which can't move are baked into the voxels
+	entry.mVoxelize = ((object->getTypeMask() & IAIPATHCOLLISION_VOXEL_MASK) != 0);
+
+	collision->mEntries.push_back(entry);
+}
+
+inline S32 iAIPathCollision::getCellX(const F32 x) const
+{
+	S32 cell = (S32)mFloor((x - this->mArea.min.x) / IAIPATHCOLLISION_CELL_SIZE);
+	if (cell < 0)
+		return 0;
+	if (cell >= this->mCellsX)
+		return this->mCellsX - 1;
+	return cell;
+}
+
+inline S32 iAIPathCollision::getCellY(const F32 y) const
+{
+	S32 cell = (S32)mFloor((y - this->mArea.min.y) / IAIPATHCOLLISION_CELL_SIZE);
+	if (cell < 0)
+		return 0;
+	if (cell >= this->mCellsY)
+		return this->mCellsY - 1;
+	return cell;
+}
+
+void iAIPathCollision::build(const Box3F &area, const U32 typeMask)
+{
+	PROFILE_SCOPE(iAIPathCollision_build);
+
+	this->clear();
+	this->mArea = area;
+
+	// grab every collision object in the area
+	gServerContainer.findObjects(area, typeMask, iAIPathCollision::findCallback, this);
+
+	// bucket the objects in X & Y
+	this->mCellsX = (S32)(area.len_x() / IAIPATHCOLLISION_CELL_SIZE) + 1;
+	this->mCellsY = (S32)(area.len_y() / IAIPATHCOLLISION_CELL_SIZE) + 1;
+	U32 cellCount = this->mCellsX * this->mCellsY;
+
+	this->mCellStart.setSize(cellCount + 1);
+	dMemset(this->mCellStart.address(), 0, sizeof(U32) * (cellCount + 1));
+
+	// count the entries per bucket
+	for (U32 i = 0; i < this->mEntries.size(); ++i)
+	{
+		const Box3F &box = this->mEntries[i].mWorldBox;
+		for (S32 y = this->getCellY(box.min.y); y <= this->getCellY(box.max.y); ++y)
+			for (S32 x = this->getCellX(box.min.x); x <= this->getCellX(box.max.x); ++x)
+				++this->mCellStart[(y * this->mCellsX) + x + 1];
+	}
+
+	for (U32 i = 1; i <= cellCount; ++i)
+		this->mCellStart[i] += this->mCellStart[i - 1];
+
+	// scatter the entries into their buckets
+	Vector<U32> cellFill;
+	cellFill.setSize(cellCount);
+	dMemcpy(cellFill.address(), this->mCellStart.address(), sizeof(U32) * cellCount);
+
+	this->mCellEntries.setSize(this->mCellStart[cellCount]);
+	for (U32 i = 0; i < this->mEntries.size(); ++i)
+	{
+		const Box3F &box = this->mEntries[i].mWorldBox;
+		for (S32 y = this->getCellY(box.min.y); y <= this->getCellY(box.max.y); ++y)
+			for (S32 x = this->getCellX(box.min.x); x <= this->getCellX(box.max.x); ++x)
+				this->mCellEntries[cellFill[(y * this->mCellsX) + x]++] = i;
+	}
+}
+
+void iAIPathCollision::voxelize(const U32 threadCount)
+{
+	if (this->mVoxelized)
+		return;
+
+	U32 cellCount = this->mCellsX * this->mCellsY;
+
+	// layer 0 sits just under the lowest static object
+	F32 lowest = F32_MAX;
+	for (U32 i = 0; i < this->mEntries.size(); ++i)
+	{
+		if (this->mEntries[i].mVoxelize)
+			lowest = getMin(lowest, this->mEntries[i].mWorldBox.min.z);
+	}
+	this->mVoxelOriginZ = (lowest < F32_MAX) ? ((mFloor(lowest / IAIPATHCOLLISION_VOXEL_SIZE) - 1.0f) * IAIPATHCOLLISION_VOXEL_SIZE) : 0.0f;
+
+	// each bucket only holds the layers its static objects cover
+	this->mVoxelStart.setSize(cellCount);
+	this->mVoxelFirstLayer.setSize(cellCount);
+	this->mVoxelLayers.setSize(cellCount);
+
+	U32 wordsPerLayer = (IAIPATHCOLLISION_CELL_VOXELS * IAIPATHCOLLISION_CELL_VOXELS) / 32;
+	U32 wordCount = 0;
+	for (U32 cell = 0; cell < cellCount; ++cell)
+	{
+		F32 low = F32_MAX;
+		F32 high = -F32_MAX;
+		for (U32 i = this->mCellStart[cell]; i < this->mCellStart[cell + 1]; ++i)
+		{
+			const Entry &entry = this->mEntries[this->mCellEntries[i]];
+			if (!entry.mVoxelize)
+				continue;
+
+			low = getMin(low, entry.mWorldBox.min.z);
+			high = getMax(high, entry.mWorldBox.max.z);
+		}
+
+		this->mVoxelStart[cell] = wordCount;
+		this->mVoxelFirstLayer[cell] = 0;
+		this->mVoxelLayers[cell] = 0;
+		if (low > high)
+			continue;
+
+		S32 firstLayer = (S32)mFloor((low - this->mVoxelOriginZ) / IAIPATHCOLLISION_VOXEL_SIZE);
+		S32 lastLayer = (S32)mFloor((high - this->mVoxelOriginZ) / IAIPATHCOLLISION_VOXEL_SIZE);
+		this->mVoxelFirstLayer[cell] = firstLayer;
+		this->mVoxelLayers[cell] = (lastLayer - firstLayer) + 1;
+		wordCount += this->mVoxelLayers[cell] * wordsPerLayer;
+	}
+
+	this->mVoxels.setSize(wordCount);
+	if (wordCount > 0)
+		dMemset(this->mVoxels.address(), 0, sizeof(U32) * wordCount);
+
+	// buckets only write their own bits, so can be rasterised side by side
+	iAIJobQueue::run(cellCount, iAIPathCollision::voxelizeCell, this, threadCount);
+
+	this->mVoxelized = true;
+}
+
+void iAIPathCollision::voxelizeCell(void *context, const U32 cell)
+{
+	iAIPathCollision *collision = static_cast<iAIPathCollision*>(context);
+
+	if (collision->mVoxelLayers[cell] == 0)
+		return;
+
+	S32 firstX = (cell % collision->mCellsX) * IAIPATHCOLLISION_CELL_VOXELS;
+	S32 firstY = (cell / collision->mCellsX) * IAIPATHCOLLISION_CELL_VOXELS;
+	F32 originX = collision->mArea.min.x;
+	F32 originY = collision->mArea.min.y;
+	F32 originZ = collision->mVoxelOriginZ;
+	F32 size = IAIPATHCOLLISION_VOXEL_SIZE;
+
+	for (U32 i = collision->mCellStart[cell]; i < collision->mCellStart[cell + 1]; ++i)
+	{
+		const Entry &entry = collision->mEntries[collision->mCellEntries[i]];
+		if (!entry.mVoxelize)
+			continue;
+
+		// voxels of the object within this bucket
+		const Box3F &box = entry.mWorldBox;
+		S32 fromX = getMax((S32)mFloor((box.min.x - originX) / size), firstX);
+		S32 toX = getMin((S32)mFloor((box.max.x - originX) / size), firstX + IAIPATHCOLLISION_CELL_VOXELS - 1);
+		S32 fromY = getMax((S32)mFloor((box.min.y - originY) / size), firstY);
+		S32 toY = getMin((S32)mFloor((box.max.y - originY) / size), firstY + IAIPATHCOLLISION_CELL_VOXELS - 1);
+		S32 fromZ = (S32)mFloor((box.min.z - originZ) / size);
+		S32 toZ = (S32)mFloor((box.max.z - originZ) / size);
+
+		// rays run through the voxel centres, from just outside the voxels to just past them
+		F32 lowX = originX + (fromX * size) - size;
+		F32 highX = originX + ((toX + 1) * size) + size;
+		F32 lowY = originY + (fromY * size) - size;
+		F32 highY = originY + ((toY + 1) * size) + size;
+		F32 lowZ = originZ + (fromZ * size) - size;
+		F32 highZ = originZ + ((toZ + 1) * size) + size;
+
+		// down, for floors & roofs
+		for (S32 x = fromX; x <= toX; ++x)
+		{
+			for (S32 y = fromY; y <= toY; ++y)
+			{
+				Point3F centre(originX + ((x + 0.5f) * size), originY + ((y + 0.5f) * size), 0);
+				collision->markHits(cell, entry, Point3F(centre.x, centre.y, highZ), Point3F(centre.x, centre.y, lowZ));
+			}
+		}
+
+		// across, for walls
+		for (S32 z = fromZ; z <= toZ; ++z)
+		{
+			F32 centreZ = originZ + ((z + 0.5f) * size);
+
+			for (S32 y = fromY; y <= toY; ++y)
+			{
+				F32 centreY = originY + ((y + 0.5f) * size);
+				collision->markHits(cell, entry, Point3F(lowX, centreY, centreZ), Point3F(highX, centreY, centreZ));
+			}
+
+			for (S32 x = fromX; x <= toX; ++x)
+			{
+				F32 centreX = originX + ((x + 0.5f) * size);
+				collision->markHits(cell, entry, Point3F(centreX, lowY, centreZ), Point3F(centreX, highY, centreZ));
+			}
+		}
+	}
+}
+
+void iAIPathCollision::markHits(const U32 cell, const Entry &entry, const Point3F &start, const Point3F &end)
+{
+	Point3F direction = end - start;
+	if (direction.isZero())
+		return;
+	direction.normalize();
+
+	S32 firstX = (cell % this->mCellsX) * IAIPATHCOLLISION_CELL_VOXELS;
+	S32 firstY = (cell / this->mCellsX) * IAIPATHCOLLISION_CELL_VOXELS;
+	U32 *bits = this->mVoxels.address() + this->mVoxelStart[cell];
+
+	Point3F from = start;
+	for (U32 i = 0; i < IAIPATHCOLLISION_VOXEL_MAX_HITS; ++i)
+	{
+		RayInfo info;
+		if (!this->castEntry(entry, from, end, &info))
+			return;
+
+		// mark the voxel of the surface, if it's in this bucket
+		S32 x = (S32)mFloor((info.point.x - this->mArea.min.x) / IAIPATHCOLLISION_VOXEL_SIZE) - firstX;
+		S32 y = (S32)mFloor((info.point.y - this->mArea.min.y) / IAIPATHCOLLISION_VOXEL_SIZE) - firstY;
+		S32 layer = (S32)mFloor((info.point.z - this->mVoxelOriginZ) / IAIPATHCOLLISION_VOXEL_SIZE) - this->mVoxelFirstLayer[cell];
+
+		if ((x >= 0) && (x < IAIPATHCOLLISION_CELL_VOXELS) && (y >= 0) && (y < IAIPATHCOLLISION_CELL_VOXELS) &&
+			(layer >= 0) && (layer < this->mVoxelLayers[cell]))
+		{
+			U32 bit = (((layer * IAIPATHCOLLISION_CELL_VOXELS) + y) * IAIPATHCOLLISION_CELL_VOXELS) + x;
+			bits[bit >> 5] |= (1 << (bit & 31));
+		}
+
+		// carry on from just past the surface
+		from = info.point + (direction * (IAIPATHCOLLISION_VOXEL_SIZE * 0.05f));
+		if (mDot(end - from, direction) <= 0.0f)
+			return;
+	}
+}
+
+inline bool iAIPathCollision::isVoxelSet(const S32 x, const S32 y, const S32 z) const
+{
+	if ((x < 0) || (y < 0))
+		return false;
+
+	S32 cellX = x / IAIPATHCOLLISION_CELL_VOXELS;
+	S32 cellY = y / IAIPATHCOLLISION_CELL_VOXELS;
+	if ((cellX >= this->mCellsX) || (cellY >= this->mCellsY))
+		return false;
+
+	U32 cell = (cellY * this->mCellsX) + cellX;
+	S32 layer = z - this->mVoxelFirstLayer[cell];
+	if ((layer < 0) || (layer >= this->mVoxelLayers[cell]))
+		return false;
+
+	U32 bit = (((layer * IAIPATHCOLLISION_CELL_VOXELS) + (y - (cellY * IAIPATHCOLLISION_CELL_VOXELS))) * IAIPATHCOLLISION_CELL_VOXELS) +
+			  (x - (cellX * IAIPATHCOLLISION_CELL_VOXELS));
+	return (this->mVoxels[this->mVoxelStart[cell] + (bit >> 5)] & (1 << (bit & 31))) != 0;
+}
+
+bool iAIPathCollision::castVoxels(const Point3F &start, const Point3F &end) const
+{
+	// into voxel coordinates
+	F32 invSize = 1.0f / IAIPATHCOLLISION_VOXEL_SIZE;
+	Point3F from((start.x - this->mArea.min.x) * invSize, (start.y - this->mArea.min.y) * invSize, (start.z - this->mVoxelOriginZ) * invSize);
+	Point3F to((end.x - this->mArea.min.x) * invSize, (end.y - this->mArea.min.y) * invSize, (end.z - this->mVoxelOriginZ) * invSize);
+	Point3F delta = to - from;
+
+	S32 x = (S32)mFloor(from.x);
+	S32 y = (S32)mFloor(from.y);
+	S32 z = (S32)mFloor(from.z);
+
+	S32 stepX = (delta.x > 0) ? 1 : ((delta.x < 0) ? -1 : 0);
+	S32 stepY = (delta.y > 0) ? 1 : ((delta.y < 0) ? -1 : 0);
+	S32 stepZ = (delta.z > 0) ? 1 : ((delta.z < 0) ? -1 : 0);
+
+	// distance along the line, 0 to 1, to the next voxel boundary in each axis & between boundaries
+	F32 nextX = (stepX > 0) ? (((x + 1) - from.x) / delta.x) : ((stepX < 0) ? ((from.x - x) / -delta.x) : F32_MAX);
+	F32 nextY = (stepY > 0) ? (((y + 1) - from.y) / delta.y) : ((stepY < 0) ? ((from.y - y) / -delta.y) : F32_MAX);
+	F32 nextZ = (stepZ > 0) ? (((z + 1) - from.z) / delta.z) : ((stepZ < 0) ? ((from.z - z) / -delta.z) : F32_MAX);
+	F32 acrossX = (stepX != 0) ? mFabs(1.0f / delta.x) : F32_MAX;
+	F32 acrossY = (stepY != 0) ? mFabs(1.0f / delta.y) : F32_MAX;
+	F32 acrossZ = (stepZ != 0) ? mFabs(1.0f / delta.z) : F32_MAX;
+
+	// visit every voxel the line passes through
+	S32 steps = mAbs((S32)mFloor(to.x) - x) + mAbs((S32)mFloor(to.y) - y) + mAbs((S32)mFloor(to.z) - z);
+	for (S32 i = 0; i <= steps; ++i)
+	{
+		if (this->isVoxelSet(x, y, z))
+			return true;
+
+		if ((nextX < nextY) && (nextX < nextZ))
+		{
+			x += stepX;
+			nextX += acrossX;
+		} else if (nextY < nextZ)
+		{
+			y += stepY;
+			nextY += acrossY;
+		} else
+		{
+			z += stepZ;
+			nextZ += acrossZ;
+		}
+	}
+
+	return false;
+}
+
+bool iAIPathCollision::castEntry(const Entry &entry, const Point3F &start, const Point3F &end, RayInfo *info) const
+{
+	F32 t;
+	Point3F normal;
+	if (!entry.mWorldBox.collideLine(start, end, &t, &normal))
+		return false;
+
+	if (!entry.mObject)
+		return this->castPolys(entry, start, end, info);
+
+	// transform the ray into object space, same as the container does
+	Point3F objStart, objEnd;
+	entry.mWorldToObj.mulP(start, &objStart);
+	objStart.convolveInverse(entry.mScale);
+	entry.mWorldToObj.mulP(end, &objEnd);
+	objEnd.convolveInverse(entry.mScale);
+
+	if (!entry.mObject->castRay(objStart, objEnd, info))
+		return false;
+
+	// t is the same in object & world space
+	info->object = entry.mObject;
+	info->point = start + ((end - start) * info->t);
+	return true;
+}
+
+bool iAIPathCollision::castPolys(const Entry &entry, const Point3F &start, const Point3F &end, RayInfo *info) const
+{
+	bool hit = false;
+	info->t = 1.0f;
+
+	for (U32 i = entry.mPolyStart; i < entry.mPolyStart + entry.mPolyCount; ++i)
+	{
+		const ConcretePolyList::Poly &poly = this->mPolys.mPolyList[i];
+
+		// only planes the ray crosses, nearer than the closest so far
+		F32 startDist = poly.plane.distToPlane(start);
+		F32 endDist = poly.plane.distToPlane(end);
+		if ((startDist > 0.0f) == (endDist > 0.0f))
+			continue;
+
+		F32 t = startDist / (startDist - endDist);
+		if (t >= info->t)
+			continue;
+
+		// the crossing point must be inside every edge of the polygon
+		Point3F point = start + ((end - start) * t);
+		const U32 *index = &this->mPolys.mIndexList[poly.vertexStart];
+		bool front = false;
+		bool back = false;
+		for (U32 v = 0; v < poly.vertexCount; ++v)
+		{
+			const Point3F &from = this->mPolys.mVertexList[index[v]];
+			const Point3F &to = this->mPolys.mVertexList[index[(v + 1) % poly.vertexCount]];
+
+			Point3F side;
+			mCross(to - from, point - from, &side);
+			F32 dot = mDot(side, poly.plane);
+			if (dot > 0.0f)
+				front = true;
+			else if (dot < 0.0f)
+				back = true;
+		}
+
+		if (front && back)
+			continue;
+
+		hit = true;
+		info->t = t;
+		info->normal = poly.plane;
+	}
+
+	if (!hit)
+		return false;
+
+	info->object = 0;
+	info->point = start + ((end - start) * info->t);
+	return true;
+}
+
+bool iAIPathCollision::castRay(const Point3F &start, const Point3F &end, RayInfo *info) const
+{
+	if (this->mEntries.size() == 0)
+		return false;
+
+	// box around the ray
+	Box3F rayBox;
+	rayBox.min = start;
+	rayBox.max = start;
+	rayBox.min.setMin(end);
+	rayBox.max.setMax(end);
+
+	// the static objects are checked in the voxels, if the ray is within them & the point isn't needed
+	bool voxels = (!info && this->mVoxelized &&
+				   (rayBox.min.x >= this->mArea.min.x) && (rayBox.max.x < this->mArea.min.x + (this->mCellsX * IAIPATHCOLLISION_CELL_SIZE)) &&
+				   (rayBox.min.y >= this->mArea.min.y) && (rayBox.max.y < this->mArea.min.y + (this->mCellsY * IAIPATHCOLLISION_CELL_SIZE)));
+
+	if (voxels && this->castVoxels(start, end))
+		return true;
+
+	S32 startX = this->getCellX(rayBox.min.x);
+	S32 endX = this->getCellX(rayBox.max.x);
+	S32 startY = this->getCellY(rayBox.min.y);
+	S32 endY = this->getCellY(rayBox.max.y);
+
+	bool hit = false;
+	if (info)
+		info->t = 1.0f;
+
+	for (S32 y = startY; y <= endY; ++y)
+	{
+		for (S32 x = startX; x <= endX; ++x)
+		{
+			U32 cell = (y * this->mCellsX) + x;
+			for (U32 i = this->mCellStart[cell]; i < this->mCellStart[cell + 1]; ++i)
+			{
+				const Entry &entry = this->mEntries[this->mCellEntries[i]];
+
+				if (voxels && entry.mVoxelize)
+					continue;
+
+				if (!entry.mWorldBox.isOverlapped(rayBox))
+					continue;
+
+				// an entry spanning several buckets is only tested in the first one the ray shares with it
+				if ((this->getCellX(getMax(rayBox.min.x, entry.mWorldBox.min.x)) != x) ||
+					(this->getCellY(getMax(rayBox.min.y, entry.mWorldBox.min.y)) != y))
+					continue;
+
+				RayInfo objInfo;
+				if (!this->castEntry(entry, start, end, &objInfo))
+					continue;
+
+				if (!info)
+					return true;
+
+				// keep the closest
+				hit = true;
+				if (objInfo.t < info->t)
+				{
+					info->t = objInfo.t;
+					info->object = objInfo.object;
+					info->point = objInfo.point;
+				}
+			}
+		}
+	}
+
+	return hit;
+}
@@ -0,0 +1,348 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathCollision
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+//-------------------------------------------------------------------
+/// @file iAIPathCollision.h
+//-------------------------------------------------------------------
+/// @class iAIPathCollision
+/// @author Gavin Bunney
+/// @version 1.0
+/// @brief Snapshot of the static collision objects for grid building.
+///
+/// The server container is not safe to cast rays against from more
+/// than one thread. The snapshot copies the transform and bounds of
+/// every collision object in an area once, on the main thread.
+/// Interiors are read only when cast against, so rays are cast
+/// directly against them. All other objects keep scratch data while
+/// casting and may be deleted while a build runs, so their collision
+/// polygons are copied into the snapshot and rays are cast against
+/// the copy instead.
+///
+/// Once voxelize() has been called, the static objects are also held
+/// as a bitmap of occupied voxels, one block of it per bucket. Rays
+/// which don't need the collision point walk the bitmap instead of
+/// casting against the static objects. The voxels are conservative;
+/// a ray passing within a voxel of a surface counts as blocked.
+//-------------------------------------------------------------------
+#ifndef _IAIPATHCOLLISION_H_
+#define _IAIPATHCOLLISION_H_
+
+#include "sim/sceneObject.h"
+#include "collision/concretePolyList.h"
+
+//-------------------------------------------------------------------
+/// @def IAIPATHCOLLISION_CELL_SIZE
+/// @brief Size, in world units, of the buckets objects are sorted
+///        into for ray casting.
+//-------------------------------------------------------------------
+#define IAIPATHCOLLISION_CELL_SIZE		32.0f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHCOLLISION_VOXEL_SIZE
+/// @brief Size, in world units, of each occupancy voxel. Must divide
+///        IAIPATHCOLLISION_CELL_SIZE.
+//-------------------------------------------------------------------
+#define IAIPATHCOLLISION_VOXEL_SIZE		0.5f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHCOLLISION_CELL_VOXELS
+/// @brief Number of voxels across a bucket in X & Y.
+//-------------------------------------------------------------------
+#define IAIPATHCOLLISION_CELL_VOXELS	((S32)(IAIPATHCOLLISION_CELL_SIZE / IAIPATHCOLLISION_VOXEL_SIZE))
+
+//-------------------------------------------------------------------
+/// @def IAIPATHCOLLISION_VOXEL_MASK
+/// @brief Object types which don't move, so are rasterised into the
+///        voxels. Anything else is always cast against directly.
+//-------------------------------------------------------------------
+#define IAIPATHCOLLISION_VOXEL_MASK		(InteriorObjectType | StaticShapeObjectType | StaticTSObjectType)
+
+//-------------------------------------------------------------------
+/// @def IAIPATHCOLLISION_VOXEL_MAX_HITS
+/// @brief Most surfaces found along a single rasterising ray.
+//-------------------------------------------------------------------
+#define IAIPATHCOLLISION_VOXEL_MAX_HITS	32
+
+class iAIPathCollision {
+
+public:
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathCollision()
+	/// @brief Default constructor.
+	//-------------------------------------------------------------------
+	iAIPathCollision();
+
+	//-------------------------------------------------------------------
+	/// @fn ~iAIPathCollision()
+	/// @brief Deconstructor which clears the snapshot.
+	//-------------------------------------------------------------------
+	~iAIPathCollision();
+
+	//-------------------------------------------------------------------
+	/// @fn void build(const Box3F &area, const U32 typeMask)
+	/// @brief Takes the snapshot of all objects matching the type mask
+	///        within the area. Must be called from the main thread.
+	///
+	/// @param area World box to snapshot.
+	/// @param typeMask Object types to include.
+	//-------------------------------------------------------------------
+	void build(const Box3F &area, const U32 typeMask);
+
+	//-------------------------------------------------------------------
+	/// @fn void voxelize(const U32 threadCount)
+	/// @brief Rasterises the static objects of the snapshot into the
+	///        occupancy voxels, a bucket per job. May be called from any
+	///        thread, once, after build().
+	///
+	/// @param threadCount Number of threads to rasterise with.
+	//-------------------------------------------------------------------
+	void voxelize(const U32 threadCount);
+
+	//-------------------------------------------------------------------
+	/// @fn bool isVoxelized() const
+	/// @brief Checks if the occupancy voxels have been built.
+	///
+	/// @return True if voxelize() has been called.
+	//-------------------------------------------------------------------
+	bool isVoxelized() const { return this->mVoxelized; }
+
+	//-------------------------------------------------------------------
+	/// @fn void clear()
+	/// @brief Empties the snapshot.
+	//-------------------------------------------------------------------
+	void clear();
+
+	//-------------------------------------------------------------------
+	/// @fn bool castRay(const Point3F &start, const Point3F &end,
+	///                  RayInfo *info = 0) const
+	/// @brief Checks if the line between the two points collides with
+	///        any object in the snapshot. Safe to call from any thread.
+	///
+	/// @param start World point to start the ray.
+	/// @param end World point to end the ray.
+	/// @param info If parsed, set to the closest collision, with t, the
+	///        world point and, for interiors, the object. Slower, as every object along
+	///        the ray must be cast against and the voxels can't be used.
+	/// @return True if the ray collided with an object.
+	//-------------------------------------------------------------------
+	bool castRay(const Point3F &start, const Point3F &end, RayInfo *info = 0) const;
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getObjectCount() const
+	/// @brief Retrieves the number of objects in the snapshot.
+	///
+	/// @return U32 Number of objects.
+	//-------------------------------------------------------------------
+	U32 getObjectCount() const { return this->mEntries.size(); }
+
+private:
+
+	//-------------------------------------------------------------------
+	/// @struct Entry
+	/// @brief A single object in the snapshot.
+	//-------------------------------------------------------------------
+	struct Entry
+	{
+		//-------------------------------------------------------------------
+		/// @var SceneObject* mObject
+		/// @brief The collision object, if it is an interior. Other
+		///        objects are held as polygons only.
+		//-------------------------------------------------------------------
+		SceneObject *mObject;
+
+		//-------------------------------------------------------------------
+		/// @var Box3F mWorldBox
+		/// @brief World box of the object when the snapshot was taken.
+		//-------------------------------------------------------------------
+		Box3F mWorldBox;
+
+		//-------------------------------------------------------------------
+		/// @var MatrixF mWorldToObj
+		/// @brief World to object transform of the object.
+		//-------------------------------------------------------------------
+		MatrixF mWorldToObj;
+
+		//-------------------------------------------------------------------
+		/// @var Point3F mScale
+		/// @brief Scale of the object.
+		//-------------------------------------------------------------------
+		Point3F mScale;
+
+		//-------------------------------------------------------------------
+		/// @var U32 mPolyStart
+		/// @brief Index of the object's first polygon in mPolys.
+		//-------------------------------------------------------------------
+		U32 mPolyStart;
+
+		//-------------------------------------------------------------------
+		/// @var U32 mPolyCount
+		/// @brief Number of polygons copied from the object.
+		//-------------------------------------------------------------------
+		U32 mPolyCount;
+
+		//-------------------------------------------------------------------
+		/// @var bool mVoxelize
+		/// @brief Object is static, so is held in the voxels.
+		//-------------------------------------------------------------------
+		bool mVoxelize;
+	};
+
+	//-------------------------------------------------------------------
+	/// @fn static void findCallback(SceneObject *object, void *key)
+	/// @brief Container callback which adds found objects to the
+	///        snapshot.
+	//-------------------------------------------------------------------
+	static void findCallback(SceneObject *object, void *key);
+
+	//-------------------------------------------------------------------
+	/// @fn inline S32 getCellX(const F32 x) const
+	/// @brief Converts a world X coordinate into a bucket column.
+	//-------------------------------------------------------------------
+	inline S32 getCellX(const F32 x) const;
+
+	//-------------------------------------------------------------------
+	/// @fn inline S32 getCellY(const F32 y) const
+	/// @brief Converts a world Y coordinate into a bucket row.
+	//-------------------------------------------------------------------
+	inline S32 getCellY(const F32 y) const;
+
+	//-------------------------------------------------------------------
+	/// @fn bool castEntry(const Entry &entry, const Point3F &start,
+	///                    const Point3F &end, RayInfo *info) const
+	/// @brief Casts a ray against a single object of the snapshot.
+	///
+	/// @return True if the ray collided with the object; info holds t,
+	///         the world point and, for interiors, the object.
+	//-------------------------------------------------------------------
+	bool castEntry(const Entry &entry, const Point3F &start, const Point3F &end, RayInfo *info) const;
+
+	//-------------------------------------------------------------------
+	/// @fn bool castPolys(const Entry &entry, const Point3F &start,
+	///                    const Point3F &end, RayInfo *info) const
+	/// @brief Casts a ray against the copied polygons of an object.
+	///
+	/// @return True if the ray crossed a polygon; info holds the closest
+	///         t, world point & normal.
+	//-------------------------------------------------------------------
+	bool castPolys(const Entry &entry, const Point3F &start, const Point3F &end, RayInfo *info) const;
+
+	//-------------------------------------------------------------------
+	/// @fn static void voxelizeCell(void *context, const U32 cell)
+	/// @brief Voxelize job; rasterises the static objects within a
+	///        bucket by casting rays through them along X, Y & Z, and
+	///        marking the voxel of every surface hit.
+	///
+	/// @param context Pointer to the iAIPathCollision.
+	/// @param cell Index of the bucket.
+	//-------------------------------------------------------------------
+	static void voxelizeCell(void *context, const U32 cell);
+
+	//-------------------------------------------------------------------
+	/// @fn void markHits(const U32 cell, const Entry &entry,
+	///                   const Point3F &start, const Point3F &end)
+	/// @brief Marks the voxel of every surface of the object along the
+	///        ray, which lie within the bucket.
+	//-------------------------------------------------------------------
+	void markHits(const U32 cell, const Entry &entry, const Point3F &start, const Point3F &end);
+
+	//-------------------------------------------------------------------
+	/// @fn inline bool isVoxelSet(const S32 x, const S32 y,
+	///                            const S32 z) const
+	/// @brief Checks if a voxel, in voxel coordinates, is occupied.
+	//-------------------------------------------------------------------
+	inline bool isVoxelSet(const S32 x, const S32 y, const S32 z) const;
+
+	//-------------------------------------------------------------------
+	/// @fn bool castVoxels(const Point3F &start, const Point3F &end) const
+	/// @brief Walks the voxels along the line between the two points.
+	///
+	/// @return True if the line passes through an occupied voxel.
+	//-------------------------------------------------------------------
+	bool castVoxels(const Point3F &start, const Point3F &end) const;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<Entry> mEntries
+	/// @brief All the objects in the snapshot.
+	//-------------------------------------------------------------------
+	Vector<Entry> mEntries;
+
+	//-------------------------------------------------------------------
+	/// @var ConcretePolyList mPolys
+	/// @brief World space polygons of every non-interior object.
+	//-------------------------------------------------------------------
+	ConcretePolyList mPolys;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<U32> mCellStart
+	/// @brief Offset into mCellEntries of the first entry of each
+	///        bucket, plus one extra entry for the end.
+	//-------------------------------------------------------------------
+	Vector<U32> mCellStart;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<U32> mCellEntries
+	/// @brief Entry indexes sorted by bucket. An entry is held in
+	///        every bucket its world box overlaps.
+	//-------------------------------------------------------------------
+	Vector<U32> mCellEntries;
+
+	//-------------------------------------------------------------------
+	/// @var Box3F mArea
+	/// @brief Area covered by the snapshot.
+	//-------------------------------------------------------------------
+	Box3F mArea;
+
+	//-------------------------------------------------------------------
+	/// @var S32 mCellsX
+	/// @brief Number of buckets in X.
+	//-------------------------------------------------------------------
+	S32 mCellsX;
+
+	//-------------------------------------------------------------------
+	/// @var S32 mCellsY
+	/// @brief Number of buckets in Y.
+	//-------------------------------------------------------------------
+	S32 mCellsY;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<U32> mVoxels
+	/// @brief Occupancy bits of every bucket holding static objects.
+	///        A bucket's bits are laid out by layer, then Y, then X.
+	//-------------------------------------------------------------------
+	Vector<U32> mVoxels;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<U32> mVoxelStart
+	/// @brief Per bucket; offset into mVoxels of the bucket's bits.
+	//-------------------------------------------------------------------
+	Vector<U32> mVoxelStart;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<S32> mVoxelFirstLayer
+	/// @brief Per bucket; lowest voxel layer held.
+	//-------------------------------------------------------------------
+	Vector<S32> mVoxelFirstLayer;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<S32> mVoxelLayers
+	/// @brief Per bucket; number of voxel layers held, 0 if none.
+	//-------------------------------------------------------------------
+	Vector<S32> mVoxelLayers;
+
+	//-------------------------------------------------------------------
+	/// @var F32 mVoxelOriginZ
+	/// @brief World height of the bottom of voxel layer 0.
+	//-------------------------------------------------------------------
+	F32 mVoxelOriginZ;
+
+	//-------------------------------------------------------------------
+	/// @var bool mVoxelized
+	/// @brief The voxels have been built.
+	//-------------------------------------------------------------------
+	bool mVoxelized;
+};
+
+#endif
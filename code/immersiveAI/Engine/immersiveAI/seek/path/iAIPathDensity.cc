@@ -0,0 +1,116 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathDensity
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+#include "platform/profiler.h"
+
+#include "iAIPathDensity.h"
+#include "iAIPathMap.h"
+
+iAIPathDensity* iAIPathDensity::mInstance = 0;
+
+iAIPathDensity* iAIPathDensity::getInstance()
+{
+	// if an instance doesn't exist yet, create one!
+	if (!mInstance)
+	{
+		mInstance = new iAIPathDensity();
+	}
+	return mInstance;
+}
+
+iAIPathDensity::iAIPathDensity()
+{
+	this->mPathMap = 0;
+	this->mGeneration = 0;
+}
+
+F32 iAIPathDensity::getWeight()
+{
+	return getMax(Con::getFloatVariable("$iAIPathMap::crowdWeight", IAIPATHDENSITY_WEIGHT), 0.0f);
+}
+
+void iAIPathDensity::renumber(iAIPathMap *pathMap)
+{
+	PROFILE_SCOPE(iAIPathDensity_renumber);
+
+	this->mPathMap = pathMap;
+
+	Vector<F32> counts;
+	Vector<U32> nodeIds;
+	counts.setSize(iAIPathMap::smNodeCount);
+	nodeIds.setSize(iAIPathMap::smNodeCount);
+	for (U32 i = 0; i < counts.size(); ++i)
+	{
+		counts[i] = 0.0f;
+		nodeIds[i] = IAIPATHDENSITY_NO_NODE;
+	}
+
+	// carry each count over to where its node is now; nodes paged out lose theirs
+	for (U32 i = 0; i < this->mCounts.size(); ++i)
+	{
+		if (this->mCounts[i] <= 0.0f)
+			continue;
+
+		iAIPathNode *node = this->findNode(this->mNodeIds[i]);
+		if (!node || (node->mMapIndex >= counts.size()))
+			continue;
+
+		counts[node->mMapIndex] += this->mCounts[i];
+		nodeIds[node->mMapIndex] = this->mNodeIds[i];
+	}
+
+	this->mCounts = counts;
+	this->mNodeIds = nodeIds;
+}
+
+void iAIPathDensity::clear()
+{
+	this->mPathMap = 0;
+	this->mCounts.clear();
+	this->mNodeIds.clear();
+
+	// anything added until now has gone with the counts
+	++this->mGeneration;
+}
+
+iAIPathNode* iAIPathDensity::findNode(const U32 nodeId)
+{
+	if (!this->mPathMap || (nodeId == IAIPATHDENSITY_NO_NODE))
+		return 0;
+
+	return this->mPathMap->getNode(nodeId);
+}
+
+U32 iAIPathDensity::findNodeId(const Point3F &position)
+{
+	if (!this->mPathMap)
+		return IAIPATHDENSITY_NO_NODE;
+
+	iAIPathNode *node = this->mPathMap->getClosestNode(position);
+	return node ? node->getId() : IAIPATHDENSITY_NO_NODE;
+}
+
+void iAIPathDensity::add(const U32 nodeId, const F32 amount)
+{
+	iAIPathNode *node = this->findNode(nodeId);
+	if (!node || (node->mMapIndex >= this->mCounts.size()))
+		return;
+
+	this->mCounts[node->mMapIndex] += amount;
+	this->mNodeIds[node->mMapIndex] = nodeId;
+}
+
+void iAIPathDensity::remove(const U32 nodeId, const F32 amount, const U32 generation)
+{
+	if (generation != this->mGeneration)
+		return;
+
+	iAIPathNode *node = this->findNode(nodeId);
+	if (!node || (node->mMapIndex >= this->mCounts.size()))
+		return;
+
+	// a node paged out & back in lost its count; never go below nothing
+	this->mCounts[node->mMapIndex] = getMax(this->mCounts[node->mMapIndex] - amount, 0.0f);
+}
@@ -0,0 +1,204 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathDensity
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+//-------------------------------------------------------------------
+/// @file iAIPathDensity.h
+//-------------------------------------------------------------------
+/// @class iAIPathDensity
+/// @author Gavin Bunney
+/// @version 1.0
+/// @brief How crowded each node of the pathmap is.
+///
+/// A Singleton class holding a crowd count per node, which A* adds
+/// to each node's move modifier, scaled by $iAIPathMap::crowdWeight,
+/// so agents heading the same way spread over the routes around.
+/// <br><br>
+/// The count is kept up to date as things change rather than
+/// rebuilt; each agent adds itself to the node it stands on, and
+/// each path handle adds the nodes of its route still ahead, letting
+/// them go as they're passed. Contributions are made by node id, so
+/// they outlive the pathmap re-numbering its nodes; they are dropped
+/// when the pathmap is cleared.
+/// <br><br>
+/// Only used from the main thread.
+//-------------------------------------------------------------------
+#ifndef _IAIPATHDENSITY_H_
+#define _IAIPATHDENSITY_H_
+
+#include "iAIPathNode.h"
+
+class iAIPathMap;
+
+//-------------------------------------------------------------------
+/// @def IAIPATHDENSITY_WEIGHT
+/// @brief Default cost of each agent counted on a node. Can be
+///        changed via $iAIPathMap::crowdWeight; 0 turns it off.
+//-------------------------------------------------------------------
+#define IAIPATHDENSITY_WEIGHT			0.0f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHDENSITY_AGENT_AMOUNT
+/// @brief Count added to the node an agent is standing on.
+//-------------------------------------------------------------------
+#define IAIPATHDENSITY_AGENT_AMOUNT		1.0f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHDENSITY_ROUTE_AMOUNT
+/// @brief Count added to each node of a route still ahead; less than
+///        an agent, as it's only passing through.
+//-------------------------------------------------------------------
+#define IAIPATHDENSITY_ROUTE_AMOUNT		0.5f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHDENSITY_NO_NODE
+/// @brief Node id given when there is no node.
+//-------------------------------------------------------------------
+#define IAIPATHDENSITY_NO_NODE			U32_MAX
+
+class iAIPathDensity {
+
+public:
+
+	//-------------------------------------------------------------------
+	/// @fn ~iAIPathDensity()
+	/// @brief Default deconstructor.
+	//-------------------------------------------------------------------
+	~iAIPathDensity() { };
+
+	//-------------------------------------------------------------------
+	/// @fn static iAIPathDensity* getInstance()
+	/// @brief Retrieves the instance of the singleton. Creates a new
+	///        instance if one doesn't exist.
+	///
+	/// @return Singleton instance pointer.
+	//-------------------------------------------------------------------
+	static iAIPathDensity* getInstance();
+
+	//-------------------------------------------------------------------
+	/// @fn static F32 getWeight()
+	/// @brief Retrieves $iAIPathMap::crowdWeight.
+	///
+	/// @return F32 cost of each agent counted on a node.
+	//-------------------------------------------------------------------
+	static F32 getWeight();
+
+	//-------------------------------------------------------------------
+	/// @fn void renumber(iAIPathMap *pathMap)
+	/// @brief Moves the counts to the pathmap's new node numbering.
+	///        Called by the pathmap after re-indexing its nodes.
+	///
+	/// @param pathMap pathmap the counts are over.
+	//-------------------------------------------------------------------
+	void renumber(iAIPathMap *pathMap);
+
+	//-------------------------------------------------------------------
+	/// @fn void clear()
+	/// @brief Drops every count and contribution. Called by the pathmap
+	///        when its nodes are deleted.
+	//-------------------------------------------------------------------
+	void clear();
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getGeneration()
+	/// @brief Retrieves the number of times the counts were cleared;
+	///        contributions made before then are already gone.
+	///
+	/// @return U32 generation.
+	//-------------------------------------------------------------------
+	U32 getGeneration() { return this->mGeneration; }
+
+	//-------------------------------------------------------------------
+	/// @fn U32 findNodeId(const Point3F &position)
+	/// @brief Finds the id of the node closest to a position.
+	///
+	/// @param position Point3F to find the node of.
+	/// @return U32 node id, IAIPATHDENSITY_NO_NODE if there's no pathmap.
+	//-------------------------------------------------------------------
+	U32 findNodeId(const Point3F &position);
+
+	//-------------------------------------------------------------------
+	/// @fn void add(const U32 nodeId, const F32 amount)
+	/// @brief Adds to the count of a node.
+	///
+	/// @param nodeId id of the node; IAIPATHDENSITY_NO_NODE is ignored.
+	/// @param amount amount to add.
+	//-------------------------------------------------------------------
+	void add(const U32 nodeId, const F32 amount);
+
+	//-------------------------------------------------------------------
+	/// @fn void remove(const U32 nodeId, const F32 amount,
+	///                 const U32 generation)
+	/// @brief Takes back an amount added. Ignored if the counts have been
+	///        cleared since.
+	///
+	/// @param nodeId id of the node added to.
+	/// @param amount amount added.
+	/// @param generation getGeneration() when it was added.
+	//-------------------------------------------------------------------
+	void remove(const U32 nodeId, const F32 amount, const U32 generation);
+
+	//-------------------------------------------------------------------
+	/// @fn static F32 getDensity(const iAIPathDensity *density,
+	///                           const iAIPathNode *node)
+	/// @brief Retrieves the count of a node.
+	///
+	/// @param density density to look in, may be 0.
+	/// @param node node to look up.
+	/// @return F32 count of the node.
+	//-------------------------------------------------------------------
+	static inline F32 getDensity(const iAIPathDensity *density, const iAIPathNode *node)
+	{
+		if (!density || (node->mMapIndex >= density->mCounts.size()))
+			return 0.0f;
+		return density->mCounts[node->mMapIndex];
+	}
+
+private:
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathDensity::iAIPathDensity()
+	/// @brief Default constructor.
+	//-------------------------------------------------------------------
+	iAIPathDensity();
+
+	//-------------------------------------------------------------------
+	/// @var static iAIPathDensity* mInstance
+	/// @brief Instance of the singleton.
+	//-------------------------------------------------------------------
+	static iAIPathDensity* mInstance;
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathNode* findNode(const U32 nodeId)
+	/// @brief Finds a node by its id, if numbered.
+	//-------------------------------------------------------------------
+	iAIPathNode* findNode(const U32 nodeId);
+
+	//-------------------------------------------------------------------
+	/// @var iAIPathMap* mPathMap
+	/// @brief Pathmap the counts are over; 0 until it's first indexed.
+	//-------------------------------------------------------------------
+	iAIPathMap *mPathMap;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<F32> mCounts
+	/// @brief Count of every node, indexed by the node's mMapIndex.
+	//-------------------------------------------------------------------
+	Vector<F32> mCounts;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<U32> mNodeIds
+	/// @brief Id of the node at each counted index, to find it again
+	///        once re-numbered.
+	//-------------------------------------------------------------------
+	Vector<U32> mNodeIds;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mGeneration
+	/// @brief Number of times the counts were cleared.
+	//-------------------------------------------------------------------
+	U32 mGeneration;
+};
+
+#endif
@@ -1,116 +1,220 @@
-//-------------------------------------------------------------------
-// Immersive AI :: Seek :: iAIPathFind
-// Copyright (c) 2006 Gavin Bunney & Tom Romano
-//-------------------------------------------------------------------
-
-//-------------------------------------------------------------------
-/// @file iAIPathFind.h
-//-------------------------------------------------------------------
-/// @class iAIPathFind
-/// @author Gavin Bunney
-/// @version 1.0
-/// @brief Finds a path from one node to another.
-/// 
-/// A Singleton class which implements an A* pathfinding algorithm
-/// to find the easiest and shortest path from one node to another.
-//-------------------------------------------------------------------
-#ifndef _IAIPATHFIND_H_
-#define _IAIPATHFIND_H_
-
-#include "iAIPathNode.h"
-#include "iAIPathGlobal.h"
-
-class iAIPathFind {
-
-public:
-
-	//-------------------------------------------------------------------
-	/// @fn ~iAIPathFind() 
-	/// @brief Default deconstructor.
-	//-------------------------------------------------------------------
-	~iAIPathFind() { };
-
-	//-------------------------------------------------------------------
-	/// @fn static iAIPathFind* getInstance()
-	/// @brief Retrieves the instance of the singleton. Creates a new
-	///        instance if one doesn't exist.
-	///
-	/// @return Singleton instance pointer.
-	//-------------------------------------------------------------------
-	static iAIPathFind* getInstance();
-
-	//-------------------------------------------------------------------
-	/// @fn bool generatePath(iAIPathNode* startNode,
-	///                       iAIPathNode* goalNode,
-	///                       Vector<iAIPathNode*> &replyList,
-	///                       const bool smoothPath = true)
-	/// @brief Performs an A* path finding algorithm to find a path from 
-	///        the parsed startNode to the goalNode. Path is returned in
-	///        the replyList.
-	///
-	/// @param startNode Pointer to the start node.
-	/// @param goalNode Pointer to the goal node.
-	/// @param replyList Vector to place the returned path in.
-	/// @param smoothPath Flag to smooth the path. Default true.
-	/// @return Path creation success.
-	//-------------------------------------------------------------------
-	bool generatePath(iAIPathNode* startNode, iAIPathNode* goalNode, Vector<iAIPathNode*> &replyList, const bool smoothPath = true);
-
-private:
-
-	//-------------------------------------------------------------------
-	/// @fn iAIPathFind::iAIPathFind() 
-	/// @brief Default constructor.
-	//-------------------------------------------------------------------
-	iAIPathFind() { };
-
-	//-------------------------------------------------------------------
-	/// @var static iAIPathFind* mInstance
-	/// @brief Instance of the singleton.
-	//-------------------------------------------------------------------
-	static iAIPathFind* mInstance;
-
-	//-------------------------------------------------------------------
-	/// @fn inline F32 estimateCostToGoal(iAIPathNode* node,
-	///                                   iAIPathNode* goal)
-	/// @brief Performs a vector length from node to goal, to determine
-	///        the cost from the node to the goal.
-	///
-	/// @param node Pointer to the start node.
-	/// @param goal Pointer to the goal node.
-	/// @return Cost to goal.
-	//-------------------------------------------------------------------
-	inline F32 estimateCostToGoal(iAIPathNode* node, iAIPathNode* goal);
-
-	//-------------------------------------------------------------------
-	/// @fn void smoothPath(Vector<iAIPathNode*> &replyList)
-	/// @brief Smooths the path to further optimise the A* algorithm and
-	///        make AI agents traverse a path more naturally.
-	///
-	/// @param replyList Vector of iAIPathNode's to smooth.
-	//-------------------------------------------------------------------
-	void smoothPath(Vector<iAIPathNode*> &replyList);
-
-	//-------------------------------------------------------------------
-	/// @fn bool smoothPathConnectionValid(const Point3F from,
-	///          const Point3F to)
-	/// @brief Checks that a connection from one point to another is
-	///        valid.
-	///
-	/// @param from Point to start from.
-	/// @param from Point to go to.
-	/// @return True if connection is valid.
-	//-------------------------------------------------------------------
-	bool smoothPathConnectionValid(Point3F from, Point3F to);
-
-	//-------------------------------------------------------------------
-	/// @fn void resetNodeVariables(Vector<iAIPathNode*> &affectedList)
-	/// @brief Resets the path finding variables of the nodes.
-	///
-	/// @param affectedList Vector of nodes which were changed during
-	///        the pathfinding algorithm.
-	//-------------------------------------------------------------------
-	void resetNodeVariables(Vector<iAIPathNode*> &affectedList);
-};
-
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathFind
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+//-------------------------------------------------------------------
+/// @file iAIPathFind.h
+//-------------------------------------------------------------------
+/// @class iAIPathFind
+/// @author Gavin Bunney
+/// @version 1.0
+/// @brief Finds a path from one node to another.
+/// 
+/// A Singleton class which implements an A* pathfinding algorithm
+/// to find the easiest and shortest path from one node to another,
+/// over the merged regions of the pathmap, then pulls the path
+/// tight through the openings between the regions.
+/// <br><br>
+/// Cooperative paths are searched over nodes and steps of time
+/// together, for a window of steps, around the nodes other agents
+/// have reserved in iAIPathReservation.
+//-------------------------------------------------------------------
+#ifndef _IAIPATHFIND_H_
+#define _IAIPATHFIND_H_
+
+#include "iAIPathNode.h"
+#include "iAIPathGlobal.h"
+#include "iAIPathOverlay.h"
+#include "iAIPathProfile.h"
+#include "iAIPathDensity.h"
+#include "iAIPathReservation.h"
+
+class iAIPathFind {
+
+public:
+
+	//-------------------------------------------------------------------
+	/// @fn ~iAIPathFind() 
+	/// @brief Default deconstructor.
+	//-------------------------------------------------------------------
+	~iAIPathFind() { };
+
+	//-------------------------------------------------------------------
+	/// @fn static iAIPathFind* getInstance()
+	/// @brief Retrieves the instance of the singleton. Creates a new
+	///        instance if one doesn't exist.
+	///
+	/// @return Singleton instance pointer.
+	//-------------------------------------------------------------------
+	static iAIPathFind* getInstance();
+
+	//-------------------------------------------------------------------
+	/// @fn bool generatePath(iAIPathNode* startNode,
+	///                       iAIPathNode* goalNode,
+	///                       Vector<iAIPathNode*> &replyList,
+	///                       const iAIPathOverlay::Buffer *overlay = 0,
+	///                       const F32 radius = 0.0f,
+	///                       const iAIPathProfile *profile = 0,
+	///                       Vector<iAIPathNode*> *pagedList = 0,
+	///                       const iAIPathDensity *density = 0)
+	/// @brief Performs an A* path finding algorithm to find a path from 
+	///        the parsed startNode to the goalNode. Path is returned in
+	///        the replyList. Links of lazy grids are validated as the
+	///        search first crosses them.
+	///
+	/// @param startNode Pointer to the start node.
+	/// @param goalNode Pointer to the goal node.
+	/// @param replyList Vector to place the returned path in.
+	/// @param overlay Obstacle costs added to each node's move modifier,
+	///        acquired from the pathmap's overlay. Default none.
+	/// @param radius Radius of the agent; nodes with less clearance are
+	///        not passed through. Default 0.
+	/// @param profile Weighting of the node cost channels. Default none,
+	///        using each node's baked move modifier.
+	/// @param pagedList If set, given the nodes searched which have
+	///        links into terrain tiles that are paged out. Default none.
+	/// @param density Crowd counts added to each node's move modifier,
+	///        scaled by $iAIPathMap::crowdWeight. Default none.
+	/// @return Path creation success.
+	//-------------------------------------------------------------------
+	bool generatePath(iAIPathNode* startNode, iAIPathNode* goalNode, Vector<iAIPathNode*> &replyList, const iAIPathOverlay::Buffer *overlay = 0, const F32 radius = 0.0f, const iAIPathProfile *profile = 0, Vector<iAIPathNode*> *pagedList = 0, const iAIPathDensity *density = 0);
+
+	//-------------------------------------------------------------------
+	/// @fn void funnelPath(const Vector<iAIPathNode*> &nodeList,
+	///                     const F32 radius, Vector<Point3F> &pointList)
+	/// @brief Pulls a path found by generatePath tight; the shortest
+	///        line through the openings between each node's region and
+	///        the next, keeping only the corners. Links between grids
+	///        are crossed half way along.
+	///
+	/// @param nodeList Nodes of the path, start first.
+	/// @param radius Radius of the agent, kept clear of the opening ends.
+	/// @param pointList Vector to place the corners of the path in.
+	//-------------------------------------------------------------------
+	void funnelPath(const Vector<iAIPathNode*> &nodeList, const F32 radius, Vector<Point3F> &pointList);
+
+	//-------------------------------------------------------------------
+	/// @fn bool generateCooperativePath(iAIPathNode* startNode,
+	///          iAIPathNode* goalNode, const U32 ownerId,
+	///          const U32 startStep, const U32 window,
+	///          Vector<iAIPathNode*> &replyList, Vector<U32> &stepList,
+	///          const iAIPathOverlay::Buffer *overlay = 0,
+	///          const F32 radius = 0.0f,
+	///          const iAIPathProfile *profile = 0,
+	///          const iAIPathDensity *density = 0)
+	/// @brief Performs a space-time A* from the startNode towards the
+	///        goalNode; each step moves along a link or waits, never
+	///        onto a node another agent has reserved for that step, nor
+	///        swapping nodes with one. Stops at the goal or once the
+	///        window of steps is planned, whichever comes first; if
+	///        neither can be reached, stops at the state closest to the
+	///        goal. Nothing is reserved.
+	///
+	/// @param startNode Pointer to the start node.
+	/// @param goalNode Pointer to the goal node.
+	/// @param ownerId Sim id of the agent; its own reservations are
+	///        ignored.
+	/// @param startStep step of time the agent is at the start node.
+	/// @param window number of steps to plan.
+	/// @param replyList Vector to place the node of each step in, a
+	///        node repeating while waiting.
+	/// @param stepList Vector to place the steps from startStep of each
+	///        node in replyList in.
+	/// @param overlay Obstacle costs, as for generatePath.
+	/// @param radius Radius of the agent, as for generatePath.
+	/// @param profile Weighting of the node cost channels, as for
+	///        generatePath.
+	/// @param density Crowd counts, as for generatePath.
+	//-------------------------------------------------------------------
+	void generateCooperativePath(iAIPathNode* startNode, iAIPathNode* goalNode, const U32 ownerId, const U32 startStep, const U32 window, Vector<iAIPathNode*> &replyList, Vector<U32> &stepList, const iAIPathOverlay::Buffer *overlay = 0, const F32 radius = 0.0f, const iAIPathProfile *profile = 0, const iAIPathDensity *density = 0);
+
+private:
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathFind::iAIPathFind() 
+	/// @brief Default constructor.
+	//-------------------------------------------------------------------
+	iAIPathFind() { };
+
+	//-------------------------------------------------------------------
+	/// @var static iAIPathFind* mInstance
+	/// @brief Instance of the singleton.
+	//-------------------------------------------------------------------
+	static iAIPathFind* mInstance;
+
+	//-------------------------------------------------------------------
+	/// @struct TimeState
+	/// @brief A node at a step of time, in a cooperative search.
+	//-------------------------------------------------------------------
+	struct TimeState
+	{
+		iAIPathNode *mNode;		///< the node
+		U32 mStep;				///< steps from the start
+		F32 mCost;				///< lowest cost from the start
+		F32 mFitness;			///< cost plus the heuristic to the goal
+		S32 mParent;			///< state stepped from, or -1
+		S32 mNext;				///< next state in the same bucket, or -1
+		bool mClosed;			///< expanded already
+	};
+
+	//-------------------------------------------------------------------
+	/// @struct OpenEntry
+	/// @brief A state on the open list of a cooperative search, with its
+	///        fitness when entered; never changed once on the list, the
+	///        entry is left behind if a cheaper way to the state is found.
+	//-------------------------------------------------------------------
+	struct OpenEntry
+	{
+		S32 mState;				///< index of the state
+		F32 mFitness;			///< fitness of the state when entered
+	};
+
+	//-------------------------------------------------------------------
+	/// @fn static S32 timeStateFitnessCompare(const void* a,
+	///                                        const void* b)
+	/// @brief Orders the open entries of a cooperative search by fitness.
+	//-------------------------------------------------------------------
+	static S32 BINARYHEAP_COMPARE timeStateFitnessCompare(const void* a, const void* b);
+
+	//-------------------------------------------------------------------
+	/// @fn static inline U32 getTimeStateBucket(const iAIPathNode* node,
+	///                                          const U32 step)
+	/// @brief Hashes a node & step into a bucket of a cooperative search.
+	//-------------------------------------------------------------------
+	static inline U32 getTimeStateBucket(const iAIPathNode* node, const U32 step)
+	{
+		return ((node->mMapIndex * 31) + step) & (IAIPATHRESERVATION_HASH_SIZE - 1);
+	}
+
+	//-------------------------------------------------------------------
+	/// @fn inline F32 estimateCostToGoal(iAIPathNode* node,
+	///                                   iAIPathNode* goal)
+	/// @brief Performs a vector length from node to goal, to determine
+	///        the cost from the node to the goal.
+	///
+	/// @param node Pointer to the start node.
+	/// @param goal Pointer to the goal node.
+	/// @return Cost to goal.
+	//-------------------------------------------------------------------
+	inline F32 estimateCostToGoal(iAIPathNode* node, iAIPathNode* goal);
+
+	//-------------------------------------------------------------------
+	/// @fn static inline F32 triArea2(const Point3F &a, const Point3F &b,
+	///                                const Point3F &c)
+	/// @brief Twice the area of the triangle in X & Y; negative when c
+	///        is to the left of a to b.
+	//-------------------------------------------------------------------
+	static inline F32 triArea2(const Point3F &a, const Point3F &b, const Point3F &c);
+
+	//-------------------------------------------------------------------
+	/// @fn void resetNodeVariables(Vector<iAIPathNode*> &affectedList)
+	/// @brief Resets the path finding variables of the nodes.
+	///
+	/// @param affectedList Vector of nodes which were changed during
+	///        the pathfinding algorithm.
+	//-------------------------------------------------------------------
+	void resetNodeVariables(Vector<iAIPathNode*> &affectedList);
+};
+
 #endif
\ No newline at end of file
@@ -1,138 +1,250 @@
-//-------------------------------------------------------------------
-// Immersive AI :: Seek :: iAIPathGlobal
-// Copyright (c) 2006 Gavin Bunney & Tom Romano
-//-------------------------------------------------------------------
-
-//-------------------------------------------------------------------
-/// @file iAIPathGlobal.h
-//-------------------------------------------------------------------
-/// @class iAIPathGlobal
-/// @author Gavin Bunney
-/// @version 1.0
-/// @brief Global macros for the Seek :: Path functions.
-/// 
-/// Holds a collection of the macros used within the various path
-/// finding classes.
-//-------------------------------------------------------------------
-#ifndef _IAIPATHGLOBAL_H_
-#define _IAIPATHGLOBAL_H_
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_COLLISION_MASK
-/// @brief Collision mask to detect for node clearance.
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_COLLISION_MASK			(InteriorObjectType | StaticShapeObjectType | VehicleObjectType | PlayerObjectType | StaticTSObjectType)
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_MAX_SLOPE
-/// @brief Max slope between two nodes.
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_MAX_SLOPE					100.0f
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_MAX_SMOOTHED_SLOPE
-/// @brief Max slope between path nodes for smoothing.
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_MAX_SMOOTHED_SLOPE		50.0f
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_NODE_CLEARANCE
-/// @brief Amount of clearance in X, Y & Z around a node.
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_NODE_CLEARANCE			Point3F(1.0, 1.0, 2.3)
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_MOVE_MODIFIER_UNTRAVERSAL
-/// @brief MoveModifier for a node to be considered untraversal.
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_MOVE_MODIFIER_UNTRAVERSAL	100.0f
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_MOVE_MODIFIER_WATER
-/// @brief MoveModifier when a node is in water.
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_MOVE_MODIFIER_WATER		70.0f
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_GRID_BUFFER_INTERIOR
-/// @brief Amount of clearance around an interior for a grid.
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_GRID_BUFFER_INTERIOR		Point3F(10.0, 10.0, 0)
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_GRID_DENSITY_INTERIOR
-/// @brief Density of nodes within an interior.
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_GRID_DENSITY_INTERIOR		2.0f
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_GRID_DENSITY_TERRAIN
-/// @brief Density of nodes on normal terrain.
-//-------------------------------------------------------------------
-//#define IAIPATHGLOBAL_GRID_DENSITY_TERRAIN		0.1f
-#define IAIPATHGLOBAL_GRID_DENSITY_TERRAIN		0.4f
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_GRID_RENDER_CLEARANCE
-/// @brief Clearance above node position to render the grid.
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_GRID_RENDER_CLEARANCE		Point3F(0, 0, 0.3f)
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_GRID_RENDER_NODE_HEIGHT
-/// @brief Height of rendered nodes.
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_GRID_RENDER_NODE_HEIGHT	Point3F(0, 0, 1.0f)
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_GRID_RENDER_COLOUR
-/// @brief Colour of the rendered grid: R, G, B, Alpha
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_GRID_RENDER_COLOUR		31, 102, 155, 255
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_GRID_RENDER_BOX_COLOUR
-/// @brief Colour of the rendered grid bounding box: R, G, B, Alpha
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_GRID_RENDER_BOX_COLOUR	255, 0, 0, 255
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_GRID_RENDER_NODE_COLOUR
-/// @brief Colour of the rendered nodes on a grid: R, G, B, Alpha
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_GRID_RENDER_NODE_COLOUR	255, 255, 0, 255
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_PATH_RENDER_CLEARANCE
-/// @brief Clearance above node to render the path.
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_PATH_RENDER_CLEARANCE		Point3F(0, 0, 1.0f)
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_PATH_RENDER_NODE_HEIGHT
-/// @brief Height of rendered path nodes.
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_PATH_RENDER_NODE_HEIGHT	Point3F(0, 0, 1.0f)
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_PATH_RETRY_COUNT
-/// @brief Number of retries to perform if a path is not found.
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_PATH_RETRY_COUNT			2
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_PATH_SMOOTH_ANGLE_THRESHOLD
-/// @brief Angle (degrees) between two points to detect if it can
-///        be removed in the path smoothing process. The angle
-///        between the two points must be +/- threadhold around 90.
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_PATH_SMOOTH_ANGLE_THRESHOLD	15.0
-
-//-------------------------------------------------------------------
-/// @def IAIPATHGLOBAL_INVALID_POSITION
-/// @brief Used to detect for invalid position nodes.
-//-------------------------------------------------------------------
-#define IAIPATHGLOBAL_INVALID_POSITION			Point3F(-1000.0f, -1000.0f, -1000.0f)
-
-
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathGlobal
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+//-------------------------------------------------------------------
+/// @file iAIPathGlobal.h
+//-------------------------------------------------------------------
+/// @class iAIPathGlobal
+/// @author Gavin Bunney
+/// @version 1.0
+/// @brief Global macros for the Seek :: Path functions.
+/// 
+/// Holds a collection of the macros used within the various path
+/// finding classes.
+//-------------------------------------------------------------------
+#ifndef _IAIPATHGLOBAL_H_
+#define _IAIPATHGLOBAL_H_
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_COLLISION_MASK
+/// @brief Collision mask to detect for node clearance.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_COLLISION_MASK			(InteriorObjectType | StaticShapeObjectType | VehicleObjectType | PlayerObjectType | StaticTSObjectType)
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_STATIC_COLLISION_MASK
+/// @brief Collision mask for the objects grids are built against;
+///        those which don't move. Players & vehicles can be deleted or
+///        moved while a build runs, and are left to the obstacle
+///        overlay & region rebuilds.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_STATIC_COLLISION_MASK		(IAIPATHGLOBAL_COLLISION_MASK & ~(VehicleObjectType | PlayerObjectType))
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_MAX_SLOPE
+/// @brief Max slope between two nodes.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_MAX_SLOPE					100.0f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_NODE_CLEARANCE
+/// @brief Amount of clearance in X, Y & Z around a node.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_NODE_CLEARANCE			Point3F(1.0, 1.0, 2.3)
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_NODE_CLEARANCE_MAX
+/// @brief Furthest distance to an obstruction measured for a node's
+///        clearance; agents wider than this need this much.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_NODE_CLEARANCE_MAX		8.0f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_MOVE_MODIFIER_UNTRAVERSAL
+/// @brief MoveModifier for a node to be considered untraversal.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_MOVE_MODIFIER_UNTRAVERSAL	100.0f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_MOVE_MODIFIER_WATER
+/// @brief MoveModifier when a node is in water.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_MOVE_MODIFIER_WATER		70.0f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_MOVE_MODIFIER_SLOPE
+/// @brief MoveModifier per unit of rise over run of the terrain under
+///        a node; a 45 degree slope costs this much.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_MOVE_MODIFIER_SLOPE		20.0f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_SURFACE_NONE
+/// @brief Surface of a node not over the terrain.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_SURFACE_NONE				0xFF
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_BUFFER_INTERIOR
+/// @brief Amount of clearance around an interior for a grid.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_BUFFER_INTERIOR		Point3F(10.0, 10.0, 0)
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_DENSITY_INTERIOR
+/// @brief Density of nodes within an interior.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_DENSITY_INTERIOR		2.0f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_INTERIOR_FLOOR_OFFSET
+/// @brief Height above an interior floor nodes are placed at, so the
+///        floor itself doesn't block the node's rays. Must be more than
+///        IAIPATHCOLLISION_VOXEL_SIZE, to clear the voxel of the floor.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_INTERIOR_FLOOR_OFFSET	0.75f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_INTERIOR_MAX_SURFACES
+/// @brief Most surfaces looked through, from the top of an interior
+///        down, to find its lowest floor.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_INTERIOR_MAX_SURFACES	8
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_DENSITY_TERRAIN
+/// @brief Density of nodes on normal terrain.
+//-------------------------------------------------------------------
+//#define IAIPATHGLOBAL_GRID_DENSITY_TERRAIN		0.1f
+#define IAIPATHGLOBAL_GRID_DENSITY_TERRAIN		0.4f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_BUILD_THREADS
+/// @brief Default number of threads to build a grid with. Can be
+///        changed via $iAIPathMap::buildThreads.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_BUILD_THREADS		4
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_BUILD_TILE_SIZE
+/// @brief Number of nodes in X & Y of each tile a grid is split
+///        into when building.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_BUILD_TILE_SIZE		32
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_ADAPTIVE_LEVELS
+/// @brief Default size open areas of the terrain grid are merged up
+///        to; rectangular regions of up to 2^levels nodes on a side
+///        become one node, so 4 allows 16x16. Can be changed via
+///        $iAIPathMap::adaptiveLevels, 0 disables merging.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_ADAPTIVE_LEVELS		4
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_ADAPTIVE_MAX_LEVELS
+/// @brief Upper limit on $iAIPathMap::adaptiveLevels.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_ADAPTIVE_MAX_LEVELS	5
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_OPEN_SIZE
+/// @brief Default size wide open areas of the terrain grid are merged
+///        up to, uneven or not, where every position is clear and fully
+///        linked to its neighbours. Can be changed via
+///        $iAIPathMap::openRegions, 0 disables the pass.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_OPEN_SIZE			64
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_OPEN_MAX_SIZE
+/// @brief Upper limit on $iAIPathMap::openRegions; must fit a node's
+///        span.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_OPEN_MAX_SIZE		128
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_TILE_SIZE
+/// @brief Number of nodes in X & Y of each tile the terrain is split
+///        into; each tile is a grid of its own, so merged regions
+///        never span tiles.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_TILE_SIZE			128
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_NODE_ID_LOCAL_BITS
+/// @brief Low bits of a node id holding its lattice index within its
+///        grid; the high bits hold the grid's index in the pathmap.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_NODE_ID_LOCAL_BITS		16
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_ADAPTIVE_FLATNESS
+/// @brief Furthest any node within a merged region may be, in Z, from
+///        the surface through the region's corners.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_ADAPTIVE_FLATNESS	0.5f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_ADAPTIVE_COST_RANGE
+/// @brief Furthest any node within a merged region may be, in
+///        MoveModifier, from the region's first node. The nodes must
+///        share a surface too.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_ADAPTIVE_COST_RANGE	1.0f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_RENDER_CLEARANCE
+/// @brief Clearance above node position to render the grid.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_RENDER_CLEARANCE		Point3F(0, 0, 0.3f)
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_RENDER_NODE_HEIGHT
+/// @brief Height of rendered nodes.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_RENDER_NODE_HEIGHT	Point3F(0, 0, 1.0f)
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_RENDER_COLOUR
+/// @brief Colour of the rendered grid: R, G, B, Alpha
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_RENDER_COLOUR		31, 102, 155, 255
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_RENDER_BOX_COLOUR
+/// @brief Colour of the rendered grid bounding box: R, G, B, Alpha
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_RENDER_BOX_COLOUR	255, 0, 0, 255
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_GRID_RENDER_NODE_COLOUR
+/// @brief Colour of the rendered nodes on a grid: R, G, B, Alpha
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_GRID_RENDER_NODE_COLOUR	255, 255, 0, 255
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_PATH_RENDER_CLEARANCE
+/// @brief Clearance above node to render the path.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_PATH_RENDER_CLEARANCE		Point3F(0, 0, 1.0f)
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_PATH_RENDER_NODE_HEIGHT
+/// @brief Height of rendered path nodes.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_PATH_RENDER_NODE_HEIGHT	Point3F(0, 0, 1.0f)
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_PATH_RETRY_COUNT
+/// @brief Number of retries to perform if a path is not found.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_PATH_RETRY_COUNT			2
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_PATH_CACHE_SIZE
+/// @brief Number of found paths kept for agents asking for the same
+///        path again; 0 disables the cache.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_PATH_CACHE_SIZE			64
+
+//-------------------------------------------------------------------
+/// @def IAIPATHGLOBAL_INVALID_POSITION
+/// @brief Used to detect for invalid position nodes.
+//-------------------------------------------------------------------
+#define IAIPATHGLOBAL_INVALID_POSITION			Point3F(-1000.0f, -1000.0f, -1000.0f)
+
+
 #endif
\ No newline at end of file
@@ -1,350 +1,1937 @@
-//-------------------------------------------------------------------
-// Immersive AI :: Seek :: iAIPathGrid
-// Copyright (c) 2006 Gavin Bunney & Tom Romano
-//-------------------------------------------------------------------
-#include "terrain/terrData.h"
-#include "interior/interiorInstance.h"
-#include "sceneGraph/sceneGraph.h"
-#include "sceneGraph/sceneState.h"
-#include "platform/profiler.h"
-
-#include "iAIPathNode.h"
-#include "iAIPathGrid.h"
-#include "iAIPathMap.h"
-#include "iAIPathGlobal.h"
-
-IMPLEMENT_CONOBJECT(iAIPathGrid);
-
-iAIPathGrid::iAIPathGrid()
-{
-	this->setPosition(Point3F(0,0,0));
-	this->mTypeMask |= iAIPathGridObjectType;
-
-	this->mCompiled = false;
-	this->mDensity = 0.0f;
-	this->mGridBox = Box3F(0,0,0, 0,0,0);
-	this->mShow = false;
-	this->mNodesCountX = 0;
-	this->mNodesCountY = 0;
-}
-
-iAIPathGrid::~iAIPathGrid()
-{
-	while (!this->mNodes.empty())
-	{
-		this->mNodes.erase((U32)0);
-	}
-	this->mNodes.clear();
-}
-
-bool iAIPathGrid::onAdd()
-{
-	// call Parent, ensure worked
-	if (!Parent::onAdd())
-	   return false;
-
-	// create object box
-	this->updateWorldBox();
-
-	// add to scene
-    gClientContainer.addObject(this);
-    gClientSceneGraph->addObjectToScene(this);
-	
-	return true;
-}
-
-void iAIPathGrid::onRemove()
-{
-	// remove from scene
-	removeFromScene();
-	Parent::onRemove();
-}
-
-bool iAIPathGrid::prepRenderImage(SceneState *state, const U32 stateKey, const U32 startZone, const bool modifyBaseZoneState)
-{
-	// render if showing the node
-	if (this->mShow)
-	{
-		// return if last state
-		if (this->isLastState(state, stateKey)) return false;
-		
-		// set last state
-		this->setLastState(state, stateKey);
-
-		// see if object rendered
-		if (state->isObjectRendered(this))
-		{
-			// get a SceneRenderImage to show on	
-			SceneRenderImage* image = new SceneRenderImage;
-			image->obj = this;
-
-			// insert into scene image
-			state->insertRenderImage(image);
-		}
-	}
-
-	return false;
-}
-
-void iAIPathGrid::renderObject(SceneState *state, SceneRenderImage *image)
-{
-	// save matrix to restore canonical state
-	glPushMatrix();
-	
-	// going to render some lines!
-	glBegin(GL_LINES);
-	
-	// render the nodes
-	for (U32 i = 0; i < this->mNodes.size(); ++i)
-	{
-		glColor4ub(IAIPATHGLOBAL_GRID_RENDER_NODE_COLOUR);
-		glVertex3fv(this->mNodes[i]->mPosition + IAIPATHGLOBAL_GRID_RENDER_CLEARANCE);
-		glVertex3fv(this->mNodes[i]->mPosition + IAIPATHGLOBAL_GRID_RENDER_CLEARANCE + IAIPATHGLOBAL_GRID_RENDER_NODE_HEIGHT);
-
-		// render neighbour links
-		glColor4ub(IAIPATHGLOBAL_GRID_RENDER_COLOUR);
-		for (U32 j = 0; j < this->mNodes[i]->mNeighbours.size(); ++j)
-		{
-			if (this->mNodes[i]->mNeighbours[j])
-			{
-				glVertex3fv(this->mNodes[i]->mPosition + IAIPATHGLOBAL_GRID_RENDER_CLEARANCE);
-				glVertex3fv(this->mNodes[i]->mNeighbours[j]->mPosition + IAIPATHGLOBAL_GRID_RENDER_CLEARANCE);
-			}
-		}
-	}
-
-	// render the gridbox
-	glColor4ub(IAIPATHGLOBAL_GRID_RENDER_BOX_COLOUR);
-	dglWireCube(Point3F(this->mObjBox.len_x()/2, this->mObjBox.len_y()/2, this->mObjBox.len_z()/2), this->getBoxCenter());
-
-	// end of line drawing
-	glEnd();
-
-	// restore canonical rendering state
-	glDisable(GL_BLEND);
-	glDisable(GL_TEXTURE_2D);
-
-	// restore canonical maxtrix state
-	glPopMatrix();
-
-	// ensure canonical state is restored
-	AssertFatal(dglIsInCanonicalState(), "Error, GL not in canonical state on exit");
-}
-
-void iAIPathGrid::toggleDisplay()
-{
-	this->mShow = !this->mShow;
-}
-
-void iAIPathGrid::clearGrid()
-{
-	this->mNodes.clear();
-	this->mCompiled = false;
-	this->mDensity = 0.0f;
-	this->mGridBox = Box3F(0,0,0, 0,0,0);
-	this->mNodesCountX = 0;
-	this->mNodesCountY = 0;
-}
-
-bool iAIPathGrid::createTerrainGrid(const Point3F worldStart, const Point3F worldEnd, Vector<Box3F> &avoidList, const F32 density)
-{
-	// grab the terrain & ensure valid
-	TerrainBlock *terrain = dynamic_cast<TerrainBlock*>(Sim::findObject("Terrain"));
-	if (!terrain)
-		return false;
-
-	// clear all the nodes
-	this->clearGrid();
-
-	// set the grid start & end bounds
-	this->mGridBox = Box3F(worldStart, worldEnd);
-	
-	// check the gridbox is actually valid
-	if (!this->mGridBox.isValidBox())
-	{
-		Con::errorf("Immersive AI :: Seek :: Grid build failed - grid box not valid!");
-		return false;
-	}
-
-	// the density is nodes per gridsize; default gridSize to 10.0f if none found
-	this->mDensity = density / Con::getFloatVariable("Server::gridSize", 10.0f);
-
-	// density step needs to be the squareroot, as operates in both X & Y
-	F32 densityStep = 1 / mSqrt(this->mDensity);
-
-	// calculate the count of nodes in x & y
-	this->mNodesCountX = this->mGridBox.len_x() * mSqrt(this->mDensity);
-	this->mNodesCountY = this->mGridBox.len_y() * mSqrt(this->mDensity);
-
-	// create all nodes
-	for (U16 iterX = 0; iterX < this->mNodesCountX; ++iterX)
-	{
-		for (U16 iterY = 0; iterY < this->mNodesCountY; ++iterY)
-		{
-			Point3F nodePos = this->mGridBox.min;
-			nodePos.x += densityStep * iterX;
-			nodePos.y += densityStep * iterY;
-
-			// transform point to terrain transform
-			terrain->getWorldTransform().mulP(nodePos);
-			nodePos.convolveInverse(terrain->getScale());
-			F32 height;
-			if (terrain->getHeight(Point2F(nodePos.x, nodePos.y), &height))
-			{
-				nodePos.z = height;
-				nodePos.convolve(terrain->getScale());
-				terrain->getTransform().mulP(nodePos);
-			}
-
-			// create the node
-			iAIPathNode *newNode = new iAIPathNode(nodePos, this, iterX, iterY);
-			this->mNodes.push_back(newNode);
-		}
-	}
-
-	// join all the node neighbours
-	for (U32 iter = 0; iter < this->mNodes.size(); ++iter)
-	{
-		U16 currentX = this->mNodes[iter]->mIdX;
-		U16 currentY = this->mNodes[iter]->mIdY;
-		
-		// north
-		if (currentY < (this->mNodesCountY - 1))
-			this->mNodes[iter]->addNeighbour(this->mNodes[iter+1]);
-
-		// south
-		if (currentY > 0)
-			this->mNodes[iter]->addNeighbour(this->mNodes[iter-1]);
-
-		// east
-		if (currentX < (this->mNodesCountX-1))
-			this->mNodes[iter]->addNeighbour(this->mNodes[iter + this->mNodesCountY]);
-
-		// west
-		if (currentX > 0)
-			this->mNodes[iter]->addNeighbour(this->mNodes[iter - this->mNodesCountY]);
-
-		// north-east
-		if (currentX < (this->mNodesCountX - 1) && (currentY < (this->mNodesCountY - 1)))
-			this->mNodes[iter]->addNeighbour(this->mNodes[ iter + this->mNodesCountY + 1]);
-
-		// south-east
-		if (currentX < (this->mNodesCountX - 1) && (currentY > 0))
-			this->mNodes[iter]->addNeighbour(this->mNodes[ iter+this->mNodesCountY-1]);
-
-		// south-west
-		if ((currentX > 0) && (currentY > 0))
-			this->mNodes[iter]->addNeighbour(this->mNodes[ iter - this->mNodesCountY - 1 ]);
-
-		// north-west
-		if ((currentX > 0) && (currentY < (this->mNodesCountY - 1)))
-			this->mNodes[iter]->addNeighbour(this->mNodes[ iter - this->mNodesCountY + 1 ]);
-	}
-
-	// cull invalid and alone nodes
-	for (U32 gridIter = 0; gridIter < this->mNodes.size(); ++gridIter)
-	{
-		// remove the node if in an invalid position or has no neighbours or in avoid list
-		if ((!this->mNodes[gridIter]->isClear()) || (this->mNodes[gridIter]->mNeighbours.size() == 0) ||
-			this->isInAvoidList(this->mNodes[gridIter], avoidList))
-		{
-			// remove it from its neighbours first
-			for (U32 j = 0; j < this->mNodes[gridIter]->mNeighbours.size(); ++j)
-			{
-				this->mNodes[gridIter]->mNeighbours[j]->removeNeighbour(this->mNodes[gridIter]);
-			}
-			
-			// remove from grid list
-			this->mNodes.erase(gridIter);
-		}
-	}
-
-	// set as compiled if any nodes in the grid
-	this->mCompiled = (this->mNodes.size() > 0);
-
-	// update the world box so renders properly
-	this->updateWorldBox();
-
-	return this->mCompiled;
-}
-
-bool iAIPathGrid::isInAvoidList(const iAIPathNode *node, const Vector<Box3F> &avoidList)
-{
-	// iterate over all boxes in the avoid list
-	for (U32 z = 0; z < avoidList.size(); ++z)
-	{
-		Box3F nodeBox = Box3F(node->mPosition - (IAIPATHGLOBAL_NODE_CLEARANCE/2), node->mPosition + (IAIPATHGLOBAL_NODE_CLEARANCE/2));
-
-		// see if the avoid list box overlaps the nodes box
-		if (avoidList[z].isOverlapped(nodeBox))
-			return true;
-	}
-
-	// didn't overlap on any boxes
-	return false;
-}
-
-void iAIPathGrid::updateWorldBox()
-{
-	if (this->mCompiled)
-	{
-		Point3F min = Point3F(this->mNodes.front()->mPosition);
-		Point3F max = Point3F(this->mNodes.front()->mPosition);
-
-		// iterate over all nodes and find the min & max
-		for (U32 i = 0; i < this->mNodes.size(); ++i)
-		{
-			if (this->mNodes[i]->mPosition.x < min.x)
-				min.x = this->mNodes[i]->mPosition.x;
-			if (this->mNodes[i]->mPosition.y < min.y)
-				min.y = this->mNodes[i]->mPosition.y;
-			if (this->mNodes[i]->mPosition.z < min.z)
-				min.z = this->mNodes[i]->mPosition.z;
-
-
-			if (this->mNodes[i]->mPosition.x > max.x)
-				max.x = this->mNodes[i]->mPosition.x;
-			if (this->mNodes[i]->mPosition.y > max.y)
-				max.y = this->mNodes[i]->mPosition.y;
-			if (this->mNodes[i]->mPosition.z > max.z)
-				max.z = this->mNodes[i]->mPosition.z;
-		}
-
-		// set position as halfway point
-		this->setPosition(min + ((max - min) / 2));
-		
-		// create a box to encompass the entire path
-		this->mObjBox.min.set(-(this->getPosition() - min));
-		this->mObjBox.max.set(max - this->getPosition());
-
-		// must reset world box & transform when changing object box
-		this->resetWorldBox();
-		this->setRenderTransform(mObjToWorld);
-	}
-}
-
-iAIPathNode* iAIPathGrid::getClosestNode(const Point3F position)
-{
-	PROFILE_SCOPE(iAIPathGrid_getClosestNode);
-
-	F32 closestVec = 1000.0f;
-	F32 currentVec = 1000.0f;
-	iAIPathNode* closestNode = 0;
-
-	// iterate over all nodes
-	for (U32 i = 0; i < this->mNodes.size(); ++i)
-	{
-		// calculate the vector length
-		currentVec = Point3F(position - this->mNodes[i]->mPosition).len();
-
-		// check if its closest one found so far
-		if (currentVec < closestVec)
-		{
-			// save as closest so far
-			closestVec = currentVec;
-			closestNode = this->mNodes[i];
-		}
-	}
-
-	return closestNode;
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathGrid
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+#include "terrain/terrData.h"
+#include "interior/interiorInstance.h"
+#include "sceneGraph/sceneGraph.h"
+#include "sceneGraph/sceneState.h"
+#include "platform/profiler.h"
+#include "immersiveAI/core/iAIJobQueue.h"
+
+#include "iAIPathNode.h"
+#include "iAIPathGrid.h"
+#include "iAIPathMap.h"
+#include "iAIPathGlobal.h"
+#include "iAIPathCollision.h"
+
+IMPLEMENT_CONOBJECT(iAIPathGrid);
+
+const S32 iAIPathGrid::smDirectionX[iAIPathGrid::DirectionCount] = { 0, 0, 1, -1, 1, 1, -1, -1 };
+const S32 iAIPathGrid::smDirectionY[iAIPathGrid::DirectionCount] = { 1, -1, 0, 0, 1, -1, -1, 1 };
+const U8 iAIPathGrid::smDirectionOpposite[iAIPathGrid::DirectionCount] = { iAIPathGrid::South, iAIPathGrid::North, iAIPathGrid::West, iAIPathGrid::East,
+																		   iAIPathGrid::SouthWest, iAIPathGrid::NorthWest, iAIPathGrid::NorthEast, iAIPathGrid::SouthEast };
+
+// directions validated by the build; the rest are mirrored from the neighbour
+static const U8 sValidateDirections[] = { iAIPathGrid::North, iAIPathGrid::East, iAIPathGrid::NorthEast, iAIPathGrid::SouthEast };
+
+static inline bool isValidateDirection(const U32 dir)
+{
+	for (U32 i = 0; i < sizeof(sValidateDirections); ++i)
+	{
+		if (sValidateDirections[i] == dir)
+			return true;
+	}
+	return false;
+}
+
+//-------------------------------------------------------------------
+/// @struct iAIPathGridBuild
+/// @brief Shared state of a grid build, parsed to each build job.
+//-------------------------------------------------------------------
+struct iAIPathGridBuild
+{
+	//-------------------------------------------------------------------
+	/// @var iAIPathGrid* mGrid
+	/// @brief Grid being built.
+	//-------------------------------------------------------------------
+	iAIPathGrid *mGrid;
+
+	//-------------------------------------------------------------------
+	/// @var TerrainBlock* mTerrain
+	/// @brief Terrain the grid is placed on.
+	//-------------------------------------------------------------------
+	TerrainBlock *mTerrain;
+
+	//-------------------------------------------------------------------
+	/// @var iAIPathCollision mCollision
+	/// @brief Collision snapshot the jobs cast against.
+	//-------------------------------------------------------------------
+	iAIPathCollision mCollision;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mTilesX
+	/// @brief Number of build tiles in X.
+	//-------------------------------------------------------------------
+	U32 mTilesX;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mTileCount
+	/// @brief Total number of build tiles.
+	//-------------------------------------------------------------------
+	U32 mTileCount;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mThreadCount
+	/// @brief Number of threads to build with.
+	//-------------------------------------------------------------------
+	U32 mThreadCount;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mStartTime
+	/// @brief Real time the build was started.
+	//-------------------------------------------------------------------
+	U32 mStartTime;
+
+	//-------------------------------------------------------------------
+	/// @var volatile bool mCancelled
+	/// @brief Set to stop the build early.
+	//-------------------------------------------------------------------
+	volatile bool mCancelled;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<U32> mRayCount
+	/// @brief Per tile; number of rays cast by the tile's jobs.
+	//-------------------------------------------------------------------
+	Vector<U32> mRayCount;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<U8> mTileDone
+	/// @brief Per tile; number of build jobs finished on the tile.
+	//-------------------------------------------------------------------
+	Vector<U8> mTileDone;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<U8> mSteep
+	/// @brief Per lattice position; bit per direction set if the link
+	///        that way is too steep, found when the tile is sampled.
+	//-------------------------------------------------------------------
+	Vector<U8> mSteep;
+
+	//-------------------------------------------------------------------
+	/// @var Point3F mTerrainOrigin
+	/// @brief Lattice position 0,0 in unscaled terrain space.
+	//-------------------------------------------------------------------
+	Point3F mTerrainOrigin;
+
+	//-------------------------------------------------------------------
+	/// @var Point3F mTerrainStepX
+	/// @brief Terrain space step per lattice position in X.
+	//-------------------------------------------------------------------
+	Point3F mTerrainStepX;
+
+	//-------------------------------------------------------------------
+	/// @var Point3F mTerrainStepY
+	/// @brief Terrain space step per lattice position in Y.
+	//-------------------------------------------------------------------
+	Point3F mTerrainStepY;
+
+	//-------------------------------------------------------------------
+	/// @var Point3F mWorldOrigin
+	/// @brief World position of lattice position 0,0 at terrain height 0.
+	//-------------------------------------------------------------------
+	Point3F mWorldOrigin;
+
+	//-------------------------------------------------------------------
+	/// @var Point3F mWorldStepX
+	/// @brief World step per lattice position in X.
+	//-------------------------------------------------------------------
+	Point3F mWorldStepX;
+
+	//-------------------------------------------------------------------
+	/// @var Point3F mWorldStepY
+	/// @brief World step per lattice position in Y.
+	//-------------------------------------------------------------------
+	Point3F mWorldStepY;
+
+	//-------------------------------------------------------------------
+	/// @var Point3F mWorldUp
+	/// @brief World step per unit of heightfield height.
+	//-------------------------------------------------------------------
+	Point3F mWorldUp;
+
+	//-------------------------------------------------------------------
+	/// @var F32 mSlopeScale
+	/// @brief Converts a terrain space slope into a world one.
+	//-------------------------------------------------------------------
+	F32 mSlopeScale;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<Box3F> mWaterBoxes
+	/// @brief World boxes of the water blocks over the grid.
+	//-------------------------------------------------------------------
+	Vector<Box3F> mWaterBoxes;
+
+	//-------------------------------------------------------------------
+	/// @var F32 mSurfaceCosts[TerrainBlock::MaterialGroups]
+	/// @brief Cost of each terrain material.
+	//-------------------------------------------------------------------
+	F32 mSurfaceCosts[TerrainBlock::MaterialGroups];
+};
+
+// container callback which collects the world box of each water block
+static void waterCallback(SceneObject *object, void *key)
+{
+	Vector<Box3F> *waterBoxes = static_cast<Vector<Box3F>*>(key);
+	waterBoxes->push_back(object->getWorldBox());
+}
+
+// finds the water blocks over an area; main thread only
+static void findWaterBoxes(const Box3F &area, Vector<Box3F> &waterBoxes)
+{
+	Box3F column = area;
+	column.min.z = -F32_MAX;
+	column.max.z = F32_MAX;
+
+	waterBoxes.clear();
+	gServerContainer.findObjects(column, WaterObjectType, waterCallback, &waterBoxes);
+}
+
+void iAIPathGrid::getSurfaceCosts(TerrainBlock *terrain, F32 *surfaceCosts)
+{
+	for (U32 i = 0; i < TerrainBlock::MaterialGroups; ++i)
+	{
+		surfaceCosts[i] = 0.0f;
+
+		const char *material = terrain->mMaterialFileName[i];
+		if (!material || !material[0])
+			continue;
+
+		// keyed on the name without its path
+		const char *name = dStrrchr(material, '/');
+		name = name ? name + 1 : material;
+		surfaceCosts[i] = Con::getFloatVariable(avar("$iAIPathMap::surfaceCost%s", name), 0.0f);
+	}
+}
+
+// water cost at a position; in water if there's water anywhere above the node's waist
+static inline F32 getWaterCost(const Vector<Box3F> &waterBoxes, const Point3F &position)
+{
+	F32 waist = position.z - (IAIPATHGLOBAL_NODE_CLEARANCE.z / 2);
+
+	for (U32 i = 0; i < waterBoxes.size(); ++i)
+	{
+		const Box3F &box = waterBoxes[i];
+		if ((position.x >= box.min.x) && (position.x <= box.max.x) && (position.y >= box.min.y) && (position.y <= box.max.y) &&
+			(waist <= box.max.z))
+			return IAIPATHGLOBAL_MOVE_MODIFIER_WATER;
+	}
+	return 0.0f;
+}
+
+// height of the terrain at a point in unscaled terrain space, read straight
+// from the heightfield; same result as TerrainBlock::getHeight. Also gives
+// the slope of the triangle under the point, and the square's material
+static inline bool sampleHeightfield(TerrainBlock *terrain, const F32 invSquareSize, const F32 posX, const F32 posY, F32 &height, F32 &slope, U8 &material)
+{
+	F32 xp = posX * invSquareSize;
+	F32 yp = posY * invSquareSize;
+	S32 x = S32(xp);
+	S32 y = S32(yp);
+	xp -= (F32)x;
+	yp -= (F32)y;
+	x &= TerrainBlock::BlockMask;
+	y &= TerrainBlock::BlockMask;
+
+	GridSquare *square = terrain->findSquare(0, Point2I(x, y));
+	if (square->flags & GridSquare::Empty)
+		return false;
+
+	const U16 *heightMap = terrain->heightMap;
+	S32 nextX = (x + 1) & TerrainBlock::BlockMask;
+	S32 nextY = (y + 1) & TerrainBlock::BlockMask;
+	F32 zBottomLeft = fixedToFloat(heightMap[x + (y << TerrainBlock::BlockShift)]);
+	F32 zBottomRight = fixedToFloat(heightMap[nextX + (y << TerrainBlock::BlockShift)]);
+	F32 zTopLeft = fixedToFloat(heightMap[x + (nextY << TerrainBlock::BlockShift)]);
+	F32 zTopRight = fixedToFloat(heightMap[nextX + (nextY << TerrainBlock::BlockShift)]);
+
+	// interpolate across whichever triangle of the square the point is in
+	F32 riseX, riseY;
+	if (square->flags & GridSquare::Split45)
+	{
+		if (xp > yp)
+		{
+			riseX = zBottomRight - zBottomLeft;
+			riseY = zTopRight - zBottomRight;
+			height = zBottomLeft + xp * riseX + yp * riseY;
+		} else
+		{
+			riseX = zTopRight - zTopLeft;
+			riseY = zTopLeft - zBottomLeft;
+			height = zBottomLeft + xp * riseX + yp * riseY;
+		}
+	} else {
+		if (1.0f - xp > yp)
+		{
+			riseX = zBottomRight - zBottomLeft;
+			riseY = zTopLeft - zBottomLeft;
+			height = zBottomLeft + xp * riseX + yp * riseY;
+		} else
+		{
+			riseX = zTopRight - zTopLeft;
+			riseY = zTopRight - zBottomRight;
+			height = zBottomRight + (1.0f - xp) * -riseX + yp * riseY;
+		}
+	}
+
+	// the triangle is flat, so its rise per square is the slope anywhere on it
+	slope = mSqrt((riseX * riseX) + (riseY * riseY)) * invSquareSize;
+	material = terrain->getBaseMaterial(x, y);
+	return true;
+}
+
+iAIPathGrid::iAIPathGrid()
+{
+	this->setPosition(Point3F(0,0,0));
+	this->mTypeMask |= iAIPathGridObjectType;
+
+	this->mCompiled = false;
+	this->mDensity = 0.0f;
+	this->mGridBox = Box3F(0,0,0, 0,0,0);
+	this->mShow = false;
+	this->mNodesCountX = 0;
+	this->mNodesCountY = 0;
+	this->mGridId = 0;
+	this->mMapTile = -1;
+	this->mNodeBlock = 0;
+	this->mBuild = 0;
+	this->mAdaptiveLevels = 0;
+	this->mOpenSize = 0;
+	this->mInteriorGrid = false;
+	this->mInteriorBox = Box3F(0,0,0, 0,0,0);
+	this->mBuildRayCount = 0;
+	this->mBuildTime = 0;
+}
+
+iAIPathGrid::~iAIPathGrid()
+{
+	this->clearGrid();
+}
+
+bool iAIPathGrid::onAdd()
+{
+	// call Parent, ensure worked
+	if (!Parent::onAdd())
+	   return false;
+
+	// create object box
+	this->updateWorldBox();
+
+	// add to scene
+    gClientContainer.addObject(this);
+    gClientSceneGraph->addObjectToScene(this);
+	
+	return true;
+}
+
+void iAIPathGrid::onRemove()
+{
+	// remove from scene
+	removeFromScene();
+	Parent::onRemove();
+}
+
+bool iAIPathGrid::prepRenderImage(SceneState *state, const U32 stateKey, const U32 startZone, const bool modifyBaseZoneState)
+{
+	// render if showing the node
+	if (this->mShow)
+	{
+		// return if last state
+		if (this->isLastState(state, stateKey)) return false;
+		
+		// set last state
+		this->setLastState(state, stateKey);
+
+		// see if object rendered
+		if (state->isObjectRendered(this))
+		{
+			// get a SceneRenderImage to show on	
+			SceneRenderImage* image = new SceneRenderImage;
+			image->obj = this;
+
+			// insert into scene image
+			state->insertRenderImage(image);
+		}
+	}
+
+	return false;
+}
+
+void iAIPathGrid::renderObject(SceneState *state, SceneRenderImage *image)
+{
+	// save matrix to restore canonical state
+	glPushMatrix();
+	
+	// going to render some lines!
+	glBegin(GL_LINES);
+	
+	// render the nodes
+	for (U32 i = 0; i < this->mNodes.size(); ++i)
+	{
+		glColor4ub(IAIPATHGLOBAL_GRID_RENDER_NODE_COLOUR);
+		glVertex3fv(this->mNodes[i]->mPosition + IAIPATHGLOBAL_GRID_RENDER_CLEARANCE);
+		glVertex3fv(this->mNodes[i]->mPosition + IAIPATHGLOBAL_GRID_RENDER_CLEARANCE + IAIPATHGLOBAL_GRID_RENDER_NODE_HEIGHT);
+
+		// render neighbour links
+		glColor4ub(IAIPATHGLOBAL_GRID_RENDER_COLOUR);
+		for (U32 j = 0; j < this->mNodes[i]->mNeighbours.size(); ++j)
+		{
+			if (this->mNodes[i]->mNeighbours[j])
+			{
+				glVertex3fv(this->mNodes[i]->mPosition + IAIPATHGLOBAL_GRID_RENDER_CLEARANCE);
+				glVertex3fv(this->mNodes[i]->mNeighbours[j]->mPosition + IAIPATHGLOBAL_GRID_RENDER_CLEARANCE);
+			}
+		}
+	}
+
+	// render the gridbox
+	glColor4ub(IAIPATHGLOBAL_GRID_RENDER_BOX_COLOUR);
+	dglWireCube(Point3F(this->mObjBox.len_x()/2, this->mObjBox.len_y()/2, this->mObjBox.len_z()/2), this->getBoxCenter());
+
+	// end of line drawing
+	glEnd();
+
+	// restore canonical rendering state
+	glDisable(GL_BLEND);
+	glDisable(GL_TEXTURE_2D);
+
+	// restore canonical maxtrix state
+	glPopMatrix();
+
+	// ensure canonical state is restored
+	AssertFatal(dglIsInCanonicalState(), "Error, GL not in canonical state on exit");
+}
+
+void iAIPathGrid::toggleDisplay()
+{
+	this->mShow = !this->mShow;
+}
+
+void iAIPathGrid::clearGrid()
+{
+	this->mNodes.clear();
+	this->mLattice.clear();
+	this->mClear.clear();
+	this->mEdges.clear();
+	this->mEdgeState.clear();
+	this->mRegion.clear();
+	this->mAvoidList.clear();
+
+	// free all the nodes
+	delete [] this->mNodeBlock;
+	this->mNodeBlock = 0;
+
+	// and any build left unfinished; its jobs must have stopped already
+	delete this->mBuild;
+	this->mBuild = 0;
+
+	this->mCompiled = false;
+	this->mDensity = 0.0f;
+	this->mGridBox = Box3F(0,0,0, 0,0,0);
+	this->mNodesCountX = 0;
+	this->mNodesCountY = 0;
+	this->mAdaptiveLevels = 0;
+	this->mOpenSize = 0;
+	this->mInteriorGrid = false;
+	this->mInteriorBox = Box3F(0,0,0, 0,0,0);
+	this->mBuildRayCount = 0;
+	this->mBuildTime = 0;
+}
+
+void iAIPathGrid::releaseNodes()
+{
+	// clear doesn't free the storage, so compact the lists too
+	this->mNodes.clear();
+	this->mNodes.compact();
+	this->mLattice.clear();
+	this->mLattice.compact();
+	this->mClear.clear();
+	this->mClear.compact();
+	this->mEdges.clear();
+	this->mEdges.compact();
+	this->mEdgeState.clear();
+	this->mEdgeState.compact();
+	this->mRegion.clear();
+	this->mRegion.compact();
+
+	delete [] this->mNodeBlock;
+	this->mNodeBlock = 0;
+
+	this->mCompiled = false;
+}
+
+U32 iAIPathGrid::getMemoryUsage()
+{
+	if (!this->isResident())
+		return 0;
+
+	// the node block, lattice & per position masks, then each kept node's list entry & neighbours
+	U32 latticeSize = this->mNodesCountX * this->mNodesCountY;
+	return (latticeSize * (sizeof(iAIPathNode) + sizeof(iAIPathNode*) + (2 * sizeof(U8)) + sizeof(U32))) +
+		(this->mEdgeState.size() * sizeof(U16)) + (this->mNodes.size() * sizeof(iAIPathNode*) * (1 + DirectionCount));
+}
+
+void iAIPathGrid::getTileBounds(const U32 tile, U32 &startX, U32 &endX, U32 &startY, U32 &endY)
+{
+	U32 tilesX = (this->mNodesCountX + IAIPATHGLOBAL_GRID_BUILD_TILE_SIZE - 1) / IAIPATHGLOBAL_GRID_BUILD_TILE_SIZE;
+
+	startX = (tile % tilesX) * IAIPATHGLOBAL_GRID_BUILD_TILE_SIZE;
+	startY = (tile / tilesX) * IAIPATHGLOBAL_GRID_BUILD_TILE_SIZE;
+	endX = getMin(startX + IAIPATHGLOBAL_GRID_BUILD_TILE_SIZE, this->mNodesCountX);
+	endY = getMin(startY + IAIPATHGLOBAL_GRID_BUILD_TILE_SIZE, this->mNodesCountY);
+}
+
+Point3F iAIPathGrid::placeNode(TerrainBlock *terrain, const U16 idX, const U16 idY, const iAIPathCollision *collision, U32 *rayCount)
+{
+	// density step needs to be the squareroot, as operates in both X & Y
+	F32 densityStep = 1 / mSqrt(this->mDensity);
+
+	Point3F nodePos = this->mGridBox.min;
+	nodePos.x += densityStep * idX;
+	nodePos.y += densityStep * idY;
+
+	// transform point to terrain transform
+	terrain->getWorldTransform().mulP(nodePos);
+	nodePos.convolveInverse(terrain->getScale());
+	F32 height;
+	if (terrain->getHeight(Point2F(nodePos.x, nodePos.y), &height))
+	{
+		nodePos.z = height;
+		nodePos.convolve(terrain->getScale());
+		terrain->getTransform().mulP(nodePos);
+	}
+
+	if (!this->mInteriorGrid)
+		return nodePos;
+
+	// look down through the interior for the lowest surface with room to stand on it
+	Point3F floorPos = nodePos;
+	bool floorFound = false;
+	Point3F start(nodePos.x, nodePos.y, this->mInteriorBox.max.z + IAIPATHGLOBAL_NODE_CLEARANCE.z);
+	Point3F offset(0, 0, IAIPATHGLOBAL_GRID_INTERIOR_FLOOR_OFFSET);
+	Point3F clearance(0, 0, IAIPATHGLOBAL_NODE_CLEARANCE.z);
+
+	for (U32 i = 0; (i < IAIPATHGLOBAL_GRID_INTERIOR_MAX_SURFACES) && (start.z > nodePos.z); ++i)
+	{
+		RayInfo info;
+		if (!iAIPathNode::castRay(start, nodePos, collision, rayCount, &info, IAIPATHGLOBAL_STATIC_COLLISION_MASK))
+			break;
+
+		if (!iAIPathNode::castRay(info.point + offset, info.point + clearance, collision, rayCount, 0, IAIPATHGLOBAL_STATIC_COLLISION_MASK))
+		{
+			floorPos = info.point + offset;
+			floorFound = true;
+		}
+
+		start = info.point - offset;
+	}
+
+	// the terrain is lowest of all, if it's open
+	if (!floorFound || !iAIPathNode::castRay(nodePos + offset, nodePos + clearance, collision, rayCount, 0, IAIPATHGLOBAL_STATIC_COLLISION_MASK))
+		return nodePos;
+
+	return floorPos;
+}
+
+void iAIPathGrid::sampleNode(TerrainBlock *terrain, const U16 idX, const U16 idY, const iAIPathCollision *collision, U32 *rayCount)
+{
+	// setup the node in its lattice slot
+	U32 index = (idX * this->mNodesCountY) + idY;
+	iAIPathNode *node = &this->mNodeBlock[index];
+	node->set(this->placeNode(terrain, idX, idY, collision, rayCount), this, idX, idY);
+
+	// node is only usable if not within the avoid list and clear
+	this->mClear[index] = (!this->isInAvoidList(node, this->mAvoidList) && node->isClear(collision, rayCount, IAIPATHGLOBAL_STATIC_COLLISION_MASK));
+}
+
+void iAIPathGrid::bakeNode(TerrainBlock *terrain, iAIPathNode *node, const Vector<Box3F> &waterBoxes, const F32 *surfaceCosts)
+{
+	for (U32 i = 0; i < iAIPathNode::CostChannelCount; ++i)
+		node->mCost[i] = 0.0f;
+	node->mSurface = IAIPATHGLOBAL_SURFACE_NONE;
+
+	node->mCost[iAIPathNode::CostWater] = getWaterCost(waterBoxes, node->mPosition);
+
+	// the terrain under the node; interior floors have no slope or surface to speak of
+	if (terrain && !this->mInteriorGrid)
+	{
+		Point3F terrainPos = node->mPosition;
+		terrain->getWorldTransform().mulP(terrainPos);
+		terrainPos.convolveInverse(terrain->getScale());
+
+		F32 height, slope;
+		U8 material;
+		if (sampleHeightfield(terrain, 1.0f / (F32)terrain->squareSize, terrainPos.x, terrainPos.y, height, slope, material))
+		{
+			const Point3F &scale = terrain->getScale();
+			node->mSurface = material;
+			node->mCost[iAIPathNode::CostSlope] = slope * (scale.z / getMax(scale.x, 0.001f)) * IAIPATHGLOBAL_MOVE_MODIFIER_SLOPE;
+			node->mCost[iAIPathNode::CostSurface] = surfaceCosts[material % TerrainBlock::MaterialGroups];
+		}
+	}
+
+	node->updateMoveModifier();
+}
+
+S32 iAIPathGrid::getClearanceSteps()
+{
+	return (S32)mCeil(IAIPATHGLOBAL_NODE_CLEARANCE_MAX * mSqrt(this->mDensity));
+}
+
+void iAIPathGrid::computeClearance(S32 startX, S32 endX, S32 startY, S32 endY)
+{
+	startX = getMax(startX, 0);
+	endX = getMin(endX, (S32)this->mNodesCountX);
+	startY = getMax(startY, 0);
+	endY = getMin(endY, (S32)this->mNodesCountY);
+	if ((startX >= endX) || (startY >= endY))
+		return;
+
+	// lazy grids haven't cast their links yet, so can't say how wide anything is; leave the nodes open rather than guess
+	if (this->isLazy())
+	{
+		for (S32 iterX = startX; iterX < endX; ++iterX)
+		{
+			for (S32 iterY = startY; iterY < endY; ++iterY)
+				this->mNodeBlock[(iterX * this->mNodesCountY) + iterY].mClearance = IAIPATHGLOBAL_NODE_CLEARANCE_MAX;
+		}
+		return;
+	}
+
+	// an obstruction this far outside the range can still be the closest
+	S32 steps = this->getClearanceSteps();
+	S32 windowStartX = getMax(startX - steps, 0);
+	S32 windowEndX = getMin(endX + steps, (S32)this->mNodesCountX);
+	S32 windowStartY = getMax(startY - steps, 0);
+	S32 windowEndY = getMin(endY + steps, (S32)this->mNodesCountY);
+	S32 windowY = windowEndY - windowStartY;
+
+	F32 straight = 1 / mSqrt(this->mDensity);
+	F32 diagonal = straight * mSqrt(2.0f);
+
+	Vector<F32> distance;
+	distance.setSize((windowEndX - windowStartX) * windowY);
+
+	// seed; blocked positions are obstructions, a missing edge is one half way along it
+	for (S32 iterX = windowStartX; iterX < windowEndX; ++iterX)
+	{
+		for (S32 iterY = windowStartY; iterY < windowEndY; ++iterY)
+		{
+			U32 index = (iterX * this->mNodesCountY) + iterY;
+			F32 &seed = distance[((iterX - windowStartX) * windowY) + (iterY - windowStartY)];
+			seed = IAIPATHGLOBAL_NODE_CLEARANCE_MAX;
+
+			if (!this->mClear[index])
+			{
+				seed = 0.0f;
+				continue;
+			}
+
+			for (U32 dir = 0; dir < iAIPathGrid::DirectionCount; ++dir)
+			{
+				S32 neighbourX = iterX + iAIPathGrid::smDirectionX[dir];
+				S32 neighbourY = iterY + iAIPathGrid::smDirectionY[dir];
+				if ((neighbourX < 0) || (neighbourX >= this->mNodesCountX) || (neighbourY < 0) || (neighbourY >= this->mNodesCountY))
+					continue;
+
+				if (!(this->mEdges[index] & (1 << dir)))
+					seed = getMin(seed, ((dir >= iAIPathGrid::NorthEast) ? diagonal : straight) * 0.5f);
+			}
+		}
+	}
+
+	// chamfer; sweep forwards then backwards, taking the closest obstruction through each neighbour
+	for (S32 x = 0; x < (windowEndX - windowStartX); ++x)
+	{
+		for (S32 y = 0; y < windowY; ++y)
+		{
+			F32 &current = distance[(x * windowY) + y];
+			if (x > 0)
+			{
+				current = getMin(current, distance[((x - 1) * windowY) + y] + straight);
+				if (y > 0)
+					current = getMin(current, distance[((x - 1) * windowY) + y - 1] + diagonal);
+				if (y < (windowY - 1))
+					current = getMin(current, distance[((x - 1) * windowY) + y + 1] + diagonal);
+			}
+			if (y > 0)
+				current = getMin(current, distance[(x * windowY) + y - 1] + straight);
+		}
+	}
+
+	for (S32 x = (windowEndX - windowStartX) - 1; x >= 0; --x)
+	{
+		for (S32 y = windowY - 1; y >= 0; --y)
+		{
+			F32 &current = distance[(x * windowY) + y];
+			if (x < ((windowEndX - windowStartX) - 1))
+			{
+				current = getMin(current, distance[((x + 1) * windowY) + y] + straight);
+				if (y > 0)
+					current = getMin(current, distance[((x + 1) * windowY) + y - 1] + diagonal);
+				if (y < (windowY - 1))
+					current = getMin(current, distance[((x + 1) * windowY) + y + 1] + diagonal);
+			}
+			if (y < (windowY - 1))
+				current = getMin(current, distance[(x * windowY) + y + 1] + straight);
+		}
+	}
+
+	// only the range is known to have seen every obstruction in reach
+	for (S32 iterX = startX; iterX < endX; ++iterX)
+	{
+		for (S32 iterY = startY; iterY < endY; ++iterY)
+		{
+			F32 clearance = distance[((iterX - windowStartX) * windowY) + (iterY - windowStartY)];
+			this->mNodeBlock[(iterX * this->mNodesCountY) + iterY].mClearance = getMin(clearance, IAIPATHGLOBAL_NODE_CLEARANCE_MAX);
+		}
+	}
+}
+
+void iAIPathGrid::sampleTile(void *context, const U32 tile)
+{
+	iAIPathGridBuild *build = static_cast<iAIPathGridBuild*>(context);
+	iAIPathGrid *grid = build->mGrid;
+	TerrainBlock *terrain = build->mTerrain;
+
+	if (build->mCancelled)
+		return;
+
+	// terrain grids are read straight from the heightfield; interiors need their floors probed
+	if (grid->mInteriorGrid)
+	{
+		U32 startX, endX, startY, endY;
+		grid->getTileBounds(tile, startX, endX, startY, endY);
+
+		for (U32 iterX = startX; iterX < endX; ++iterX)
+		{
+			for (U32 iterY = startY; iterY < endY; ++iterY)
+			{
+				grid->sampleNode(terrain, iterX, iterY, &build->mCollision, &build->mRayCount[tile]);
+
+				// floors have no slope or surface to speak of
+				iAIPathNode *node = &grid->mNodeBlock[(iterX * grid->mNodesCountY) + iterY];
+				node->mCost[iAIPathNode::CostWater] = getWaterCost(build->mWaterBoxes, node->mPosition);
+				node->updateMoveModifier();
+			}
+		}
+	} else
+		grid->sampleTerrainTile(build, tile);
+
+	++build->mTileDone[tile];
+}
+
+void iAIPathGrid::sampleTerrainTile(iAIPathGridBuild *build, const U32 tile)
+{
+	TerrainBlock *terrain = build->mTerrain;
+	F32 invSquareSize = 1.0f / (F32)terrain->squareSize;
+
+	U32 startX, endX, startY, endY;
+	this->getTileBounds(tile, startX, endX, startY, endY);
+
+	// heights of the tile and a one node apron around it, so the slope to every neighbour is known here
+	const U32 apronSize = IAIPATHGLOBAL_GRID_BUILD_TILE_SIZE + 2;
+	F32 heights[apronSize * apronSize];
+	F32 slopes[apronSize * apronSize];
+	U8 materials[apronSize * apronSize];
+	bool sampled[apronSize * apronSize];
+
+	S32 apronStartX = (S32)startX - 1;
+	S32 apronStartY = (S32)startY - 1;
+	S32 apronEndX = (S32)endX + 1;
+	S32 apronEndY = (S32)endY + 1;
+
+	for (S32 idX = apronStartX; idX < apronEndX; ++idX)
+	{
+		// walk up the column; the terrain transform is affine, so each node is a fixed step on
+		Point3F column = build->mTerrainOrigin + (build->mTerrainStepX * (F32)idX);
+		U32 apronIndex = (idX - apronStartX) * apronSize;
+
+		for (S32 idY = apronStartY; idY < apronEndY; ++idY, ++apronIndex)
+		{
+			sampled[apronIndex] = false;
+			if ((idX < 0) || (idX >= this->mNodesCountX) || (idY < 0) || (idY >= this->mNodesCountY))
+				continue;
+
+			Point3F terrainPos = column + (build->mTerrainStepY * (F32)idY);
+			sampled[apronIndex] = sampleHeightfield(terrain, invSquareSize, terrainPos.x, terrainPos.y, heights[apronIndex], slopes[apronIndex], materials[apronIndex]);
+		}
+	}
+
+	for (U32 iterX = startX; iterX < endX; ++iterX)
+	{
+		for (U32 iterY = startY; iterY < endY; ++iterY)
+		{
+			U32 index = (iterX * this->mNodesCountY) + iterY;
+			U32 apronIndex = ((iterX - apronStartX) * apronSize) + (iterY - apronStartY);
+
+			// back into the world; only the height wasn't known up front
+			Point3F position = build->mWorldOrigin + (build->mWorldStepX * (F32)iterX) + (build->mWorldStepY * (F32)iterY);
+			if (sampled[apronIndex])
+				position += build->mWorldUp * heights[apronIndex];
+
+			iAIPathNode *node = &this->mNodeBlock[index];
+			node->set(position, this, iterX, iterY);
+
+			// bake the costs while the terrain under the node is at hand
+			node->mCost[iAIPathNode::CostWater] = getWaterCost(build->mWaterBoxes, position);
+			if (sampled[apronIndex])
+			{
+				node->mSurface = materials[apronIndex];
+				node->mCost[iAIPathNode::CostSlope] = slopes[apronIndex] * build->mSlopeScale * IAIPATHGLOBAL_MOVE_MODIFIER_SLOPE;
+				node->mCost[iAIPathNode::CostSurface] = build->mSurfaceCosts[node->mSurface % TerrainBlock::MaterialGroups];
+			}
+			node->updateMoveModifier();
+
+			// node is only usable if over the terrain, not within the avoid list and clear
+			this->mClear[index] = (sampled[apronIndex] && !this->isInAvoidList(node, this->mAvoidList) &&
+								   node->isClear(&build->mCollision, &build->mRayCount[tile]));
+
+			// mark the links which break the max slope, so validating needs no slope checks
+			U8 steep = 0;
+			for (U32 i = 0; i < sizeof(sValidateDirections); ++i)
+			{
+				U32 dir = sValidateDirections[i];
+				S32 offsetX = iAIPathGrid::smDirectionX[dir];
+				S32 offsetY = iAIPathGrid::smDirectionY[dir];
+				U32 neighbourApron = apronIndex + (offsetX * apronSize) + offsetY;
+
+				if (!sampled[apronIndex] || !sampled[neighbourApron])
+				{
+					steep |= (1 << dir);
+					continue;
+				}
+
+				F32 z = (build->mWorldStepX.z * offsetX) + (build->mWorldStepY.z * offsetY) +
+						(build->mWorldUp.z * (heights[neighbourApron] - heights[apronIndex]));
+				if ((z * z) > IAIPATHGLOBAL_MAX_SLOPE)
+					steep |= (1 << dir);
+			}
+			build->mSteep[index] = steep;
+		}
+	}
+}
+
+void iAIPathGrid::validateTile(void *context, const U32 tile)
+{
+	iAIPathGridBuild *build = static_cast<iAIPathGridBuild*>(context);
+	iAIPathGrid *grid = build->mGrid;
+
+	if (build->mCancelled)
+		return;
+
+	U32 startX, endX, startY, endY;
+	grid->getTileBounds(tile, startX, endX, startY, endY);
+
+	for (U32 iterX = startX; iterX < endX; ++iterX)
+	{
+		for (U32 iterY = startY; iterY < endY; ++iterY)
+		{
+			U32 index = (iterX * grid->mNodesCountY) + iterY;
+			grid->mEdges[index] = 0;
+
+			if (!grid->mClear[index])
+				continue;
+
+			iAIPathNode *node = &grid->mNodeBlock[index];
+
+			// check the link to each forward neighbour in the lattice; lazy grids only rule out the steep ones here
+			for (U32 i = 0; i < sizeof(sValidateDirections); ++i)
+			{
+				U32 dir = sValidateDirections[i];
+
+				S32 neighbourX = iterX + iAIPathGrid::smDirectionX[dir];
+				S32 neighbourY = iterY + iAIPathGrid::smDirectionY[dir];
+
+				if ((neighbourX < 0) || (neighbourX >= grid->mNodesCountX) || (neighbourY < 0) || (neighbourY >= grid->mNodesCountY))
+					continue;
+
+				U32 neighbourIndex = (neighbourX * grid->mNodesCountY) + neighbourY;
+				if (!grid->mClear[neighbourIndex])
+					continue;
+
+				// terrain slopes were already checked when the tile was sampled
+				bool valid;
+				if (grid->isLazy())
+					valid = !(build->mSteep[index] & (1 << dir));
+				else if (grid->mInteriorGrid)
+					valid = node->isNeighbourValid(grid->mNodeBlock[neighbourIndex].mPosition, &build->mCollision, &build->mRayCount[tile]);
+				else
+					valid = (!(build->mSteep[index] & (1 << dir)) &&
+							 node->isLinkClear(grid->mNodeBlock[neighbourIndex].mPosition, &build->mCollision, &build->mRayCount[tile]));
+
+				if (valid)
+					grid->mEdges[index] |= (1 << dir);
+			}
+		}
+	}
+
+	++build->mTileDone[tile];
+}
+
+bool iAIPathGrid::createTerrainGrid(const Point3F worldStart, const Point3F worldEnd, Vector<Box3F> &avoidList, const F32 density)
+{
+	PROFILE_SCOPE(iAIPathGrid_createTerrainGrid);
+
+	if (!this->prepareTerrainGrid(worldStart, worldEnd, avoidList, density))
+		return false;
+
+	this->compileGrid();
+	return this->finishGrid();
+}
+
+bool iAIPathGrid::createInteriorGrid(const Box3F &interiorBox, const F32 density)
+{
+	PROFILE_SCOPE(iAIPathGrid_createInteriorGrid);
+
+	// cover the buffer around the interior too, where it is stitched to the terrain grid
+	Vector<Box3F> avoidList;
+	if (!this->prepareTerrainGrid(interiorBox.min - IAIPATHGLOBAL_GRID_BUFFER_INTERIOR, interiorBox.max + IAIPATHGLOBAL_GRID_BUFFER_INTERIOR, avoidList, density))
+		return false;
+
+	// keep the full density throughout
+	this->mInteriorGrid = true;
+	this->mInteriorBox = interiorBox;
+	this->mAdaptiveLevels = 0;
+	this->mOpenSize = 0;
+	this->mEdgeState.clear();
+
+	this->compileGrid();
+	return this->finishGrid();
+}
+
+bool iAIPathGrid::prepareTerrainGrid(const Point3F worldStart, const Point3F worldEnd, Vector<Box3F> &avoidList, const F32 density)
+{
+	PROFILE_SCOPE(iAIPathGrid_prepareTerrainGrid);
+
+	U32 buildStart = Platform::getRealMilliseconds();
+
+	// grab the terrain & ensure valid
+	TerrainBlock *terrain = dynamic_cast<TerrainBlock*>(Sim::findObject("Terrain"));
+	if (!terrain)
+		return false;
+
+	// clear all the nodes
+	this->clearGrid();
+
+	// set the grid start & end bounds
+	this->mGridBox = Box3F(worldStart, worldEnd);
+	
+	// check the gridbox is actually valid
+	if (!this->mGridBox.isValidBox())
+	{
+		Con::errorf("Immersive AI :: Seek :: Grid build failed - grid box not valid!");
+		return false;
+	}
+
+	// the density is nodes per gridsize; default gridSize to 10.0f if none found
+	this->mDensity = density / Con::getFloatVariable("Server::gridSize", 10.0f);
+
+	// calculate the count of nodes in x & y; rounded, so a box a whole number of steps across gets exactly that many
+	this->mNodesCountX = (U32)((this->mGridBox.len_x() * mSqrt(this->mDensity)) + 0.5f);
+	this->mNodesCountY = (U32)((this->mGridBox.len_y() * mSqrt(this->mDensity)) + 0.5f);
+
+	U32 latticeSize = this->mNodesCountX * this->mNodesCountY;
+	if (latticeSize == 0)
+		return false;
+
+	// lattice indexes must fit the low part of the node ids
+	if (latticeSize > (1 << IAIPATHGLOBAL_NODE_ID_LOCAL_BITS))
+	{
+		Con::errorf("Immersive AI :: Seek :: Grid build failed - %d x %d nodes is too many for one grid!", this->mNodesCountX, this->mNodesCountY);
+		return false;
+	}
+
+	// allocate every node up front, the jobs fill them in place
+	this->mNodeBlock = new iAIPathNode[latticeSize];
+
+	iAIPathGridBuild *build = new iAIPathGridBuild;
+	this->mBuild = build;
+
+	build->mGrid = this;
+	build->mTerrain = terrain;
+	build->mStartTime = buildStart;
+	build->mCancelled = false;
+
+	// kept so regions can be rebuilt later
+	this->mAvoidList = avoidList;
+	this->mClear.setSize(latticeSize);
+	this->mEdges.setSize(latticeSize);
+	this->mRegion.setSize(latticeSize);
+	this->mAdaptiveLevels = mClamp(Con::getIntVariable("$iAIPathMap::adaptiveLevels", IAIPATHGLOBAL_GRID_ADAPTIVE_LEVELS), 0, IAIPATHGLOBAL_GRID_ADAPTIVE_MAX_LEVELS);
+	this->mOpenSize = mClamp(Con::getIntVariable("$iAIPathMap::openRegions", IAIPATHGLOBAL_GRID_OPEN_SIZE), 0, IAIPATHGLOBAL_GRID_OPEN_MAX_SIZE);
+
+	// links checked as paths first cross them; merging needs every edge known, so lazy grids keep the full density
+	this->mEdgeState.clear();
+	if (Con::getBoolVariable("$iAIPathMap::lazyEdges", false))
+	{
+		this->mEdgeState.setSize(latticeSize);
+		dMemset(this->mEdgeState.address(), 0, sizeof(U16) * latticeSize);
+		this->mAdaptiveLevels = 0;
+		this->mOpenSize = 0;
+	}
+
+	// snapshot everything static the nodes could collide with, at any height; the objects are
+	// held by pointer while the world ticks between the build's windows, so nothing that moves
+	Box3F collisionArea = this->mGridBox;
+	collisionArea.min.z = -F32_MAX;
+	collisionArea.max.z = F32_MAX;
+	build->mCollision.build(collisionArea, IAIPATHGLOBAL_STATIC_COLLISION_MASK);
+
+	// split the grid into tiles
+	build->mTilesX = (this->mNodesCountX + IAIPATHGLOBAL_GRID_BUILD_TILE_SIZE - 1) / IAIPATHGLOBAL_GRID_BUILD_TILE_SIZE;
+	U32 tilesY = (this->mNodesCountY + IAIPATHGLOBAL_GRID_BUILD_TILE_SIZE - 1) / IAIPATHGLOBAL_GRID_BUILD_TILE_SIZE;
+	build->mTileCount = build->mTilesX * tilesY;
+
+	build->mRayCount.setSize(build->mTileCount);
+	dMemset(build->mRayCount.address(), 0, sizeof(U32) * build->mTileCount);
+	build->mTileDone.setSize(build->mTileCount);
+	dMemset(build->mTileDone.address(), 0, build->mTileCount);
+
+	build->mThreadCount = getMax(Con::getIntVariable("$iAIPathMap::buildThreads", IAIPATHGLOBAL_GRID_BUILD_THREADS), 1);
+
+	// the terrain transform is affine, so work out how a lattice step moves in terrain
+	// space & back once here, rather than transforming every node
+	F32 densityStep = 1 / mSqrt(this->mDensity);
+	const Point3F &scale = terrain->getScale();
+
+	Point3F origin = this->mGridBox.min;
+	Point3F alongX = origin + Point3F(densityStep, 0, 0);
+	Point3F alongY = origin + Point3F(0, densityStep, 0);
+	terrain->getWorldTransform().mulP(origin);
+	terrain->getWorldTransform().mulP(alongX);
+	terrain->getWorldTransform().mulP(alongY);
+	origin.convolveInverse(scale);
+	alongX.convolveInverse(scale);
+	alongY.convolveInverse(scale);
+
+	build->mTerrainOrigin = origin;
+	build->mTerrainStepX = alongX - origin;
+	build->mTerrainStepY = alongY - origin;
+
+	Point3F worldOrigin(origin.x, origin.y, 0);
+	Point3F worldAlongX(alongX.x, alongX.y, 0);
+	Point3F worldAlongY(alongY.x, alongY.y, 0);
+	Point3F worldUp(origin.x, origin.y, 1.0f);
+	worldOrigin.convolve(scale);
+	worldAlongX.convolve(scale);
+	worldAlongY.convolve(scale);
+	worldUp.convolve(scale);
+	terrain->getTransform().mulP(worldOrigin);
+	terrain->getTransform().mulP(worldAlongX);
+	terrain->getTransform().mulP(worldAlongY);
+	terrain->getTransform().mulP(worldUp);
+
+	build->mWorldOrigin = worldOrigin;
+	build->mWorldStepX = worldAlongX - worldOrigin;
+	build->mWorldStepY = worldAlongY - worldOrigin;
+	build->mWorldUp = worldUp - worldOrigin;
+
+	build->mSteep.setSize(latticeSize);
+
+	// everything the costs are baked from, gathered here on the main thread
+	build->mSlopeScale = scale.z / getMax(scale.x, 0.001f);
+	findWaterBoxes(this->mGridBox, build->mWaterBoxes);
+	getSurfaceCosts(terrain, build->mSurfaceCosts);
+
+	return true;
+}
+
+bool iAIPathGrid::compileGrid()
+{
+	// no profiler scopes from here on; the profiler is not thread safe
+
+	iAIPathGridBuild *build = this->mBuild;
+	if (!build)
+		return false;
+
+	U32 latticeSize = this->mNodesCountX * this->mNodesCountY;
+
+	// bake the static objects into voxels, so clearance & link checks needn't cast against them
+	build->mCollision.voxelize(build->mThreadCount);
+
+	// position every node; must finish before any links are checked
+	iAIJobQueue::run(build->mTileCount, iAIPathGrid::sampleTile, build, build->mThreadCount);
+
+	// validate the links of every node
+	iAIJobQueue::run(build->mTileCount, iAIPathGrid::validateTile, build, build->mThreadCount);
+
+	if (build->mCancelled)
+		return false;
+
+	// mirror each validated link back to the neighbour
+	for (U32 index = 0; index < latticeSize; ++index)
+	{
+		for (U32 i = 0; i < sizeof(sValidateDirections); ++i)
+		{
+			U32 dir = sValidateDirections[i];
+			if (!(this->mEdges[index] & (1 << dir)))
+				continue;
+
+			U32 neighbourIndex = index + (iAIPathGrid::smDirectionX[dir] * this->mNodesCountY) + iAIPathGrid::smDirectionY[dir];
+			this->mEdges[neighbourIndex] |= (1 << iAIPathGrid::smDirectionOpposite[dir]);
+		}
+	}
+
+	// how wide an agent can pass through each node
+	this->computeClearance(0, this->mNodesCountX, 0, this->mNodesCountY);
+
+	// merge the open areas, then join all the node neighbours, in lattice order so the result doesn't depend on the threads
+	this->mergeRegions(0, this->mNodesCountX, 0, this->mNodesCountY);
+	this->mLattice.setSize(latticeSize);
+	this->linkNodes(0, this->mNodesCountX, 0, this->mNodesCountY, &build->mCollision);
+	this->collectNodes();
+
+	// total up the build stats
+	for (U32 i = 0; i < build->mTileCount; ++i)
+		this->mBuildRayCount += build->mRayCount[i];
+
+	return true;
+}
+
+bool iAIPathGrid::finishGrid()
+{
+	iAIPathGridBuild *build = this->mBuild;
+	if (!build)
+		return false;
+
+	bool cancelled = build->mCancelled;
+	this->mBuildTime = Platform::getRealMilliseconds() - build->mStartTime;
+
+	// done with the build state
+	delete build;
+	this->mBuild = 0;
+
+	if (cancelled)
+	{
+		this->clearGrid();
+		return false;
+	}
+
+	// set as compiled if any nodes in the grid
+	this->mCompiled = (this->mNodes.size() > 0);
+
+	// update the world box so renders properly
+	this->updateWorldBox();
+
+	return this->mCompiled;
+}
+
+void iAIPathGrid::cancelBuild()
+{
+	if (this->mBuild)
+		this->mBuild->mCancelled = true;
+}
+
+F32 iAIPathGrid::getBuildProgress()
+{
+	if (!this->mBuild)
+		return this->mCompiled ? 1.0f : 0.0f;
+
+	// every tile is sampled then validated
+	U32 jobsDone = 0;
+	for (U32 i = 0; i < this->mBuild->mTileCount; ++i)
+		jobsDone += this->mBuild->mTileDone[i];
+
+	return (F32)jobsDone / (F32)getMax(this->mBuild->mTileCount * 2, (U32)1);
+}
+
+iAIPathCollision* iAIPathGrid::getBuildCollision()
+{
+	return this->mBuild ? &this->mBuild->mCollision : 0;
+}
+
+bool iAIPathGrid::isRegionMergeable(const S32 anchorX, const S32 anchorY, const S32 sizeX, const S32 sizeY)
+{
+	if (((anchorX + sizeX) > this->mNodesCountX) || ((anchorY + sizeY) > this->mNodesCountY))
+		return false;
+
+	// heights of the corners, for the surface the region must follow
+	S32 endX = anchorX + sizeX - 1;
+	S32 endY = anchorY + sizeY - 1;
+	F32 height00 = this->mNodeBlock[(anchorX * this->mNodesCountY) + anchorY].mPosition.z;
+	F32 height10 = this->mNodeBlock[(endX * this->mNodesCountY) + anchorY].mPosition.z;
+	F32 height01 = this->mNodeBlock[(anchorX * this->mNodesCountY) + endY].mPosition.z;
+	F32 height11 = this->mNodeBlock[(endX * this->mNodesCountY) + endY].mPosition.z;
+	F32 moveModifier = this->mNodeBlock[(anchorX * this->mNodesCountY) + anchorY].mMoveModifier;
+	U8 surface = this->mNodeBlock[(anchorX * this->mNodesCountY) + anchorY].mSurface;
+
+	for (S32 iterX = anchorX; iterX <= endX; ++iterX)
+	{
+		for (S32 iterY = anchorY; iterY <= endY; ++iterY)
+		{
+			U32 index = (iterX * this->mNodesCountY) + iterY;
+			iAIPathNode *node = &this->mNodeBlock[index];
+
+			// every position must be free, costing about the same
+			if (!this->mClear[index] || (this->mRegion[index] != index) || (node->mSpanX > 1) || (node->mSpanY > 1) ||
+				(node->mSurface != surface) || (mFabs(node->mMoveModifier - moveModifier) > IAIPATHGLOBAL_GRID_ADAPTIVE_COST_RANGE))
+				return false;
+
+			// every lattice edge within the region must be valid
+			for (U32 dir = 0; dir < iAIPathGrid::DirectionCount; ++dir)
+			{
+				S32 neighbourX = iterX + iAIPathGrid::smDirectionX[dir];
+				S32 neighbourY = iterY + iAIPathGrid::smDirectionY[dir];
+
+				if ((neighbourX >= anchorX) && (neighbourX <= endX) && (neighbourY >= anchorY) && (neighbourY <= endY) && !(this->mEdges[index] & (1 << dir)))
+					return false;
+			}
+
+			// must lie close to the surface through the corners
+			F32 u = (sizeX > 1) ? ((F32)(iterX - anchorX) / (F32)(sizeX - 1)) : 0.0f;
+			F32 v = (sizeY > 1) ? ((F32)(iterY - anchorY) / (F32)(sizeY - 1)) : 0.0f;
+			F32 height = (height00 * (1 - u) * (1 - v)) + (height10 * u * (1 - v)) + (height01 * (1 - u) * v) + (height11 * u * v);
+			if (mFabs(node->mPosition.z - height) > IAIPATHGLOBAL_GRID_ADAPTIVE_FLATNESS)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+bool iAIPathGrid::isRangeOpen(const S32 startX, const S32 endX, const S32 startY, const S32 endY, const U8 surface, const F32 moveModifier)
+{
+	for (S32 iterX = startX; iterX < endX; ++iterX)
+	{
+		for (S32 iterY = startY; iterY < endY; ++iterY)
+		{
+			U32 index = (iterX * this->mNodesCountY) + iterY;
+			iAIPathNode *node = &this->mNodeBlock[index];
+
+			if (!this->mClear[index] || (this->mRegion[index] != index) || (node->mSpanX > 1) || (node->mSpanY > 1) ||
+				(node->mSurface != surface) || (mFabs(node->mMoveModifier - moveModifier) > IAIPATHGLOBAL_GRID_ADAPTIVE_COST_RANGE))
+				return false;
+
+			// linked every way it can be; nothing nearby to steer around
+			for (U32 dir = 0; dir < iAIPathGrid::DirectionCount; ++dir)
+			{
+				S32 neighbourX = iterX + iAIPathGrid::smDirectionX[dir];
+				S32 neighbourY = iterY + iAIPathGrid::smDirectionY[dir];
+
+				if ((neighbourX >= 0) && (neighbourX < (S32)this->mNodesCountX) && (neighbourY >= 0) && (neighbourY < (S32)this->mNodesCountY) &&
+					!(this->mEdges[index] & (1 << dir)))
+					return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void iAIPathGrid::mergeOpenRegions(const S32 startX, const S32 endX, const S32 startY, const S32 endY)
+{
+	S32 maxSize = this->mOpenSize;
+	S32 adaptiveSize = 1 << this->mAdaptiveLevels;
+	if (maxSize <= adaptiveSize)
+		return;
+
+	for (S32 anchorX = startX; anchorX < endX; ++anchorX)
+	{
+		for (S32 anchorY = startY; anchorY < endY; ++anchorY)
+		{
+			U32 index = (anchorX * this->mNodesCountY) + anchorY;
+			iAIPathNode *anchor = &this->mNodeBlock[index];
+			if (!this->isNodeKept(index) || !this->isRangeOpen(anchorX, anchorX + 1, anchorY, anchorY + 1, anchor->mSurface, anchor->mMoveModifier))
+				continue;
+
+			// every position is fully linked, so only the row or column being added needs checking
+			S32 sizeX = 1;
+			S32 sizeY = 1;
+			bool grown = true;
+			while (grown)
+			{
+				grown = false;
+				if ((sizeX < maxSize) && ((anchorX + sizeX) < endX) &&
+					this->isRangeOpen(anchorX + sizeX, anchorX + sizeX + 1, anchorY, anchorY + sizeY, anchor->mSurface, anchor->mMoveModifier))
+				{
+					++sizeX;
+					grown = true;
+				}
+				if ((sizeY < maxSize) && ((anchorY + sizeY) < endY) &&
+					this->isRangeOpen(anchorX, anchorX + sizeX, anchorY + sizeY, anchorY + sizeY + 1, anchor->mSurface, anchor->mMoveModifier))
+				{
+					++sizeY;
+					grown = true;
+				}
+			}
+
+			// leave anything an adaptive region could cover to the adaptive merge, which keeps to even ground
+			if ((sizeX <= adaptiveSize) && (sizeY <= adaptiveSize))
+				continue;
+
+			U32 regionIndex = ((anchorX + (sizeX / 2)) * this->mNodesCountY) + anchorY + (sizeY / 2);
+			for (S32 iterX = anchorX; iterX < (anchorX + sizeX); ++iterX)
+			{
+				for (S32 iterY = anchorY; iterY < (anchorY + sizeY); ++iterY)
+					this->mRegion[(iterX * this->mNodesCountY) + iterY] = regionIndex;
+			}
+
+			this->mNodeBlock[regionIndex].mSpanX = sizeX;
+			this->mNodeBlock[regionIndex].mSpanY = sizeY;
+		}
+	}
+}
+
+void iAIPathGrid::mergeRegions(const S32 startX, const S32 endX, const S32 startY, const S32 endY)
+{
+	for (S32 iterX = startX; iterX < endX; ++iterX)
+	{
+		for (S32 iterY = startY; iterY < endY; ++iterY)
+		{
+			U32 index = (iterX * this->mNodesCountY) + iterY;
+			this->mRegion[index] = index;
+			this->mNodeBlock[index].mSpanX = 1;
+			this->mNodeBlock[index].mSpanY = 1;
+		}
+	}
+
+	// the wide open areas first, so the adaptive regions fill in around them
+	this->mergeOpenRegions(startX, endX, startY, endY);
+
+	S32 maxSize = 1 << this->mAdaptiveLevels;
+	if (maxSize <= 1)
+		return;
+
+	// grow a rectangle from each free position in turn, a column then a row at a time, so it stays near square
+	for (S32 anchorX = startX; anchorX < endX; ++anchorX)
+	{
+		for (S32 anchorY = startY; anchorY < endY; ++anchorY)
+		{
+			U32 index = (anchorX * this->mNodesCountY) + anchorY;
+			if (!this->isNodeKept(index) || (this->mRegion[index] != index) || (this->mNodeBlock[index].mSpanX > 1) || (this->mNodeBlock[index].mSpanY > 1))
+				continue;
+
+			S32 sizeX = 1;
+			S32 sizeY = 1;
+			bool grown = true;
+			while (grown)
+			{
+				grown = false;
+				if ((sizeX < maxSize) && ((anchorX + sizeX) < endX) && this->isRegionMergeable(anchorX, anchorY, sizeX + 1, sizeY))
+				{
+					++sizeX;
+					grown = true;
+				}
+				if ((sizeY < maxSize) && ((anchorY + sizeY) < endY) && this->isRegionMergeable(anchorX, anchorY, sizeX, sizeY + 1))
+				{
+					++sizeY;
+					grown = true;
+				}
+			}
+
+			if ((sizeX == 1) && (sizeY == 1))
+				continue;
+
+			// the position just past the middle stands for the region
+			U32 regionIndex = ((anchorX + (sizeX / 2)) * this->mNodesCountY) + anchorY + (sizeY / 2);
+			for (S32 iterX = anchorX; iterX < (anchorX + sizeX); ++iterX)
+			{
+				for (S32 iterY = anchorY; iterY < (anchorY + sizeY); ++iterY)
+					this->mRegion[(iterX * this->mNodesCountY) + iterY] = regionIndex;
+			}
+
+			this->mNodeBlock[regionIndex].mSpanX = sizeX;
+			this->mNodeBlock[regionIndex].mSpanY = sizeY;
+		}
+	}
+}
+
+void iAIPathGrid::expandToRegions(S32 &startX, S32 &endX, S32 &startY, S32 &endY)
+{
+	startX = getMax(startX, 0);
+	endX = getMin(endX, (S32)this->mNodesCountX);
+	startY = getMax(startY, 0);
+	endY = getMin(endY, (S32)this->mNodesCountY);
+
+	// only the regions along the border can reach outside; taking one in can reach another
+	bool grown = true;
+	while (grown && (startX < endX) && (startY < endY))
+	{
+		grown = false;
+		S32 newStartX = startX;
+		S32 newEndX = endX;
+		S32 newStartY = startY;
+		S32 newEndY = endY;
+
+		for (S32 iterX = startX; iterX < endX; ++iterX)
+		{
+			for (S32 iterY = startY; iterY < endY; ++iterY)
+			{
+				if ((iterX != startX) && (iterX != (endX - 1)) && (iterY != startY) && (iterY != (endY - 1)))
+					continue;
+
+				U32 regionIndex = this->getRegionIndex(iterX, iterY);
+				const iAIPathNode *region = &this->mNodeBlock[regionIndex];
+				S32 regionStartX = (regionIndex / this->mNodesCountY) - (region->mSpanX / 2);
+				S32 regionStartY = (regionIndex % this->mNodesCountY) - (region->mSpanY / 2);
+
+				newStartX = getMin(newStartX, regionStartX);
+				newEndX = getMax(newEndX, regionStartX + (S32)region->mSpanX);
+				newStartY = getMin(newStartY, regionStartY);
+				newEndY = getMax(newEndY, regionStartY + (S32)region->mSpanY);
+			}
+		}
+
+		grown = (newStartX != startX) || (newEndX != endX) || (newStartY != startY) || (newEndY != endY);
+		startX = newStartX;
+		endX = newEndX;
+		startY = newStartY;
+		endY = newEndY;
+	}
+}
+
+void iAIPathGrid::linkNodes(const S32 startX, const S32 endX, const S32 startY, const S32 endY, const iAIPathCollision *collision)
+{
+	for (S32 iterX = startX; iterX < endX; ++iterX)
+	{
+		for (S32 iterY = startY; iterY < endY; ++iterY)
+		{
+			U32 index = (iterX * this->mNodesCountY) + iterY;
+			this->mNodeBlock[index].mNeighbours.clear();
+			this->mLattice[index] = 0;
+		}
+	}
+
+	for (S32 iterX = startX; iterX < endX; ++iterX)
+	{
+		for (S32 iterY = startY; iterY < endY; ++iterY)
+		{
+			U32 index = (iterX * this->mNodesCountY) + iterY;
+			if (!this->isNodeKept(index))
+				continue;
+
+			U32 leafIndex = this->getRegionIndex(iterX, iterY);
+			iAIPathNode *leaf = &this->mNodeBlock[leafIndex];
+
+			// link to the node standing for every neighbour with a valid edge which is also kept
+			for (U32 dir = 0; dir < iAIPathGrid::DirectionCount; ++dir)
+			{
+				if (!(this->mEdges[index] & (1 << dir)))
+					continue;
+
+				S32 neighbourX = iterX + iAIPathGrid::smDirectionX[dir];
+				S32 neighbourY = iterY + iAIPathGrid::smDirectionY[dir];
+				U32 neighbourIndex = (neighbourX * this->mNodesCountY) + neighbourY;
+				if (!this->isNodeKept(neighbourIndex))
+					continue;
+
+				U32 neighbourLeafIndex = this->getRegionIndex(neighbourX, neighbourY);
+				iAIPathNode *neighbour = &this->mNodeBlock[neighbourLeafIndex];
+				if ((neighbourLeafIndex == leafIndex) || leaf->hasNeighbour(neighbour))
+					continue;
+
+				// links to a merged region are longer than the lattice edge, so must be clear too
+				if (((leaf->mSpanX * leaf->mSpanY) > 1 || (neighbour->mSpanX * neighbour->mSpanY) > 1) &&
+					iAIPathNode::castRay(leaf->mPosition + Point3F(0, 0, IAIPATHGLOBAL_NODE_CLEARANCE.z), neighbour->mPosition + Point3F(0, 0, IAIPATHGLOBAL_NODE_CLEARANCE.z), collision, &this->mBuildRayCount, 0, IAIPATHGLOBAL_STATIC_COLLISION_MASK))
+					continue;
+
+				leaf->mNeighbours.push_back(neighbour);
+			}
+		}
+	}
+
+	// cull nodes left alone
+	for (S32 iterX = startX; iterX < endX; ++iterX)
+	{
+		for (S32 iterY = startY; iterY < endY; ++iterY)
+		{
+			U32 index = (iterX * this->mNodesCountY) + iterY;
+			iAIPathNode *leaf = &this->mNodeBlock[this->getRegionIndex(iterX, iterY)];
+
+			if (this->isNodeKept(index) && (leaf->mNeighbours.size() > 0))
+				this->mLattice[index] = leaf;
+		}
+	}
+}
+
+void iAIPathGrid::collectNodes()
+{
+	// merged regions fill many lattice slots, only take the node standing for them
+	this->mNodes.clear();
+	for (U32 index = 0; index < this->mLattice.size(); ++index)
+	{
+		if (this->mLattice[index] == &this->mNodeBlock[index])
+			this->mNodes.push_back(this->mLattice[index]);
+	}
+}
+
+bool iAIPathGrid::rebuildRegion(const Box3F &region, Box3F &affectedBox)
+{
+	PROFILE_SCOPE(iAIPathGrid_rebuildRegion);
+
+	if (!this->mNodeBlock || this->mBuild)
+		return false;
+
+	TerrainBlock *terrain = dynamic_cast<TerrainBlock*>(Sim::findObject("Terrain"));
+	if (!terrain)
+		return false;
+
+	F32 densityStep = 1 / mSqrt(this->mDensity);
+
+	// lattice range covering the region, plus the border nodes whose links cross into it
+	S32 startX = getMax((S32)mFloor((region.min.x - this->mGridBox.min.x) / densityStep) - 1, 0);
+	S32 endX = getMin((S32)mCeil((region.max.x - this->mGridBox.min.x) / densityStep) + 2, (S32)this->mNodesCountX);
+	S32 startY = getMax((S32)mFloor((region.min.y - this->mGridBox.min.y) / densityStep) - 1, 0);
+	S32 endY = getMin((S32)mCeil((region.max.y - this->mGridBox.min.y) / densityStep) + 2, (S32)this->mNodesCountY);
+
+	if ((startX >= endX) || (startY >= endY))
+		return false;
+
+	Vector<Box3F> waterBoxes;
+	F32 surfaceCosts[TerrainBlock::MaterialGroups];
+	findWaterBoxes(this->mGridBox, waterBoxes);
+	getSurfaceCosts(terrain, surfaceCosts);
+
+	// re-sample the nodes, casting straight against the static objects in the container
+	for (S32 iterX = startX; iterX < endX; ++iterX)
+	{
+		for (S32 iterY = startY; iterY < endY; ++iterY)
+		{
+			this->sampleNode(terrain, iterX, iterY, 0, &this->mBuildRayCount);
+			this->bakeNode(terrain, &this->mNodeBlock[(iterX * this->mNodesCountY) + iterY], waterBoxes, surfaceCosts);
+		}
+	}
+
+	// re-validate every edge with an end in the range, once per edge
+	for (S32 iterX = startX; iterX < endX; ++iterX)
+	{
+		for (S32 iterY = startY; iterY < endY; ++iterY)
+		{
+			U32 index = (iterX * this->mNodesCountY) + iterY;
+
+			for (U32 dir = 0; dir < iAIPathGrid::DirectionCount; ++dir)
+			{
+				S32 neighbourX = iterX + iAIPathGrid::smDirectionX[dir];
+				S32 neighbourY = iterY + iAIPathGrid::smDirectionY[dir];
+
+				if ((neighbourX < 0) || (neighbourX >= this->mNodesCountX) || (neighbourY < 0) || (neighbourY >= this->mNodesCountY))
+					continue;
+
+				// edges inside the range are checked from one end only
+				bool neighbourInRange = (neighbourX >= startX) && (neighbourX < endX) && (neighbourY >= startY) && (neighbourY < endY);
+				if (neighbourInRange && !isValidateDirection(dir))
+					continue;
+
+				U32 neighbourIndex = (neighbourX * this->mNodesCountY) + neighbourY;
+				U8 opposite = iAIPathGrid::smDirectionOpposite[dir];
+
+				bool valid = this->mClear[index] && this->mClear[neighbourIndex] &&
+							 this->mNodeBlock[index].isNeighbourValid(this->mNodeBlock[neighbourIndex].mPosition, 0, &this->mBuildRayCount, IAIPATHGLOBAL_STATIC_COLLISION_MASK);
+
+				if (this->isLazy())
+					this->setEdgeState(index, dir, valid ? iAIPathGrid::EdgeValid : iAIPathGrid::EdgeInvalid);
+
+				if (valid)
+				{
+					this->mEdges[index] |= (1 << dir);
+					this->mEdges[neighbourIndex] |= (1 << opposite);
+				} else
+				{
+					this->mEdges[index] &= ~(1 << dir);
+					this->mEdges[neighbourIndex] &= ~(1 << opposite);
+				}
+			}
+		}
+	}
+
+	// obstructions reach the clearance of nodes some way out
+	S32 clearanceSteps = this->getClearanceSteps();
+	this->computeClearance(startX - clearanceSteps, endX + clearanceSteps, startY - clearanceSteps, endY + clearanceSteps);
+
+	// whether a node is kept depends on its neighbours' edges, so re-merge a further ring, out to whole regions
+	S32 mergeStartX = startX - 2;
+	S32 mergeEndX = endX + 2;
+	S32 mergeStartY = startY - 2;
+	S32 mergeEndY = endY + 2;
+	this->expandToRegions(mergeStartX, mergeEndX, mergeStartY, mergeEndY);
+	this->mergeRegions(mergeStartX, mergeEndX, mergeStartY, mergeEndY);
+
+	// regions next to a re-merged region link to it, so relink every region touching the range too
+	S32 linkStartX = mergeStartX - 1;
+	S32 linkEndX = mergeEndX + 1;
+	S32 linkStartY = mergeStartY - 1;
+	S32 linkEndY = mergeEndY + 1;
+	this->expandToRegions(linkStartX, linkEndX, linkStartY, linkEndY);
+	this->linkNodes(linkStartX, linkEndX, linkStartY, linkEndY);
+	this->collectNodes();
+
+	// world area where links may have changed
+	affectedBox.min = this->mGridBox.min + Point3F(linkStartX * densityStep, linkStartY * densityStep, 0);
+	affectedBox.max = this->mGridBox.min + Point3F((linkEndX - 1) * densityStep, (linkEndY - 1) * densityStep, 0);
+	affectedBox.min.z = -F32_MAX;
+	affectedBox.max.z = F32_MAX;
+
+	this->mCompiled = (this->mNodes.size() > 0);
+	this->updateWorldBox();
+
+	return true;
+}
+
+void iAIPathGrid::restoreLatticeState()
+{
+	U32 latticeSize = this->mNodesCountX * this->mNodesCountY;
+	this->mClear.setSize(latticeSize);
+	this->mEdges.setSize(latticeSize);
+	this->mRegion.setSize(latticeSize);
+	dMemset(this->mClear.address(), 0, latticeSize);
+	dMemset(this->mEdges.address(), 0, latticeSize);
+	for (U32 index = 0; index < latticeSize; ++index)
+		this->mRegion[index] = index;
+
+	// nodes hidden in merged regions go back on the terrain
+	TerrainBlock *terrain = dynamic_cast<TerrainBlock*>(Sim::findObject("Terrain"));
+
+	Vector<Box3F> waterBoxes;
+	F32 surfaceCosts[TerrainBlock::MaterialGroups];
+	if (terrain)
+	{
+		findWaterBoxes(this->mGridBox, waterBoxes);
+		getSurfaceCosts(terrain, surfaceCosts);
+	}
+
+	// only the kept nodes and their links are known; every lattice edge within a merged region was valid
+	for (U32 i = 0; i < this->mNodes.size(); ++i)
+	{
+		iAIPathNode *node = this->mNodes[i];
+		U32 leafIndex = (node->mIdX * this->mNodesCountY) + node->mIdY;
+		S32 anchorX = node->mIdX - (node->mSpanX / 2);
+		S32 anchorY = node->mIdY - (node->mSpanY / 2);
+
+		for (S32 iterX = anchorX; iterX < (anchorX + node->mSpanX); ++iterX)
+		{
+			for (S32 iterY = anchorY; iterY < (anchorY + node->mSpanY); ++iterY)
+			{
+				U32 index = (iterX * this->mNodesCountY) + iterY;
+				this->mClear[index] = true;
+				this->mRegion[index] = leafIndex;
+				this->mLattice[index] = node;
+
+				if (index != leafIndex)
+				{
+					this->mNodeBlock[index].set(terrain ? this->placeNode(terrain, iterX, iterY) : node->mPosition, this, iterX, iterY);
+					if (terrain)
+						this->bakeNode(terrain, &this->mNodeBlock[index], waterBoxes, surfaceCosts);
+					else
+					{
+						dMemcpy(this->mNodeBlock[index].mCost, node->mCost, sizeof(node->mCost));
+						this->mNodeBlock[index].mSurface = node->mSurface;
+						this->mNodeBlock[index].updateMoveModifier();
+					}
+				}
+
+				for (U32 dir = 0; dir < iAIPathGrid::DirectionCount; ++dir)
+				{
+					S32 neighbourX = iterX + iAIPathGrid::smDirectionX[dir];
+					S32 neighbourY = iterY + iAIPathGrid::smDirectionY[dir];
+					if ((neighbourX >= anchorX) && (neighbourX < (anchorX + node->mSpanX)) && (neighbourY >= anchorY) && (neighbourY < (anchorY + node->mSpanY)))
+						this->mEdges[index] |= (1 << dir);
+				}
+			}
+		}
+	}
+
+	// links between nodes stand for every lattice edge between them
+	for (U32 i = 0; i < this->mNodes.size(); ++i)
+	{
+		iAIPathNode *node = this->mNodes[i];
+		S32 anchorX = node->mIdX - (node->mSpanX / 2);
+		S32 anchorY = node->mIdY - (node->mSpanY / 2);
+
+		for (U32 j = 0; j < node->mNeighbours.size(); ++j)
+		{
+			iAIPathNode *neighbour = node->mNeighbours[j];
+			if (neighbour->mParentGrid != this)
+				continue;
+
+			U32 neighbourLeafIndex = (neighbour->mIdX * this->mNodesCountY) + neighbour->mIdY;
+
+			for (S32 iterX = anchorX; iterX < (anchorX + node->mSpanX); ++iterX)
+			{
+				for (S32 iterY = anchorY; iterY < (anchorY + node->mSpanY); ++iterY)
+				{
+					U32 index = (iterX * this->mNodesCountY) + iterY;
+
+					for (U32 dir = 0; dir < iAIPathGrid::DirectionCount; ++dir)
+					{
+						S32 neighbourX = iterX + iAIPathGrid::smDirectionX[dir];
+						S32 neighbourY = iterY + iAIPathGrid::smDirectionY[dir];
+
+						if ((neighbourX < 0) || (neighbourX >= this->mNodesCountX) || (neighbourY < 0) || (neighbourY >= this->mNodesCountY))
+							continue;
+
+						if (this->getRegionIndex(neighbourX, neighbourY) != neighbourLeafIndex)
+							continue;
+
+						this->mEdges[index] |= (1 << dir);
+						this->mEdges[(neighbourX * this->mNodesCountY) + neighbourY] |= (1 << iAIPathGrid::smDirectionOpposite[dir]);
+					}
+				}
+			}
+		}
+	}
+
+	// the hidden nodes' clearance comes from the masks, the kept nodes keep what was saved with them
+	Vector<F32> keptClearance;
+	keptClearance.setSize(this->mNodes.size());
+	for (U32 i = 0; i < this->mNodes.size(); ++i)
+		keptClearance[i] = this->mNodes[i]->mClearance;
+
+	this->computeClearance(0, this->mNodesCountX, 0, this->mNodesCountY);
+
+	for (U32 i = 0; i < this->mNodes.size(); ++i)
+		this->mNodes[i]->mClearance = keptClearance[i];
+}
+
+iAIPathNode* iAIPathGrid::getLatticeNode(const S32 idX, const S32 idY)
+{
+	if ((idX < 0) || (idX >= this->mNodesCountX) || (idY < 0) || (idY >= this->mNodesCountY) || (this->mLattice.size() == 0))
+		return 0;
+
+	return this->mLattice[(idX * this->mNodesCountY) + idY];
+}
+
+void iAIPathGrid::setEdgeState(const U32 index, const U32 dir, const U32 state)
+{
+	U32 neighbourIndex = index + (iAIPathGrid::smDirectionX[dir] * this->mNodesCountY) + iAIPathGrid::smDirectionY[dir];
+	U32 opposite = iAIPathGrid::smDirectionOpposite[dir];
+
+	this->mEdgeState[index] = (this->mEdgeState[index] & ~(EdgeStateMask << (dir * 2))) | (state << (dir * 2));
+	this->mEdgeState[neighbourIndex] = (this->mEdgeState[neighbourIndex] & ~(EdgeStateMask << (opposite * 2))) | (state << (opposite * 2));
+}
+
+bool iAIPathGrid::isLinkValid(iAIPathNode *from, iAIPathNode *to, U32 *validateCount)
+{
+	// links between grids were validated when stitched
+	iAIPathGrid *grid = from->mParentGrid;
+	if (!grid || !grid->isLazy() || (to->mParentGrid != grid))
+		return true;
+
+	S32 offsetX = (S32)to->mIdX - (S32)from->mIdX;
+	S32 offsetY = (S32)to->mIdY - (S32)from->mIdY;
+	U32 dir = 0;
+	while ((dir < iAIPathGrid::DirectionCount) && ((iAIPathGrid::smDirectionX[dir] != offsetX) || (iAIPathGrid::smDirectionY[dir] != offsetY)))
+		++dir;
+
+	if (dir == iAIPathGrid::DirectionCount)
+		return true;
+
+	U32 index = grid->getLatticeIndex(from);
+	U32 state = grid->getEdgeState(index, dir);
+	if (state == EdgeUnknown)
+	{
+		// the slope was checked at build; the result is kept, so only cast against what won't move
+		state = from->isLinkClear(to->mPosition, 0, &grid->mBuildRayCount, IAIPATHGLOBAL_STATIC_COLLISION_MASK) ? EdgeValid : EdgeInvalid;
+		grid->setEdgeState(index, dir, state);
+
+		if (validateCount)
+			++(*validateCount);
+	}
+
+	return (state == EdgeValid);
+}
+
+bool iAIPathGrid::getPortal(const iAIPathNode *from, const iAIPathNode *to, const F32 radius, Point3F &left, Point3F &right)
+{
+	if ((from->mParentGrid != this) || (to->mParentGrid != this) || (this->mEdges.size() == 0))
+		return false;
+
+	U32 toIndex = (to->mIdX * this->mNodesCountY) + to->mIdY;
+
+	// lattice rectangles of both regions, ends inclusive
+	S32 fromStartX = from->mIdX - (from->mSpanX / 2);
+	S32 fromEndX = fromStartX + from->mSpanX - 1;
+	S32 fromStartY = from->mIdY - (from->mSpanY / 2);
+	S32 fromEndY = fromStartY + from->mSpanY - 1;
+	S32 toStartX = to->mIdX - (to->mSpanX / 2);
+	S32 toEndX = toStartX + to->mSpanX - 1;
+	S32 toStartY = to->mIdY - (to->mSpanY / 2);
+	S32 toEndY = toStartY + to->mSpanY - 1;
+
+	// which side of the from region the to region is on, and the positions they share along it
+	U32 dir;
+	S32 borderX, borderY, alongX, alongY, overlapStart, overlapEnd;
+	if ((toStartX == (fromEndX + 1)) || (toEndX == (fromStartX - 1)))
+	{
+		dir = (toStartX > fromEndX) ? iAIPathGrid::East : iAIPathGrid::West;
+		borderX = (dir == iAIPathGrid::East) ? fromEndX : fromStartX;
+		borderY = 0;
+		alongX = 0;
+		alongY = 1;
+		overlapStart = getMax(fromStartY, toStartY);
+		overlapEnd = getMin(fromEndY, toEndY);
+	} else if ((toStartY == (fromEndY + 1)) || (toEndY == (fromStartY - 1)))
+	{
+		dir = (toStartY > fromEndY) ? iAIPathGrid::North : iAIPathGrid::South;
+		borderX = 0;
+		borderY = (dir == iAIPathGrid::North) ? fromEndY : fromStartY;
+		alongX = 1;
+		alongY = 0;
+		overlapStart = getMax(fromStartX, toStartX);
+		overlapEnd = getMin(fromEndX, toEndX);
+	} else
+		return false;
+
+	// longest run of valid edges straight across the border
+	S32 runStart = 0;
+	S32 runEnd = -1;
+	S32 currentStart = overlapStart;
+	for (S32 along = overlapStart; along <= overlapEnd; ++along)
+	{
+		U32 index = ((borderX + (alongX * along)) * this->mNodesCountY) + borderY + (alongY * along);
+		if (!(this->mEdges[index] & (1 << dir)))
+		{
+			currentStart = along + 1;
+			continue;
+		}
+
+		if ((along - currentStart) > (runEnd - runStart))
+		{
+			runStart = currentStart;
+			runEnd = along;
+		}
+	}
+
+	// regions touching only at a corner cross on the diagonal between them
+	if (runEnd < runStart)
+	{
+		S32 cornerX = (toStartX > fromEndX) ? fromEndX : fromStartX;
+		S32 cornerY = (toStartY > fromEndY) ? fromEndY : fromStartY;
+		S32 stepX = (toStartX > fromEndX) ? 1 : -1;
+		S32 stepY = (toStartY > fromEndY) ? 1 : -1;
+		S32 neighbourX = cornerX + stepX;
+		S32 neighbourY = cornerY + stepY;
+		if ((neighbourX < 0) || (neighbourX >= this->mNodesCountX) || (neighbourY < 0) || (neighbourY >= this->mNodesCountY) ||
+			(this->getRegionIndex(neighbourX, neighbourY) != toIndex))
+			return false;
+
+		U32 cornerDir = 0;
+		while ((iAIPathGrid::smDirectionX[cornerDir] != stepX) || (iAIPathGrid::smDirectionY[cornerDir] != stepY))
+			++cornerDir;
+
+		U32 cornerIndex = (cornerX * this->mNodesCountY) + cornerY;
+		if (!(this->mEdges[cornerIndex] & (1 << cornerDir)))
+			return false;
+
+		left = (this->mNodeBlock[cornerIndex].mPosition + this->mNodeBlock[(neighbourX * this->mNodesCountY) + neighbourY].mPosition) * 0.5f;
+		right = left;
+		return true;
+	}
+
+	// the ends of the run, half way across each edge
+	S32 stepX = iAIPathGrid::smDirectionX[dir];
+	S32 stepY = iAIPathGrid::smDirectionY[dir];
+	const iAIPathNode *startNode = &this->mNodeBlock[((borderX + (alongX * runStart)) * this->mNodesCountY) + borderY + (alongY * runStart)];
+	const iAIPathNode *startAcross = &this->mNodeBlock[((borderX + (alongX * runStart) + stepX) * this->mNodesCountY) + borderY + (alongY * runStart) + stepY];
+	const iAIPathNode *endNode = &this->mNodeBlock[((borderX + (alongX * runEnd)) * this->mNodesCountY) + borderY + (alongY * runEnd)];
+	const iAIPathNode *endAcross = &this->mNodeBlock[((borderX + (alongX * runEnd) + stepX) * this->mNodesCountY) + borderY + (alongY * runEnd) + stepY];
+	Point3F start = (startNode->mPosition + startAcross->mPosition) * 0.5f;
+	Point3F end = (endNode->mPosition + endAcross->mPosition) * 0.5f;
+
+	// the open ground reaches past the ends by the clearance there, up to half a step; the agent needs its radius of it
+	F32 halfStep = this->getDensityStep() * 0.5f;
+	F32 startWiden = getMin(getMin(startNode->mClearance, startAcross->mClearance), halfStep) - radius;
+	F32 endWiden = getMin(getMin(endNode->mClearance, endAcross->mClearance), halfStep) - radius;
+
+	F32 length = (F32)(runEnd - runStart) * this->getDensityStep();
+	F32 startT = -startWiden;
+	F32 endT = length + endWiden;
+	if (startT > endT)
+	{
+		startT = (startT + endT) * 0.5f;
+		endT = startT;
+	}
+
+	Point3F along((F32)alongX, (F32)alongY, 0.0f);
+	Point3F slope = (length > 0.0f) ? ((end - start) / length) : along;
+	Point3F low = start + (slope * startT);
+	Point3F high = start + (slope * endT);
+
+	// facing across the border, the end further along X or Y is on the left when crossing east or south
+	bool highOnLeft = ((stepX * alongY) - (stepY * alongX)) > 0;
+	left = highOnLeft ? high : low;
+	right = highOnLeft ? low : high;
+
+	return true;
+}
+
+bool iAIPathGrid::isInAvoidList(const iAIPathNode *node, const Vector<Box3F> &avoidList)
+{
+	// iterate over all boxes in the avoid list
+	for (U32 z = 0; z < avoidList.size(); ++z)
+	{
+		Box3F nodeBox = Box3F(node->mPosition - (IAIPATHGLOBAL_NODE_CLEARANCE/2), node->mPosition + (IAIPATHGLOBAL_NODE_CLEARANCE/2));
+
+		// see if the avoid list box overlaps the nodes box
+		if (avoidList[z].isOverlapped(nodeBox))
+			return true;
+	}
+
+	// didn't overlap on any boxes
+	return false;
+}
+
+void iAIPathGrid::updateWorldBox()
+{
+	if (this->mCompiled)
+	{
+		Point3F min = Point3F(this->mNodes.front()->mPosition);
+		Point3F max = Point3F(this->mNodes.front()->mPosition);
+
+		// iterate over all nodes and find the min & max
+		for (U32 i = 0; i < this->mNodes.size(); ++i)
+		{
+			if (this->mNodes[i]->mPosition.x < min.x)
+				min.x = this->mNodes[i]->mPosition.x;
+			if (this->mNodes[i]->mPosition.y < min.y)
+				min.y = this->mNodes[i]->mPosition.y;
+			if (this->mNodes[i]->mPosition.z < min.z)
+				min.z = this->mNodes[i]->mPosition.z;
+
+
+			if (this->mNodes[i]->mPosition.x > max.x)
+				max.x = this->mNodes[i]->mPosition.x;
+			if (this->mNodes[i]->mPosition.y > max.y)
+				max.y = this->mNodes[i]->mPosition.y;
+			if (this->mNodes[i]->mPosition.z > max.z)
+				max.z = this->mNodes[i]->mPosition.z;
+		}
+
+		// set position as halfway point
+		this->setPosition(min + ((max - min) / 2));
+		
+		// create a box to encompass the entire path
+		this->mObjBox.min.set(-(this->getPosition() - min));
+		this->mObjBox.max.set(max - this->getPosition());
+
+		// must reset world box & transform when changing object box
+		this->resetWorldBox();
+		this->setRenderTransform(mObjToWorld);
+	}
+}
+
+iAIPathNode* iAIPathGrid::getClosestNode(const Point3F position)
+{
+	PROFILE_SCOPE(iAIPathGrid_getClosestNode);
+
+	F32 closestVec = 1000.0f;
+	F32 currentVec = 1000.0f;
+	iAIPathNode* closestNode = 0;
+
+	// iterate over all nodes
+	for (U32 i = 0; i < this->mNodes.size(); ++i)
+	{
+		// calculate the vector length
+		currentVec = Point3F(position - this->mNodes[i]->mPosition).len();
+
+		// check if its closest one found so far
+		if (currentVec < closestVec)
+		{
+			// save as closest so far
+			closestVec = currentVec;
+			closestNode = this->mNodes[i];
+		}
+	}
+
+	return closestNode;
 }
\ No newline at end of file
@@ -1,188 +1,819 @@
-//-------------------------------------------------------------------
-// Immersive AI :: Seek :: iAIPathGrid
-// Copyright (c) 2006 Gavin Bunney & Tom Romano
-//-------------------------------------------------------------------
-
-//-------------------------------------------------------------------
-/// @file iAIPathGrid.h
-//-------------------------------------------------------------------
-/// @class iAIPathGrid
-/// @author Gavin Bunney
-/// @version 1.0
-/// @brief Represents a small collection of nodes.
-/// 
-/// Holds a collection of nodes based around a set grid position.
-/// Used in combination with other grids to form the iAIPathMap.
-/// <br><br>
-/// TypeMask |= iAIPathGridObjectType;
-//-------------------------------------------------------------------
-#ifndef _IAIPATHGRID_H_
-#define _IAIPATHGRID_H_
-
-#include "iAIPathNode.h"
-#include "iAIPathGrid.h"
-#include "iAIPathMap.h"
-
-class iAIPathGrid : public SceneObject
-{
-	friend class iAIPathMap;
-
-	typedef SceneObject Parent;
-
-public:
-	
-	//-------------------------------------------------------------------
-	/// @var DECLARE_CONOBJECT(iAIPathGrid)
-	/// @brief TorqueScript object.
-	//-------------------------------------------------------------------
-	DECLARE_CONOBJECT(iAIPathGrid);
-
-	//-------------------------------------------------------------------
-	/// @fn iAIPathGrid() 
-	/// @brief Default constructor.
-	//-------------------------------------------------------------------
-	iAIPathGrid();
-
-	//-------------------------------------------------------------------
-	/// @fn ~iAIPathGrid() 
-	/// @brief Default deconstructor.
-	//-------------------------------------------------------------------
-	~iAIPathGrid();
-
-	//-------------------------------------------------------------------
-	/// @fn bool onAdd()
-	/// @brief Called on adding to Sim.
-	//-------------------------------------------------------------------
-	bool onAdd();
-
-	//-------------------------------------------------------------------
-	/// @fn bool onRemove()
-	/// @brief Called on removal from Sim.
-	//-------------------------------------------------------------------
-	void onRemove();
-
-	//-------------------------------------------------------------------
-	/// @fn bool prepRenderImage(SceneState *state, const U32 stateKey,
-	///     const U32 startZone, const bool modifyBaseZoneState = false)
-	/// @brief Called on scene render. Detects if the path needs to be
-	///        rendered, calls renderObject if need to render the path.
-	///
-	/// @param state the current SceneState.
-	/// @param stateKey key for the state.
-	/// @param startZone zone for scene start.
-	/// @param modifyBaseZoneState flag to modify the base zone state.
-	/// @return scene state change.
-	//-------------------------------------------------------------------
-	bool prepRenderImage(SceneState *state, const U32 stateKey, const U32 startZone, const bool modifyBaseZoneState = false);
-
-	//-------------------------------------------------------------------
-	/// @fn void renderObject(SceneState *state, SceneRenderImage *image)
-	/// @brief Renders the path.
-	///
-	/// @param state the current SceneState.
-	/// @param image scene to render in.
-	//-------------------------------------------------------------------
-	void renderObject(SceneState *state, SceneRenderImage *image);
-
-	//-------------------------------------------------------------------
-	/// @fn void toggleDisplay()
-	/// @brief Toggles displaying of the grid.
-	//-------------------------------------------------------------------
-	void toggleDisplay();
-
-	//-------------------------------------------------------------------
-	/// @fn bool createTerrainGrid(const Point3F worldStart,
-	///						       const Point3F worldEnd,
-	///                            Vector<Box3F> &avoidList,
-	///                            const F32 density = 1.0f)
-	/// @brief Creates a grid for the parsed area and density, avoiding
-	///        the locations within the avoidList.
-	///
-	/// @param worldStart The starting point in world coords for the grid
-	/// @param worldEnd The ending point in world coords for the grid
-	/// @param avoidList Vector of boxes (in world points) to avoid
-	/// @param density Density of node coverage. Default 1.0f.
-	/// @return creation success.
-	//-------------------------------------------------------------------
-	bool createTerrainGrid(const Point3F worldStart, const Point3F worldEnd, Vector<Box3F> &avoidList, const F32 density = 1.0f);
-
-	//-------------------------------------------------------------------
-	/// @fn void clearGrid()
-	/// @brief Clears the grid.
-	//-------------------------------------------------------------------
-	void clearGrid();
-
-	//-------------------------------------------------------------------
-	/// @fn iAIPathNode* getClosestNode(const Point3F position)
-	/// @brief Retrieves the closest node to the parsed position
-	///
-	/// @param position world point of node to find
-	/// @return pointer to closest node
-	//-------------------------------------------------------------------
-	iAIPathNode* getClosestNode(const Point3F position);
-
-	//-------------------------------------------------------------------
-	/// @var Box3F mGridBox
-	/// @brief Box encompassing the whole grid.
-	//-------------------------------------------------------------------
-	Box3F mGridBox;
-
-private:
-	
-	//-------------------------------------------------------------------
-	/// @fn bool isInAvoidList(const iAIPathNode *node,
-	///          const Vector<Box3F> &avoidList)
-	/// @brief Checks if the given node is within the avoid list.
-	///
-	/// @param node Node to check.
-	/// @param avoidList Vector of Boxes to check within.
-	/// @return True if node is in the avoid list space.
-	//-------------------------------------------------------------------
-	bool isInAvoidList(const iAIPathNode *node, const Vector<Box3F> &avoidList);
-
-	//-------------------------------------------------------------------
-	/// @fn void updateWorldBox()
-	/// @brief Updates the grids worldbox to encompass the entire grid.
-	//-------------------------------------------------------------------
-	void updateWorldBox();
-
-protected:
-	
-	//-------------------------------------------------------------------
-	/// @var Vector<iAIPathNode*> mNodes
-	/// @brief Vector of all nodes in the grid.
-	//-------------------------------------------------------------------
-	Vector<iAIPathNode*> mNodes;
-
-	//-------------------------------------------------------------------
-	/// @var F32 mDensity
-	/// @brief Density of nodes per unit of worldspace.
-	//-------------------------------------------------------------------
-	F32 mDensity;
-
-	//-------------------------------------------------------------------
-	/// @var U16 mNodesCountX
-	/// @brief Count of nodes of pathmap grid, in X direction.
-	//-------------------------------------------------------------------
-	U16 mNodesCountX;
-
-	//-------------------------------------------------------------------
-	/// @var U16 mNodesCountY
-	/// @brief Count of nodes of pathmap grid, in Y direction.
-	//-------------------------------------------------------------------
-	U16 mNodesCountY;
-
-	//-------------------------------------------------------------------
-	/// @var bool mCompiled
-	/// @brief Flag for when a pathmap has been compiled successfully.
-	//-------------------------------------------------------------------
-	bool mCompiled;
-
-	//-------------------------------------------------------------------
-	/// @var bool mShow
-	/// @brief Flag to render the grid.
-	//-------------------------------------------------------------------
-	bool mShow;
-};
-
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathGrid
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+//-------------------------------------------------------------------
+/// @file iAIPathGrid.h
+//-------------------------------------------------------------------
+/// @class iAIPathGrid
+/// @author Gavin Bunney
+/// @version 1.0
+/// @brief Represents a small collection of nodes.
+/// 
+/// Holds a collection of nodes based around a set grid position.
+/// Used in combination with other grids to form the iAIPathMap; the
+/// terrain is covered by one grid per tile, and each interior by a
+/// grid of its own.
+/// <br><br>
+/// TypeMask |= iAIPathGridObjectType;
+//-------------------------------------------------------------------
+#ifndef _IAIPATHGRID_H_
+#define _IAIPATHGRID_H_
+
+#include "iAIPathNode.h"
+#include "iAIPathGrid.h"
+#include "iAIPathMap.h"
+
+class iAIPathCollision;
+class TerrainBlock;
+struct iAIPathGridBuild;
+
+class iAIPathGrid : public SceneObject
+{
+	friend class iAIPathMap;
+
+	typedef SceneObject Parent;
+
+public:
+
+	//-------------------------------------------------------------------
+	/// @enum LatticeDirection
+	/// @brief Directions to the eight neighbours of a node within the
+	///        grid lattice.
+	//-------------------------------------------------------------------
+	enum LatticeDirection
+	{
+		North = 0,
+		South,
+		East,
+		West,
+		NorthEast,
+		SouthEast,
+		SouthWest,
+		NorthWest,
+		DirectionCount
+	};
+
+	//-------------------------------------------------------------------
+	/// @var static const S32 smDirectionX[DirectionCount]
+	/// @brief Step in X for each lattice direction.
+	//-------------------------------------------------------------------
+	static const S32 smDirectionX[DirectionCount];
+
+	//-------------------------------------------------------------------
+	/// @var static const S32 smDirectionY[DirectionCount]
+	/// @brief Step in Y for each lattice direction.
+	//-------------------------------------------------------------------
+	static const S32 smDirectionY[DirectionCount];
+
+	//-------------------------------------------------------------------
+	/// @var static const U8 smDirectionOpposite[DirectionCount]
+	/// @brief Opposite of each lattice direction.
+	//-------------------------------------------------------------------
+	static const U8 smDirectionOpposite[DirectionCount];
+
+	//-------------------------------------------------------------------
+	/// @enum EdgeState
+	/// @brief State of a lattice edge of a lazy grid, 2 bits each.
+	//-------------------------------------------------------------------
+	enum EdgeState
+	{
+		EdgeUnknown = 0,	///< not yet checked by a path search
+		EdgeValid,			///< checked and clear
+		EdgeInvalid,		///< checked and blocked
+		EdgeStateMask = 3
+	};
+	
+	//-------------------------------------------------------------------
+	/// @var DECLARE_CONOBJECT(iAIPathGrid)
+	/// @brief TorqueScript object.
+	//-------------------------------------------------------------------
+	DECLARE_CONOBJECT(iAIPathGrid);
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathGrid() 
+	/// @brief Default constructor.
+	//-------------------------------------------------------------------
+	iAIPathGrid();
+
+	//-------------------------------------------------------------------
+	/// @fn ~iAIPathGrid() 
+	/// @brief Default deconstructor.
+	//-------------------------------------------------------------------
+	~iAIPathGrid();
+
+	//-------------------------------------------------------------------
+	/// @fn bool onAdd()
+	/// @brief Called on adding to Sim.
+	//-------------------------------------------------------------------
+	bool onAdd();
+
+	//-------------------------------------------------------------------
+	/// @fn bool onRemove()
+	/// @brief Called on removal from Sim.
+	//-------------------------------------------------------------------
+	void onRemove();
+
+	//-------------------------------------------------------------------
+	/// @fn bool prepRenderImage(SceneState *state, const U32 stateKey,
+	///     const U32 startZone, const bool modifyBaseZoneState = false)
+	/// @brief Called on scene render. Detects if the path needs to be
+	///        rendered, calls renderObject if need to render the path.
+	///
+	/// @param state the current SceneState.
+	/// @param stateKey key for the state.
+	/// @param startZone zone for scene start.
+	/// @param modifyBaseZoneState flag to modify the base zone state.
+	/// @return scene state change.
+	//-------------------------------------------------------------------
+	bool prepRenderImage(SceneState *state, const U32 stateKey, const U32 startZone, const bool modifyBaseZoneState = false);
+
+	//-------------------------------------------------------------------
+	/// @fn void renderObject(SceneState *state, SceneRenderImage *image)
+	/// @brief Renders the path.
+	///
+	/// @param state the current SceneState.
+	/// @param image scene to render in.
+	//-------------------------------------------------------------------
+	void renderObject(SceneState *state, SceneRenderImage *image);
+
+	//-------------------------------------------------------------------
+	/// @fn void toggleDisplay()
+	/// @brief Toggles displaying of the grid.
+	//-------------------------------------------------------------------
+	void toggleDisplay();
+
+	//-------------------------------------------------------------------
+	/// @fn bool createTerrainGrid(const Point3F worldStart,
+	///						       const Point3F worldEnd,
+	///                            Vector<Box3F> &avoidList,
+	///                            const F32 density = 1.0f)
+	/// @brief Creates a grid for the parsed area and density, avoiding
+	///        the locations within the avoidList.
+	///
+	/// The grid is split into tiles which are sampled and validated
+	/// in parallel against a collision snapshot, using
+	/// $iAIPathMap::buildThreads threads. Nodes are linked afterwards
+	/// in lattice order, so the grid is the same for any thread count.
+	///
+	/// Open, even areas are then merged into rectangular regions, each
+	/// a single node, up to 2^$iAIPathMap::adaptiveLevels nodes on a
+	/// side. Obstacles, avoided boxes, uneven ground and changes in
+	/// move modifier keep the full density around them. Before that,
+	/// if $iAIPathMap::openRegions is set, wide open areas where every
+	/// node links to all its neighbours are merged into larger open
+	/// rectangles, whatever the ground does.
+	///
+	/// If $iAIPathMap::lazyEdges is set, no links are validated up
+	/// front; every node is linked to its clear neighbours and each
+	/// link is checked the first time a path search crosses it, see
+	/// isLinkValid. Lazy grids keep the full density, as merging needs
+	/// every edge within a region known, and don't filter paths by the
+	/// agent's radius, as clearance does too.
+	///
+	/// @param worldStart The starting point in world coords for the grid
+	/// @param worldEnd The ending point in world coords for the grid
+	/// @param avoidList Vector of boxes (in world points) to avoid
+	/// @param density Density of node coverage. Default 1.0f.
+	/// @return creation success.
+	//-------------------------------------------------------------------
+	bool createTerrainGrid(const Point3F worldStart, const Point3F worldEnd, Vector<Box3F> &avoidList, const F32 density = 1.0f);
+
+	//-------------------------------------------------------------------
+	/// @fn bool createInteriorGrid(const Box3F &interiorBox,
+	///                             const F32 density)
+	/// @brief Creates a grid over an interior and a buffer around it,
+	///        at full density. Each node stands on the lowest floor
+	///        with room above it, or on the terrain where there is no
+	///        floor. Builds straight away on the calling thread.
+	///
+	/// @param interiorBox world box of the interior.
+	/// @param density Density of node coverage.
+	/// @return creation success.
+	//-------------------------------------------------------------------
+	bool createInteriorGrid(const Box3F &interiorBox, const F32 density);
+
+	//-------------------------------------------------------------------
+	/// @fn bool isInteriorGrid()
+	/// @brief Checks if the grid was built over an interior.
+	///
+	/// @return true if an interior grid.
+	//-------------------------------------------------------------------
+	bool isInteriorGrid() { return this->mInteriorGrid; }
+
+	//-------------------------------------------------------------------
+	/// @fn const Box3F& getInteriorBox()
+	/// @brief Retrieves the world box of the interior the grid covers.
+	///
+	/// @return Box3F of the interior; empty for terrain grids.
+	//-------------------------------------------------------------------
+	const Box3F& getInteriorBox() { return this->mInteriorBox; }
+
+	//-------------------------------------------------------------------
+	/// @fn F32 getDensityStep()
+	/// @brief Retrieves the world distance between lattice nodes.
+	///
+	/// @return F32 step in X & Y.
+	//-------------------------------------------------------------------
+	F32 getDensityStep() { return 1 / mSqrt(this->mDensity); }
+
+	//-------------------------------------------------------------------
+	/// @fn bool prepareTerrainGrid(const Point3F worldStart,
+	///                             const Point3F worldEnd,
+	///                             Vector<Box3F> &avoidList,
+	///                             const F32 density = 1.0f)
+	/// @brief First step of createTerrainGrid. Sizes the grid and takes
+	///        the collision snapshot. Must be called from the main
+	///        thread.
+	///
+	/// @return false if the grid can't be built.
+	//-------------------------------------------------------------------
+	bool prepareTerrainGrid(const Point3F worldStart, const Point3F worldEnd, Vector<Box3F> &avoidList, const F32 density = 1.0f);
+
+	//-------------------------------------------------------------------
+	/// @fn bool compileGrid()
+	/// @brief Second step of createTerrainGrid. Samples, validates and
+	///        links all the nodes. Touches nothing but the grid and its
+	///        collision snapshot, so may be run on any thread.
+	///
+	/// @return false if cancelled or not prepared.
+	//-------------------------------------------------------------------
+	bool compileGrid();
+
+	//-------------------------------------------------------------------
+	/// @fn bool finishGrid()
+	/// @brief Last step of createTerrainGrid. Frees the build state and
+	///        updates the world box. Must be called from the main
+	///        thread once compileGrid has returned.
+	///
+	/// @return true if the grid holds any nodes.
+	//-------------------------------------------------------------------
+	bool finishGrid();
+
+	//-------------------------------------------------------------------
+	/// @fn void cancelBuild()
+	/// @brief Asks a running compileGrid to stop as soon as possible.
+	///        Safe to call from any thread.
+	//-------------------------------------------------------------------
+	void cancelBuild();
+
+	//-------------------------------------------------------------------
+	/// @fn F32 getBuildProgress()
+	/// @brief Retrieves how far through compileGrid the build is.
+	///
+	/// @return F32 Progress from 0 to 1.
+	//-------------------------------------------------------------------
+	F32 getBuildProgress();
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathCollision* getBuildCollision()
+	/// @brief Retrieves the collision snapshot of the current build.
+	///
+	/// @return pointer to the snapshot, 0 if not building.
+	//-------------------------------------------------------------------
+	iAIPathCollision* getBuildCollision();
+
+	//-------------------------------------------------------------------
+	/// @fn void clearGrid()
+	/// @brief Clears the grid, deleting any unfinished build.
+	//-------------------------------------------------------------------
+	void clearGrid();
+
+	//-------------------------------------------------------------------
+	/// @fn void releaseNodes()
+	/// @brief Frees the nodes of the grid, keeping its bounds & lattice
+	///        size so the nodes can be read back in from the cache.
+	//-------------------------------------------------------------------
+	void releaseNodes();
+
+	//-------------------------------------------------------------------
+	/// @fn bool isResident()
+	/// @brief Checks if the nodes of the grid are in memory; terrain
+	///        tiles may be paged out by the pathmap.
+	///
+	/// @return true if the nodes are loaded.
+	//-------------------------------------------------------------------
+	bool isResident() { return (this->mNodeBlock != 0); }
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getMemoryUsage()
+	/// @brief Estimates the memory held by the nodes of the grid,
+	///        counting every kept node with a full set of neighbours.
+	///
+	/// @return U32 bytes used, 0 if not resident.
+	//-------------------------------------------------------------------
+	U32 getMemoryUsage();
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathNode* getClosestNode(const Point3F position)
+	/// @brief Retrieves the closest node to the parsed position
+	///
+	/// @param position world point of node to find
+	/// @return pointer to closest node
+	//-------------------------------------------------------------------
+	iAIPathNode* getClosestNode(const Point3F position);
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathNode* getLatticeNode(const S32 idX, const S32 idY)
+	/// @brief Retrieves the node at the lattice position. Positions
+	///        within a merged region all return the region's node.
+	///
+	/// @param idX ID in X within the grid.
+	/// @param idY ID in Y within the grid.
+	/// @return pointer to the node, 0 if outside the grid or culled.
+	//-------------------------------------------------------------------
+	iAIPathNode* getLatticeNode(const S32 idX, const S32 idY);
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getLatticeIndex(const iAIPathNode *node)
+	/// @brief Retrieves the lattice index of a node of the grid; the low
+	///        part of its id.
+	///
+	/// @param node node within the grid.
+	/// @return U32 lattice index.
+	//-------------------------------------------------------------------
+	U32 getLatticeIndex(const iAIPathNode *node) { return (node->mIdX * this->mNodesCountY) + node->mIdY; }
+
+	//-------------------------------------------------------------------
+	/// @fn bool getPortal(const iAIPathNode *from, const iAIPathNode *to,
+	///                    const F32 radius, Point3F &left, Point3F &right)
+	/// @brief Retrieves the opening between two linked nodes of the
+	///        grid; the longest straight run of valid lattice edges
+	///        across the border of their regions, widened by the
+	///        clearance at its ends and narrowed by the radius.
+	///
+	/// @param from node the opening is crossed from.
+	/// @param to node the opening is crossed into.
+	/// @param radius radius of the agent crossing.
+	/// @param left set to the end on the left, facing from to to.
+	/// @param right set to the end on the right.
+	/// @return false if the nodes don't share an opening.
+	//-------------------------------------------------------------------
+	bool getPortal(const iAIPathNode *from, const iAIPathNode *to, const F32 radius, Point3F &left, Point3F &right);
+
+	//-------------------------------------------------------------------
+	/// @fn static bool isLinkValid(iAIPathNode *from, iAIPathNode *to,
+	///                             U32 *validateCount = 0)
+	/// @brief Checks a link can be crossed. Links of lazy grids are
+	///        validated the first time they are asked for and the
+	///        result kept for both directions; every other link was
+	///        validated when built, so is valid.
+	///
+	/// @param from node the link is crossed from.
+	/// @param to node the link is crossed into.
+	/// @param validateCount If set, incremented for each link validated.
+	/// @return link is valid.
+	//-------------------------------------------------------------------
+	static bool isLinkValid(iAIPathNode *from, iAIPathNode *to, U32 *validateCount = 0);
+
+	//-------------------------------------------------------------------
+	/// @fn bool isLazy()
+	/// @brief Checks if the grid's links are validated on demand.
+	//-------------------------------------------------------------------
+	bool isLazy() { return (this->mEdgeState.size() > 0); }
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getGridId()
+	/// @brief Retrieves the index of the grid within the pathmap; the
+	///        high part of the ids of its nodes.
+	///
+	/// @return U32 grid id.
+	//-------------------------------------------------------------------
+	U32 getGridId() { return this->mGridId; }
+
+	//-------------------------------------------------------------------
+	/// @fn S32 getMapTile()
+	/// @brief Retrieves the terrain tile the grid covers.
+	///
+	/// @return S32 tile index within the pathmap, -1 for interior grids.
+	//-------------------------------------------------------------------
+	S32 getMapTile() { return this->mMapTile; }
+
+	//-------------------------------------------------------------------
+	/// @fn bool rebuildRegion(const Box3F &region, Box3F &affectedBox)
+	/// @brief Re-samples, re-validates and re-links only the nodes
+	///        within the region and along its border. Nodes stay at the
+	///        same address, so paths holding them remain valid to
+	///        read. Runs on the main thread against the server
+	///        container.
+	///
+	/// @param region world box which has changed.
+	/// @param affectedBox set to the world box where links may have
+	///        changed.
+	/// @return true if the region overlapped the grid.
+	//-------------------------------------------------------------------
+	bool rebuildRegion(const Box3F &region, Box3F &affectedBox);
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getBuildRayCount()
+	/// @brief Retrieves the number of rays cast by the last build.
+	///
+	/// @return U32 Ray count.
+	//-------------------------------------------------------------------
+	U32 getBuildRayCount() { return this->mBuildRayCount; }
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getBuildTime()
+	/// @brief Retrieves the duration of the last build.
+	///
+	/// @return U32 Build time in milliseconds.
+	//-------------------------------------------------------------------
+	U32 getBuildTime() { return this->mBuildTime; }
+
+	//-------------------------------------------------------------------
+	/// @var Box3F mGridBox
+	/// @brief Box encompassing the whole grid.
+	//-------------------------------------------------------------------
+	Box3F mGridBox;
+
+	//-------------------------------------------------------------------
+	/// @fn static void getSurfaceCosts(TerrainBlock *terrain,
+	///                                 F32 *surfaceCosts)
+	/// @brief Reads the cost of each terrain material from
+	///        $iAIPathMap::surfaceCost[<material name>], 0 if not set.
+	///
+	/// @param terrain Terrain to read the materials of.
+	/// @param surfaceCosts Filled with TerrainBlock::MaterialGroups costs.
+	//-------------------------------------------------------------------
+	static void getSurfaceCosts(TerrainBlock *terrain, F32 *surfaceCosts);
+
+private:
+	
+	//-------------------------------------------------------------------
+	/// @fn bool isInAvoidList(const iAIPathNode *node,
+	///          const Vector<Box3F> &avoidList)
+	/// @brief Checks if the given node is within the avoid list.
+	///
+	/// @param node Node to check.
+	/// @param avoidList Vector of Boxes to check within.
+	/// @return True if node is in the avoid list space.
+	//-------------------------------------------------------------------
+	bool isInAvoidList(const iAIPathNode *node, const Vector<Box3F> &avoidList);
+
+	//-------------------------------------------------------------------
+	/// @fn void updateWorldBox()
+	/// @brief Updates the grids worldbox to encompass the entire grid.
+	//-------------------------------------------------------------------
+	void updateWorldBox();
+
+	//-------------------------------------------------------------------
+	/// @fn static void sampleTile(void *context, const U32 tile)
+	/// @brief Build job which positions the nodes of a tile on the
+	///        terrain and checks their clearance.
+	///
+	/// @param context Pointer to the iAIPathGridBuild.
+	/// @param tile Index of the tile to sample.
+	//-------------------------------------------------------------------
+	static void sampleTile(void *context, const U32 tile);
+
+	//-------------------------------------------------------------------
+	/// @fn static void validateTile(void *context, const U32 tile)
+	/// @brief Build job which validates the neighbour links of every
+	///        node in a tile. Only the links to the north, east,
+	///        north-east and south-east are checked; the others are the
+	///        same edges seen from the neighbour.
+	///
+	/// @param context Pointer to the iAIPathGridBuild.
+	/// @param tile Index of the tile to validate.
+	//-------------------------------------------------------------------
+	static void validateTile(void *context, const U32 tile);
+
+	//-------------------------------------------------------------------
+	/// @fn void getTileBounds(const U32 tile, U32 &startX, U32 &endX,
+	///                        U32 &startY, U32 &endY)
+	/// @brief Retrieves the lattice range covered by a build tile.
+	//-------------------------------------------------------------------
+	void getTileBounds(const U32 tile, U32 &startX, U32 &endX, U32 &startY, U32 &endY);
+
+	//-------------------------------------------------------------------
+	/// @fn Point3F placeNode(TerrainBlock *terrain, const U16 idX,
+	///                       const U16 idY,
+	///                       const iAIPathCollision *collision = 0,
+	///                       U32 *rayCount = 0)
+	/// @brief Retrieves the position of a lattice node on the terrain,
+	///        or on the lowest floor above it for interior grids.
+	//-------------------------------------------------------------------
+	Point3F placeNode(TerrainBlock *terrain, const U16 idX, const U16 idY, const iAIPathCollision *collision = 0, U32 *rayCount = 0);
+
+	//-------------------------------------------------------------------
+	/// @fn void sampleNode(TerrainBlock *terrain, const U16 idX,
+	///                     const U16 idY, const iAIPathCollision *collision,
+	///                     U32 *rayCount)
+	/// @brief Positions a lattice node on the terrain and checks if it
+	///        is clear.
+	//-------------------------------------------------------------------
+	void sampleNode(TerrainBlock *terrain, const U16 idX, const U16 idY, const iAIPathCollision *collision, U32 *rayCount);
+
+	//-------------------------------------------------------------------
+	/// @fn void sampleTerrainTile(iAIPathGridBuild *build, const U32 tile)
+	/// @brief Positions every node of a tile straight from the terrain
+	///        heightfield and checks if they are clear. Also finds which
+	///        of the links validated by the build are too steep, from the
+	///        heights sampled around the tile.
+	///
+	/// @param build Build the tile belongs to.
+	/// @param tile Index of the tile to sample.
+	//-------------------------------------------------------------------
+	void sampleTerrainTile(iAIPathGridBuild *build, const U32 tile);
+
+	//-------------------------------------------------------------------
+	/// @fn void bakeNode(TerrainBlock *terrain, iAIPathNode *node,
+	///                   const Vector<Box3F> &waterBoxes,
+	///                   const F32 *surfaceCosts)
+	/// @brief Bakes the cost channels of a single placed node, for when
+	///        nodes are placed outside of a build.
+	///
+	/// @param terrain Terrain the grid is on.
+	/// @param node Node to bake.
+	/// @param waterBoxes World boxes of the water blocks over the grid.
+	/// @param surfaceCosts Cost of each terrain material.
+	//-------------------------------------------------------------------
+	void bakeNode(TerrainBlock *terrain, iAIPathNode *node, const Vector<Box3F> &waterBoxes, const F32 *surfaceCosts);
+
+	//-------------------------------------------------------------------
+	/// @fn S32 getClearanceSteps()
+	/// @brief Retrieves how many lattice steps away an obstruction can
+	///        still affect a node's clearance.
+	//-------------------------------------------------------------------
+	S32 getClearanceSteps();
+
+	//-------------------------------------------------------------------
+	/// @fn void computeClearance(S32 startX, S32 endX, S32 startY,
+	///                           S32 endY)
+	/// @brief Distance transform of the lattice; sets the clearance of
+	///        every node in the range from the lattice positions which
+	///        aren't clear and the lattice edges which aren't valid,
+	///        out to getClearanceSteps() beyond the range. Lazy grids
+	///        don't know which edges are blocked, so every node is left
+	///        at IAIPATHGLOBAL_NODE_CLEARANCE_MAX.
+	///
+	/// @param startX First lattice position in X.
+	/// @param endX Lattice position in X to stop before.
+	/// @param startY First lattice position in Y.
+	/// @param endY Lattice position in Y to stop before.
+	//-------------------------------------------------------------------
+	void computeClearance(S32 startX, S32 endX, S32 startY, S32 endY);
+
+	//-------------------------------------------------------------------
+	/// @fn bool isNodeKept(const U32 index)
+	/// @brief Checks if the node at a lattice index is clear and has
+	///        at least one valid edge.
+	//-------------------------------------------------------------------
+	bool isNodeKept(const U32 index) { return this->mClear[index] && (this->mEdges[index] != 0); }
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getEdgeState(const U32 index, const U32 dir)
+	/// @brief Retrieves the EdgeState of a lattice edge of a lazy grid.
+	//-------------------------------------------------------------------
+	U32 getEdgeState(const U32 index, const U32 dir) { return (this->mEdgeState[index] >> (dir * 2)) & EdgeStateMask; }
+
+	//-------------------------------------------------------------------
+	/// @fn void setEdgeState(const U32 index, const U32 dir,
+	///                       const U32 state)
+	/// @brief Sets the EdgeState of a lattice edge of a lazy grid, from
+	///        both its ends.
+	//-------------------------------------------------------------------
+	void setEdgeState(const U32 index, const U32 dir, const U32 state);
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getRegionIndex(const S32 idX, const S32 idY)
+	/// @brief Retrieves the lattice index of the node standing for the
+	///        position; the position itself unless it has been merged.
+	//-------------------------------------------------------------------
+	U32 getRegionIndex(const S32 idX, const S32 idY) { return this->mRegion[(idX * this->mNodesCountY) + idY]; }
+
+	//-------------------------------------------------------------------
+	/// @fn bool isRegionMergeable(const S32 anchorX, const S32 anchorY,
+	///                            const S32 sizeX, const S32 sizeY)
+	/// @brief Checks if the rectangle at the anchor can be merged into
+	///        one node; every position in it clear and not yet merged,
+	///        every lattice edge within it valid, its move modifier
+	///        uniform and its heights even.
+	//-------------------------------------------------------------------
+	bool isRegionMergeable(const S32 anchorX, const S32 anchorY, const S32 sizeX, const S32 sizeY);
+
+	//-------------------------------------------------------------------
+	/// @fn bool isRangeOpen(const S32 startX, const S32 endX,
+	///                      const S32 startY, const S32 endY,
+	///                      const U8 surface, const F32 moveModifier)
+	/// @brief Checks every position in the range is clear, not yet
+	///        merged, has a valid edge to each of its neighbours within
+	///        the lattice and matches the surface & move modifier. Such
+	///        positions can be merged regardless of their heights. End
+	///        values are exclusive.
+	//-------------------------------------------------------------------
+	bool isRangeOpen(const S32 startX, const S32 endX, const S32 startY, const S32 endY, const U8 surface, const F32 moveModifier);
+
+	//-------------------------------------------------------------------
+	/// @fn void mergeOpenRegions(const S32 startX, const S32 endX,
+	///                           const S32 startY, const S32 endY)
+	/// @brief Merges the wide open areas within the range into open
+	///        rectangles of up to mOpenSize positions on a side. Only
+	///        rectangles larger than an adaptive region could be are
+	///        kept; the rest is left to the adaptive merge. Called by
+	///        mergeRegions. End values are exclusive.
+	//-------------------------------------------------------------------
+	void mergeOpenRegions(const S32 startX, const S32 endX, const S32 startY, const S32 endY);
+
+	//-------------------------------------------------------------------
+	/// @fn S32 getMaxRegionSize()
+	/// @brief Retrieves the most positions on a side any merged region
+	///        of the grid can cover.
+	//-------------------------------------------------------------------
+	S32 getMaxRegionSize() { return getMax(1 << this->mAdaptiveLevels, (S32)this->mOpenSize); }
+
+	//-------------------------------------------------------------------
+	/// @fn void mergeRegions(const S32 startX, const S32 endX,
+	///                       const S32 startY, const S32 endY)
+	/// @brief Recalculates the merged regions within the range from the
+	///        clear & edge masks. Each region is grown from its first
+	///        free position in lattice order, a row or column at a time,
+	///        for as long as it stays mergeable. The range must not split
+	///        a merged region. Open rectangles are merged first. End
+	///        values are exclusive.
+	//-------------------------------------------------------------------
+	void mergeRegions(const S32 startX, const S32 endX, const S32 startY, const S32 endY);
+
+	//-------------------------------------------------------------------
+	/// @fn void expandToRegions(S32 &startX, S32 &endX, S32 &startY,
+	///                          S32 &endY)
+	/// @brief Grows the range, clamped to the lattice, until it splits
+	///        no merged region. End values are exclusive.
+	//-------------------------------------------------------------------
+	void expandToRegions(S32 &startX, S32 &endX, S32 &startY, S32 &endY);
+
+	//-------------------------------------------------------------------
+	/// @fn void linkNodes(const S32 startX, const S32 endX,
+	///                    const S32 startY, const S32 endY,
+	///                    const iAIPathCollision *collision = 0)
+	/// @brief Rebuilds the neighbours and lattice slots of the nodes in
+	///        the range from the edge masks. Merged regions are linked to
+	///        every node they share a valid lattice edge with. The range
+	///        must not split a merged region. End values are exclusive.
+	//-------------------------------------------------------------------
+	void linkNodes(const S32 startX, const S32 endX, const S32 startY, const S32 endY, const iAIPathCollision *collision = 0);
+
+	//-------------------------------------------------------------------
+	/// @fn void collectNodes()
+	/// @brief Rebuilds mNodes from the lattice, in lattice order.
+	//-------------------------------------------------------------------
+	void collectNodes();
+
+	//-------------------------------------------------------------------
+	/// @fn void restoreLatticeState()
+	/// @brief Rebuilds the clear & edge masks from the nodes of a grid
+	///        loaded from the cache, so regions can be rebuilt. The span
+	///        of each node must already be set; the lattice nodes hidden
+	///        within merged regions are placed back on the terrain, and
+	///        their clearance worked out again.
+	//-------------------------------------------------------------------
+	void restoreLatticeState();
+
+protected:
+	
+	//-------------------------------------------------------------------
+	/// @var Vector<iAIPathNode*> mNodes
+	/// @brief Vector of all nodes in the grid.
+	//-------------------------------------------------------------------
+	Vector<iAIPathNode*> mNodes;
+
+	//-------------------------------------------------------------------
+	/// @var iAIPathNode* mNodeBlock
+	/// @brief Storage for every node in the lattice, allocated as one
+	///        block. Culled nodes are left in the block unused.
+	//-------------------------------------------------------------------
+	iAIPathNode* mNodeBlock;
+
+	//-------------------------------------------------------------------
+	/// @var iAIPathGridBuild* mBuild
+	/// @brief State of the build in progress, 0 when not building.
+	//-------------------------------------------------------------------
+	iAIPathGridBuild* mBuild;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<iAIPathNode*> mLattice
+	/// @brief Node at each lattice position, indexed by
+	///        (idX * mNodesCountY) + idY. Culled positions are 0.
+	//-------------------------------------------------------------------
+	Vector<iAIPathNode*> mLattice;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<U8> mClear
+	/// @brief Per lattice position; node is clear and not avoided.
+	//-------------------------------------------------------------------
+	Vector<U8> mClear;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<U8> mEdges
+	/// @brief Per lattice position; bit mask of the lattice directions
+	///        with a valid edge, before nodes are culled.
+	//-------------------------------------------------------------------
+	Vector<U8> mEdges;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<U16> mEdgeState
+	/// @brief Per lattice position; 2 bits for each lattice direction
+	///        holding the EdgeState of its edge. Only lazy grids have
+	///        one, where mEdges holds the edges not yet ruled out.
+	//-------------------------------------------------------------------
+	Vector<U16> mEdgeState;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<U32> mRegion
+	/// @brief Per lattice position; lattice index of the node standing
+	///        for the merged region covering it, which is the position
+	///        just past the middle of the region. The position itself
+	///        if not merged.
+	//-------------------------------------------------------------------
+	Vector<U32> mRegion;
+
+	//-------------------------------------------------------------------
+	/// @var U8 mAdaptiveLevels
+	/// @brief Regions are merged up to 2^mAdaptiveLevels positions on a
+	///        side.
+	//-------------------------------------------------------------------
+	U8 mAdaptiveLevels;
+
+	//-------------------------------------------------------------------
+	/// @var U8 mOpenSize
+	/// @brief Open rectangles are merged up to mOpenSize positions on a
+	///        side; 0 if not merged.
+	//-------------------------------------------------------------------
+	U8 mOpenSize;
+
+	//-------------------------------------------------------------------
+	/// @var bool mInteriorGrid
+	/// @brief Grid was built over an interior.
+	//-------------------------------------------------------------------
+	bool mInteriorGrid;
+
+	//-------------------------------------------------------------------
+	/// @var Box3F mInteriorBox
+	/// @brief World box of the interior an interior grid covers.
+	//-------------------------------------------------------------------
+	Box3F mInteriorBox;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<Box3F> mAvoidList
+	/// @brief Boxes the grid was built to avoid.
+	//-------------------------------------------------------------------
+	Vector<Box3F> mAvoidList;
+
+	//-------------------------------------------------------------------
+	/// @var F32 mDensity
+	/// @brief Density of nodes per unit of worldspace.
+	//-------------------------------------------------------------------
+	F32 mDensity;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mNodesCountX
+	/// @brief Count of nodes of pathmap grid, in X direction.
+	//-------------------------------------------------------------------
+	U32 mNodesCountX;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mNodesCountY
+	/// @brief Count of nodes of pathmap grid, in Y direction.
+	//-------------------------------------------------------------------
+	U32 mNodesCountY;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mGridId
+	/// @brief Index of the grid within the pathmap, set by the map.
+	//-------------------------------------------------------------------
+	U32 mGridId;
+
+	//-------------------------------------------------------------------
+	/// @var S32 mMapTile
+	/// @brief Terrain tile the grid covers, set by the map; -1 if not a
+	///        terrain tile.
+	//-------------------------------------------------------------------
+	S32 mMapTile;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mBuildRayCount
+	/// @brief Number of rays cast by the last build.
+	//-------------------------------------------------------------------
+	U32 mBuildRayCount;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mBuildTime
+	/// @brief Duration of the last build, in milliseconds.
+	//-------------------------------------------------------------------
+	U32 mBuildTime;
+
+	//-------------------------------------------------------------------
+	/// @var bool mCompiled
+	/// @brief Flag for when a pathmap has been compiled successfully.
+	//-------------------------------------------------------------------
+	bool mCompiled;
+
+	//-------------------------------------------------------------------
+	/// @var bool mShow
+	/// @brief Flag to render the grid.
+	//-------------------------------------------------------------------
+	bool mShow;
+};
+
 #endif
\ No newline at end of file
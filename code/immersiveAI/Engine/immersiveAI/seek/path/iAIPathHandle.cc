@@ -0,0 +1,529 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathHandle
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+#include "console/simBase.h"
+#include "math/mBox.h"
+
+#include "iAIPathHandle.h"
+#include "iAIPathMap.h"
+#include "iAIPathFind.h"
+#include "iAIPathGlobal.h"
+#include "iAIPathDensity.h"
+#include "iAIPathReservation.h"
+
+Vector<iAIPathHandle*> iAIPathHandle::smActiveHandles;
+Vector<iAIPathHandle*> iAIPathHandle::smFreeHandles;
+Vector<iAIPathHandle::CacheEntry> iAIPathHandle::smCache;
+U32 iAIPathHandle::smCacheNext = 0;
+
+iAIPathHandle::iAIPathHandle()
+{
+	this->mBuffer = 0;
+	this->mCursor = 0;
+	this->mRouteReleased = 0;
+	this->mRouteGeneration = 0;
+	this->mCooperative = false;
+	this->mReplanAt = U32_MAX;
+	this->mTraversing = false;
+	this->mLastPosition = IAIPATHGLOBAL_INVALID_POSITION;
+	this->mGoal = Point3F(0,0,0);
+	this->mInvalidated = false;
+	this->mPending = false;
+	this->mOwnerId = 0;
+}
+
+iAIPathHandle* iAIPathHandle::create(SimObject *owner)
+{
+	iAIPathHandle *handle = 0;
+
+	// reuse a handle given back if there is one
+	if (iAIPathHandle::smFreeHandles.size() > 0)
+	{
+		handle = iAIPathHandle::smFreeHandles.last();
+		iAIPathHandle::smFreeHandles.pop_back();
+	} else
+	{
+		handle = new iAIPathHandle();
+	}
+
+	handle->setOwner(owner);
+	iAIPathHandle::smActiveHandles.push_back(handle);
+
+	return handle;
+}
+
+void iAIPathHandle::destroy(iAIPathHandle *handle)
+{
+	if (!handle)
+		return;
+
+	// no longer tracked for pathmap changes
+	for (U32 i = 0; i < iAIPathHandle::smActiveHandles.size(); ++i)
+	{
+		if (iAIPathHandle::smActiveHandles[i] == handle)
+		{
+			iAIPathHandle::smActiveHandles.erase_fast(i);
+			break;
+		}
+	}
+
+	// empty it out, ready for the next taker
+	handle->clearPath();
+	handle->mGoal = Point3F(0,0,0);
+	handle->mOwnerId = 0;
+	iAIPathHandle::smFreeHandles.push_back(handle);
+}
+
+void iAIPathHandle::setOwner(SimObject *owner)
+{
+	this->mOwnerId = owner ? owner->getId() : 0;
+}
+
+void iAIPathHandle::clearPath()
+{
+	this->setBuffer(0);
+	this->mInvalidated = false;
+	this->mPending = false;
+}
+
+void iAIPathHandle::setBuffer(Buffer *buffer)
+{
+	if (buffer)
+		++buffer->mRefCount;
+
+	// the old route is no longer ahead
+	if (this->mBuffer)
+		this->releaseRoute(this->mBuffer->mNodeIds.size());
+
+	iAIPathHandle::releaseBuffer(this->mBuffer);
+	this->mBuffer = buffer;
+
+	// and so are its reservations
+	if (this->mCooperative)
+	{
+		iAIPathReservation::getInstance()->release(this->mOwnerId);
+		this->mCooperative = false;
+	}
+	this->mReplanAt = U32_MAX;
+
+	// follow it from the start
+	this->mCursor = 0;
+	this->mTraversing = false;
+	this->mLastPosition = IAIPATHGLOBAL_INVALID_POSITION;
+
+	// all of the new route is ahead
+	this->mRouteReleased = 0;
+	if (buffer)
+	{
+		iAIPathDensity *density = iAIPathDensity::getInstance();
+		this->mRouteGeneration = density->getGeneration();
+		for (U32 i = 0; i < buffer->mNodeIds.size(); ++i)
+			density->add(buffer->mNodeIds[i], IAIPATHDENSITY_ROUTE_AMOUNT);
+	}
+}
+
+void iAIPathHandle::releaseRoute(const U32 end)
+{
+	iAIPathDensity *density = iAIPathDensity::getInstance();
+	for (; this->mRouteReleased < end; ++this->mRouteReleased)
+		density->remove(this->mBuffer->mNodeIds[this->mRouteReleased], IAIPATHDENSITY_ROUTE_AMOUNT, this->mRouteGeneration);
+}
+
+iAIPathHandle::Buffer* iAIPathHandle::newBuffer(const Vector<iAIPathNode*> &nodeList)
+{
+	Buffer *buffer = new Buffer;
+	buffer->mRefCount = 0;
+
+	buffer->mNodeIds.reserve(nodeList.size());
+	for (U32 i = 0; i < nodeList.size(); ++i)
+		buffer->mNodeIds.push_back(nodeList[i]->getId());
+
+	return buffer;
+}
+
+void iAIPathHandle::releaseBuffer(Buffer *buffer)
+{
+	if (buffer && (--buffer->mRefCount == 0))
+		delete buffer;
+}
+
+void iAIPathHandle::flushCache()
+{
+	for (U32 i = 0; i < iAIPathHandle::smCache.size(); ++i)
+		iAIPathHandle::releaseBuffer(iAIPathHandle::smCache[i].mBuffer);
+
+	iAIPathHandle::smCache.clear();
+	iAIPathHandle::smCacheNext = 0;
+}
+
+bool iAIPathHandle::createPath(iAIPathMap* pathMap, Point3F start, Point3F end, const bool smoothPath, const F32 radius, const char *profile)
+{
+	this->mGoal = end;
+	this->mInvalidated = false;
+	this->mPending = false;
+
+	// let go of any earlier path
+	this->setBuffer(0);
+
+	iAIPathNode* startNode = 0;
+	iAIPathNode* endNode = 0;
+	if (!this->findEndNodes(pathMap, start, end, startNode, endNode))
+		return false;
+
+	// check if start and end nodes in the same position
+	if (startNode->mPosition == endNode->mPosition)
+	{
+		// just push on the end node
+		Vector<iAIPathNode*> nodeList;
+		nodeList.push_back(endNode);
+		Buffer *buffer = iAIPathHandle::newBuffer(nodeList);
+		buffer->mPoints.push_back(endNode->mPosition);
+		buffer->mPointNodes.push_back(0);
+		this->setBuffer(buffer);
+		return true;
+	}
+
+	// get an instance of the singleton pathfinder
+	iAIPathFind* pathFinder = iAIPathFind::getInstance();
+
+	// weighting of the node costs for the agent; unknown names use the baked costs
+	const iAIPathProfile* costProfile = pathMap->findCostProfile(profile);
+
+	// spread agents over the routes around, if crowds are costed
+	const iAIPathDensity* density = (iAIPathDensity::getWeight() > 0.0f) ? iAIPathDensity::getInstance() : 0;
+
+	// share the path if another agent has just found the same one; not while costing the crowd, it has moved since
+	U32 startId = startNode->getId();
+	U32 goalId = endNode->getId();
+	for (U32 i = 0; !density && (i < iAIPathHandle::smCache.size()); ++i)
+	{
+		const CacheEntry &entry = iAIPathHandle::smCache[i];
+		if ((entry.mStartId == startId) && (entry.mGoalId == goalId) && (entry.mRadius == radius) &&
+			(entry.mProfile == costProfile) && (entry.mSmooth == smoothPath))
+		{
+			this->setBuffer(entry.mBuffer);
+			return true;
+		}
+	}
+
+	// hold the obstacle costs steady for the whole search
+	iAIPathOverlay* overlay = pathMap->getOverlay();
+	const iAIPathOverlay::Buffer* overlayCosts = overlay->acquire();
+
+	// find the path; if unable to find a path, loop until IAIPATHGLOBAL_PATH_RETRY_COUNT is reached
+	Vector<iAIPathNode*> nodeList;
+	Vector<iAIPathNode*> pagedList;
+	U32 retryCount = 0;
+	while ((!(pathFinder->generatePath(startNode, endNode, nodeList, overlayCosts, radius, costProfile, &pagedList, density))) && (retryCount <= IAIPATHGLOBAL_PATH_RETRY_COUNT))
+		++retryCount;
+
+	overlay->release(overlayCosts);
+
+	// the search ran out of loaded tiles; ask for the ones beyond and try again later
+	if ((nodeList.size() == 0) && (pagedList.size() > 0))
+	{
+		for (U32 i = 0; i < pagedList.size(); ++i)
+			pathMap->requestTiles(pagedList[i]->mPosition, 1);
+
+		this->mPending = true;
+		Con::iAIMessagef("Immersive AI :: Seek :: Path waiting on the pathmap to page in tiles");
+		return false;
+	}
+
+	// check that a path was found
+	if (nodeList.size() > 0)
+	{
+		Buffer *buffer = iAIPathHandle::newBuffer(nodeList);
+
+		// pull the path tight through the regions, or walk every node
+		if (smoothPath)
+		{
+			pathFinder->funnelPath(nodeList, radius, buffer->mPoints);
+			Con::iAIMessagef("Immersive AI :: Seek :: Path pulled tight... %d nodes to %d corners", nodeList.size(), buffer->mPoints.size());
+
+			// the node along the route closest to each corner; the corners are in route order
+			U32 nodeIndex = 0;
+			buffer->mPointNodes.reserve(buffer->mPoints.size());
+			for (U32 i = 0; i < buffer->mPoints.size(); ++i)
+			{
+				const Point3F &point = buffer->mPoints[i];
+				F32 closestDist = (nodeList[nodeIndex]->mPosition - point).lenSquared();
+				for (U32 j = nodeIndex + 1; j < nodeList.size(); ++j)
+				{
+					F32 dist = (nodeList[j]->mPosition - point).lenSquared();
+					if (dist < closestDist)
+					{
+						closestDist = dist;
+						nodeIndex = j;
+					}
+				}
+				buffer->mPointNodes.push_back(nodeIndex);
+			}
+		} else
+		{
+			buffer->mPoints.reserve(nodeList.size());
+			buffer->mPointNodes.reserve(nodeList.size());
+			for (U32 i = 0; i < nodeList.size(); ++i)
+			{
+				buffer->mPoints.push_back(nodeList[i]->mPosition);
+				buffer->mPointNodes.push_back(i);
+			}
+		}
+
+		this->setBuffer(buffer);
+
+		// keep it for the next agent asking; the oldest entry makes way once full
+		if (!density && (IAIPATHGLOBAL_PATH_CACHE_SIZE > 0))
+		{
+			CacheEntry entry;
+			entry.mStartId = startId;
+			entry.mGoalId = goalId;
+			entry.mRadius = radius;
+			entry.mProfile = costProfile;
+			entry.mSmooth = smoothPath;
+			entry.mBuffer = buffer;
+			++buffer->mRefCount;
+
+			if (iAIPathHandle::smCache.size() < IAIPATHGLOBAL_PATH_CACHE_SIZE)
+				iAIPathHandle::smCache.push_back(entry);
+			else
+			{
+				iAIPathHandle::releaseBuffer(iAIPathHandle::smCache[iAIPathHandle::smCacheNext].mBuffer);
+				iAIPathHandle::smCache[iAIPathHandle::smCacheNext] = entry;
+				iAIPathHandle::smCacheNext = (iAIPathHandle::smCacheNext + 1) % IAIPATHGLOBAL_PATH_CACHE_SIZE;
+			}
+		}
+
+		return true;
+	} else
+	{
+		Con::errorf("Immersive AI :: Seek :: Unable to find a valid path from %f, %f, %f to %f, %f, %f", start.x, start.y, start.z, end.x, end.y, end.z);
+		return false;
+	}
+}
+
+bool iAIPathHandle::findEndNodes(iAIPathMap* pathMap, const Point3F &start, const Point3F &end, iAIPathNode *&startNode, iAIPathNode *&endNode)
+{
+	// the tiles at either end must be in memory; both are requested before checking
+	bool startResident = pathMap->requestTiles(start);
+	bool endResident = pathMap->requestTiles(end);
+	if (!startResident || !endResident)
+	{
+		this->mPending = true;
+		Con::iAIMessagef("Immersive AI :: Seek :: Path waiting on the pathmap to page in tiles");
+		return false;
+	}
+
+	startNode = pathMap->getClosestNode(start);
+	endNode = pathMap->getClosestNode(end);
+	if (!startNode || !endNode)
+	{
+		Con::errorf("Immersive AI :: Seek :: Path - no nodes near %f, %f, %f or %f, %f, %f", start.x, start.y, start.z, end.x, end.y, end.z);
+		return false;
+	}
+
+	return true;
+}
+
+bool iAIPathHandle::createCooperativePath(iAIPathMap* pathMap, Point3F start, Point3F end, const U32 startStep, const F32 radius, const char *profile)
+{
+	// reservations are held by the owner; nobody to hold them
+	if (this->mOwnerId == 0)
+		return this->createPath(pathMap, start, end, false, radius, profile);
+
+	this->mGoal = end;
+	this->mInvalidated = false;
+	this->mPending = false;
+
+	// let go of any earlier path, and what it reserved
+	this->setBuffer(0);
+
+	iAIPathNode* startNode = 0;
+	iAIPathNode* endNode = 0;
+	if (!this->findEndNodes(pathMap, start, end, startNode, endNode))
+		return false;
+
+	iAIPathFind* pathFinder = iAIPathFind::getInstance();
+	iAIPathReservation* reservation = iAIPathReservation::getInstance();
+	const iAIPathProfile* costProfile = pathMap->findCostProfile(profile);
+	const iAIPathDensity* density = (iAIPathDensity::getWeight() > 0.0f) ? iAIPathDensity::getInstance() : 0;
+	U32 window = iAIPathReservation::getWindow();
+
+	iAIPathOverlay* overlay = pathMap->getOverlay();
+	const iAIPathOverlay::Buffer* overlayCosts = overlay->acquire();
+
+	// the window around the others, then the rest of the way on its own
+	Vector<iAIPathNode*> windowList;
+	Vector<U32> stepList;
+	pathFinder->generateCooperativePath(startNode, endNode, this->mOwnerId, startStep, window, windowList, stepList, overlayCosts, radius, costProfile, density);
+
+	bool goalReached = (windowList.last() == endNode);
+	Vector<iAIPathNode*> restList;
+	if (!goalReached)
+		pathFinder->generatePath(windowList.last(), endNode, restList, overlayCosts, radius, costProfile, 0, density);
+
+	overlay->release(overlayCosts);
+
+	if (!goalReached && (restList.size() == 0))
+	{
+		Con::errorf("Immersive AI :: Seek :: Unable to find a valid cooperative path from %f, %f, %f to %f, %f, %f", start.x, start.y, start.z, end.x, end.y, end.z);
+		return false;
+	}
+
+	// hold every step of the window, waits included; once at the goal, stay there for the rest of it
+	for (U32 i = 0; i < windowList.size(); ++i)
+		reservation->reserve(windowList[i]->getId(), startStep + stepList[i], this->mOwnerId);
+
+	if (goalReached)
+	{
+		for (U32 step = stepList.last() + 1; step <= window; ++step)
+			reservation->reserve(endNode->getId(), startStep + step, this->mOwnerId);
+	}
+
+	// one position per node, the waits folded into the time to head for the next
+	Vector<iAIPathNode*> nodeList;
+	Vector<U32> nodeSteps;
+	for (U32 i = 0; i < windowList.size(); ++i)
+	{
+		if ((nodeList.size() > 0) && (nodeList.last() == windowList[i]))
+			continue;
+
+		nodeList.push_back(windowList[i]);
+		nodeSteps.push_back(stepList[i]);
+	}
+
+	U32 windowCount = nodeList.size();
+	for (U32 i = 1; i < restList.size(); ++i)
+		nodeList.push_back(restList[i]);
+
+	Buffer *buffer = iAIPathHandle::newBuffer(nodeList);
+	buffer->mPoints.reserve(nodeList.size());
+	buffer->mPointNodes.reserve(nodeList.size());
+	buffer->mPointTimes.reserve(windowCount);
+	U32 replanAt = U32_MAX;
+	for (U32 i = 0; i < nodeList.size(); ++i)
+	{
+		buffer->mPoints.push_back(nodeList[i]->mPosition);
+		buffer->mPointNodes.push_back(i);
+
+		// leave for each node of the window on the step before it's reached
+		if (i < windowCount)
+			buffer->mPointTimes.push_back((nodeSteps[i] > 0) ? iAIPathReservation::getStepTime(startStep + nodeSteps[i] - 1) : 0);
+
+		// plan the next window half way through this one, unless it gets to the goal
+		if (!goalReached && (replanAt == U32_MAX) && (i < windowCount) && (nodeSteps[i] >= (window / 2)))
+			replanAt = i;
+	}
+
+	this->setBuffer(buffer);
+	this->mCooperative = true;
+	this->mReplanAt = replanAt;
+
+	Con::iAIMessagef("Immersive AI :: Seek :: Cooperative path created... %d steps reserved, %d nodes", stepList.last(), nodeList.size());
+	return true;
+}
+
+Point3F iAIPathHandle::getNextPosition()
+{
+	// only move past the previous position if we are already traversing!
+	if (this->mTraversing)
+	{
+		// check that this isnt the last position
+		if (this->getPointsLeft() > 1)
+		{
+			// update the last position
+			this->mLastPosition = this->getPoint(0);
+
+			// step the cursor past it; the buffer itself is shared, so never changes
+			++this->mCursor;
+
+			// the route up to the position just left is behind
+			this->releaseRoute(this->mBuffer->mPointNodes[this->mCursor - 1]);
+		}
+	} else
+	{
+		this->mTraversing = true;
+	}
+
+	// return the position, if any left
+	if (this->getPointsLeft() > 0)
+	{
+		Point3F returnPosition = this->getPoint(0);
+
+		// if we are going to return the last position, the path is done
+		if (this->getPointsLeft() == 1)
+		{
+			this->mCursor = this->mBuffer->mPoints.size();
+			this->mLastPosition = IAIPATHGLOBAL_INVALID_POSITION;
+		}
+
+		return returnPosition;
+	} else
+	{
+		return IAIPATHGLOBAL_INVALID_POSITION;
+	}
+}
+
+bool iAIPathHandle::crossesArea(const Box3F &area)
+{
+	// check the node just left too, the agent is still heading away from it
+	Point3F lastPosition = this->mLastPosition;
+
+	for (U32 i = 0; i < this->getPointsLeft(); ++i)
+	{
+		Point3F position = this->getPoint(i);
+		if (area.isContained(position))
+			return true;
+
+		// check the leg between the nodes
+		F32 t;
+		Point3F normal;
+		if ((lastPosition != IAIPATHGLOBAL_INVALID_POSITION) && area.collideLine(lastPosition, position, &t, &normal))
+			return true;
+
+		lastPosition = position;
+	}
+
+	return false;
+}
+
+U32 iAIPathHandle::invalidatePaths(const Box3F &area)
+{
+	// callbacks may destroy handles, so flag them all first and call back on the owners by id
+	Vector<SimObjectId> ownerIds;
+	U32 invalidatedCount = 0;
+	for (U32 i = 0; i < iAIPathHandle::smActiveHandles.size(); ++i)
+	{
+		iAIPathHandle *handle = iAIPathHandle::smActiveHandles[i];
+		if (!handle->mInvalidated && handle->crossesArea(area))
+		{
+			handle->mInvalidated = true;
+			++invalidatedCount;
+
+			if (handle->mOwnerId != 0)
+				ownerIds.push_back(handle->mOwnerId);
+		}
+	}
+
+	for (U32 i = 0; i < ownerIds.size(); ++i)
+	{
+		SimObject *owner = Sim::findObject(ownerIds[i]);
+		if (owner)
+			Con::executef(owner, 1, "onPathInvalidated");
+	}
+
+	return invalidatedCount;
+}
+
+bool iAIPathHandle::isAreaInUse(const Box3F &area)
+{
+	for (U32 i = 0; i < iAIPathHandle::smActiveHandles.size(); ++i)
+	{
+		if (iAIPathHandle::smActiveHandles[i]->crossesArea(area))
+			return true;
+	}
+
+	return false;
+}
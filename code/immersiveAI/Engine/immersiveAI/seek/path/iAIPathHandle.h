@@ -0,0 +1,455 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathHandle
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+//-------------------------------------------------------------------
+/// @file iAIPathHandle.h
+//-------------------------------------------------------------------
+/// @class iAIPathHandle
+/// @author Gavin Bunney
+/// @version 1.0
+/// @brief A path from one point to another, followed by its owner.
+///
+/// Holds the positions of a found path; the corners once pulled
+/// tight through the pathmap regions. Handles are plain objects,
+/// taken from a pool with create() and given back with destroy(),
+/// so agents can find paths without a SimObject each. An iAIPath
+/// wraps a handle to show it in the world.
+/// <br><br>
+/// The positions are held in a Buffer which is never changed once
+/// filled, read from the front by a cursor. Paths found between the
+/// same nodes for the same agent size and cost profile share one
+/// Buffer, through a small cache flushed whenever the pathmap or its
+/// obstacles change. The cache is passed by while crowds are costed,
+/// as the crowd will have moved on since.
+/// <br><br>
+/// Each handle counts the nodes of its route still ahead into
+/// iAIPathDensity, letting them go as the cursor passes them.
+/// <br><br>
+/// Cooperative paths are found with createCooperativePath; their
+/// first steps are reserved in iAIPathReservation, and each position
+/// of those is given the time to head for it.
+//-------------------------------------------------------------------
+#ifndef _IAIPATHHANDLE_H_
+#define _IAIPATHHANDLE_H_
+
+#include "iAIPathNode.h"
+
+class iAIPathMap;
+class iAIPathProfile;
+class SimObject;
+
+class iAIPathHandle {
+
+public:
+
+	//-------------------------------------------------------------------
+	/// @struct Buffer
+	/// @brief Positions of a found path, shared by every handle
+	///        following it. Not changed once filled.
+	//-------------------------------------------------------------------
+	struct Buffer
+	{
+		//-------------------------------------------------------------------
+		/// @var Vector<Point3F> mPoints
+		/// @brief Every position of the path, start to goal.
+		//-------------------------------------------------------------------
+		Vector<Point3F> mPoints;
+
+		//-------------------------------------------------------------------
+		/// @var Vector<U32> mNodeIds
+		/// @brief Id of every node the path crosses, start to goal.
+		//-------------------------------------------------------------------
+		Vector<U32> mNodeIds;
+
+		//-------------------------------------------------------------------
+		/// @var Vector<U32> mPointNodes
+		/// @brief Index in mNodeIds of the node at each position.
+		//-------------------------------------------------------------------
+		Vector<U32> mPointNodes;
+
+		//-------------------------------------------------------------------
+		/// @var Vector<U32> mPointTimes
+		/// @brief Sim time to head for each position, for cooperative
+		///        paths; empty otherwise.
+		//-------------------------------------------------------------------
+		Vector<U32> mPointTimes;
+
+		//-------------------------------------------------------------------
+		/// @var U32 mRefCount
+		/// @brief Number of handles & cache entries holding the buffer.
+		//-------------------------------------------------------------------
+		U32 mRefCount;
+	};
+
+	//-------------------------------------------------------------------
+	/// @fn static iAIPathHandle* create(SimObject *owner = 0)
+	/// @brief Takes an empty handle from the pool, allocating one only
+	///        if the pool is empty.
+	///
+	/// @param owner Object told of changes to the path. Default none.
+	/// @return the handle; must be given back with destroy().
+	//-------------------------------------------------------------------
+	static iAIPathHandle* create(SimObject *owner = 0);
+
+	//-------------------------------------------------------------------
+	/// @fn static void destroy(iAIPathHandle *handle)
+	/// @brief Lets go of the handle's path and returns it to the pool.
+	///
+	/// @param handle handle from create(), or 0.
+	//-------------------------------------------------------------------
+	static void destroy(iAIPathHandle *handle);
+
+	//-------------------------------------------------------------------
+	/// @fn bool createPath(iAIPathMap* pathMap,
+	///                     const Point3F start, const Point3F end,
+	///                     const bool smoothPath = true,
+	///                     const F32 radius = 0.0f,
+	///                     const char *profile = 0)
+	/// @brief Creates a path from the start node to the end node,
+	///        replacing any earlier path.
+	///
+	/// @param pathMap Pointer to the pathmap to generate path within.
+	/// @param start Point to start the path from.
+	/// @param end Point to end the path at.
+	/// @param smoothPath Flag to pull the path tight through the regions
+	///        it crosses. If false, visits every node. Default true.
+	/// @param radius Radius of the agent to fit the path to. Default 0.
+	/// @param profile Name of the cost profile to find the path with.
+	///        Default none, using the baked costs.
+	/// @return Path creation success. If the pathmap has to page in
+	///         tiles first, fails with isPending() set.
+	//-------------------------------------------------------------------
+	bool createPath(iAIPathMap* pathMap, Point3F start, Point3F end, const bool smoothPath = true, const F32 radius = 0.0f, const char *profile = 0);
+
+	//-------------------------------------------------------------------
+	/// @fn bool createCooperativePath(iAIPathMap* pathMap,
+	///                                const Point3F start,
+	///                                const Point3F end,
+	///                                const U32 startStep,
+	///                                const F32 radius = 0.0f,
+	///                                const char *profile = 0)
+	/// @brief Creates a path visiting every node, its first
+	///        $iAIPathMap::cooperativeWindow steps planned around the
+	///        other agents' reservations, then reserves them for the
+	///        owner. The rest of the way is found as createPath would.
+	///        Without an owner, is createPath.
+	///
+	/// @param pathMap Pointer to the pathmap to generate path within.
+	/// @param start Point to start the path from.
+	/// @param end Point to end the path at.
+	/// @param startStep step of time the path starts at.
+	/// @param radius Radius of the agent to fit the path to. Default 0.
+	/// @param profile Name of the cost profile. Default none.
+	/// @return Path creation success.
+	//-------------------------------------------------------------------
+	bool createCooperativePath(iAIPathMap* pathMap, Point3F start, Point3F end, const U32 startStep, const F32 radius = 0.0f, const char *profile = 0);
+
+	//-------------------------------------------------------------------
+	/// @fn void clearPath()
+	/// @brief Lets go of the path, leaving the handle empty.
+	//-------------------------------------------------------------------
+	void clearPath();
+
+	//-------------------------------------------------------------------
+	/// @fn bool hasPath()
+	/// @brief Checks if the handle holds a path, finished or not.
+	///
+	/// @return true if a path has been found and not cleared.
+	//-------------------------------------------------------------------
+	bool hasPath() { return (this->mBuffer != 0); }
+
+	//-------------------------------------------------------------------
+	/// @fn Point3F getNextPosition()
+	/// @brief Retrieves the next position to goto and moves past the
+	///        last visited position.
+	///
+	/// @return Point3F of next position on the path.
+	//-------------------------------------------------------------------
+	Point3F getNextPosition();
+
+	//-------------------------------------------------------------------
+	/// @fn bool hasNextNode()
+	/// @brief Test to see if this path has another position or not.
+	///
+	/// @return True if the path has another position.
+	//-------------------------------------------------------------------
+	bool hasNextNode() { return (this->getPointsLeft() > 0); }
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getPointsLeft()
+	/// @brief Retrieves the number of positions from the cursor on.
+	//-------------------------------------------------------------------
+	U32 getPointsLeft() { return this->mBuffer ? (this->mBuffer->mPoints.size() - this->mCursor) : 0; }
+
+	//-------------------------------------------------------------------
+	/// @fn const Point3F& getPoint(const U32 index)
+	/// @brief Retrieves a position left on the path, 0 being the one at
+	///        the cursor.
+	//-------------------------------------------------------------------
+	const Point3F& getPoint(const U32 index) { return this->mBuffer->mPoints[this->mCursor + index]; }
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getPointTime(const U32 index)
+	/// @brief Retrieves the Sim time to head for a position left on the
+	///        path, 0 being the one at the cursor; 0 if any time will do.
+	//-------------------------------------------------------------------
+	U32 getPointTime(const U32 index) { return ((this->mCursor + index) < this->mBuffer->mPointTimes.size()) ? this->mBuffer->mPointTimes[this->mCursor + index] : 0; }
+
+	//-------------------------------------------------------------------
+	/// @fn bool needsReplan()
+	/// @brief Checks if a cooperative path has been walked far enough
+	///        into its window that the next should be planned.
+	//-------------------------------------------------------------------
+	bool needsReplan() { return (this->mReplanAt != U32_MAX) && (this->mCursor > this->mReplanAt); }
+
+	//-------------------------------------------------------------------
+	/// @fn Point3F getLastPosition()
+	/// @brief Retrieves the last position which was returned, or
+	///        IAIPATHGLOBAL_INVALID_POSITION if none.
+	//-------------------------------------------------------------------
+	Point3F getLastPosition() { return this->mLastPosition; }
+
+	//-------------------------------------------------------------------
+	/// @fn Point3F getGoal()
+	/// @brief Retrieves the position the path was created to reach.
+	///
+	/// @return Point3F goal position.
+	//-------------------------------------------------------------------
+	Point3F getGoal() { return this->mGoal; }
+
+	//-------------------------------------------------------------------
+	/// @fn bool isInvalidated()
+	/// @brief Checks if the pathmap has changed under the path since
+	///        it was created.
+	///
+	/// @return true if the path should be regenerated.
+	//-------------------------------------------------------------------
+	bool isInvalidated() { return this->mInvalidated; }
+
+	//-------------------------------------------------------------------
+	/// @fn bool isPending()
+	/// @brief Checks if the last createPath failed only because the
+	///        tiles it needed are paged out; they've been requested, so
+	///        try again shortly.
+	///
+	/// @return true if waiting on the pathmap.
+	//-------------------------------------------------------------------
+	bool isPending() { return this->mPending; }
+
+	//-------------------------------------------------------------------
+	/// @fn void setOwner(SimObject *owner)
+	/// @brief Sets the object told of changes to the path;
+	///        onPathInvalidated() is called on it.
+	//-------------------------------------------------------------------
+	void setOwner(SimObject *owner);
+
+	//-------------------------------------------------------------------
+	/// @fn bool crossesArea(const Box3F &area)
+	/// @brief Checks if any remaining part of the path is within the
+	///        area.
+	///
+	/// @param area world box to check.
+	/// @return true if the path crosses the area.
+	//-------------------------------------------------------------------
+	bool crossesArea(const Box3F &area);
+
+	//-------------------------------------------------------------------
+	/// @fn static U32 invalidatePaths(const Box3F &area)
+	/// @brief Flags every handle with a path crossing the area as
+	///        invalidated and calls onPathInvalidated() on each owner.
+	///
+	/// @param area world box where the pathmap changed.
+	/// @return U32 number of paths invalidated.
+	//-------------------------------------------------------------------
+	static U32 invalidatePaths(const Box3F &area);
+
+	//-------------------------------------------------------------------
+	/// @fn static bool isAreaInUse(const Box3F &area)
+	/// @brief Checks if any handle's path crosses the area, so the
+	///        nodes there must stay in memory.
+	///
+	/// @param area world box to check.
+	/// @return true if a path crosses the area.
+	//-------------------------------------------------------------------
+	static bool isAreaInUse(const Box3F &area);
+
+	//-------------------------------------------------------------------
+	/// @fn static void flushCache()
+	/// @brief Empties the cache of found paths. Must be called whenever
+	///        the pathmap, its obstacles or its cost profiles change.
+	//-------------------------------------------------------------------
+	static void flushCache();
+
+protected:
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathHandle()
+	/// @brief Default constructor; handles come from create().
+	//-------------------------------------------------------------------
+	iAIPathHandle();
+
+	//-------------------------------------------------------------------
+	/// @fn void setBuffer(Buffer *buffer)
+	/// @brief Follows a new buffer from its start, letting go of the old.
+	///
+	/// @param buffer buffer to hold, or 0 for none.
+	//-------------------------------------------------------------------
+	void setBuffer(Buffer *buffer);
+
+	//-------------------------------------------------------------------
+	/// @fn static void releaseBuffer(Buffer *buffer)
+	/// @brief Drops a reference to a buffer, deleting it with the last.
+	//-------------------------------------------------------------------
+	static void releaseBuffer(Buffer *buffer);
+
+	//-------------------------------------------------------------------
+	/// @fn static Buffer* newBuffer(const Vector<iAIPathNode*> &nodeList)
+	/// @brief Allocates an empty buffer for a path over the nodes,
+	///        recording their ids.
+	//-------------------------------------------------------------------
+	static Buffer* newBuffer(const Vector<iAIPathNode*> &nodeList);
+
+	//-------------------------------------------------------------------
+	/// @fn void releaseRoute(const U32 end)
+	/// @brief Takes the route's nodes up to, not including, end out of
+	///        the crowd density.
+	///
+	/// @param end index in the buffer's mNodeIds.
+	//-------------------------------------------------------------------
+	void releaseRoute(const U32 end);
+
+	//-------------------------------------------------------------------
+	/// @fn bool findEndNodes(iAIPathMap* pathMap, const Point3F &start,
+	///                       const Point3F &end,
+	///                       iAIPathNode *&startNode,
+	///                       iAIPathNode *&endNode)
+	/// @brief Finds the nodes closest to either end of a path, once the
+	///        tiles they're on are in memory.
+	///
+	/// @return false if there are no nodes; or if waiting on tiles, with
+	///         mPending set.
+	//-------------------------------------------------------------------
+	bool findEndNodes(iAIPathMap* pathMap, const Point3F &start, const Point3F &end, iAIPathNode *&startNode, iAIPathNode *&endNode);
+
+	//-------------------------------------------------------------------
+	/// @var Buffer* mBuffer
+	/// @brief Positions of the path, shared with other handles; 0 if
+	///        none.
+	//-------------------------------------------------------------------
+	Buffer* mBuffer;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mCursor
+	/// @brief Index in the buffer of the next position; everything
+	///        before it has been visited.
+	//-------------------------------------------------------------------
+	U32 mCursor;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mRouteReleased
+	/// @brief Index in the buffer's mNodeIds of the first node still
+	///        counted in the crowd density.
+	//-------------------------------------------------------------------
+	U32 mRouteReleased;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mRouteGeneration
+	/// @brief iAIPathDensity generation the route was counted in.
+	//-------------------------------------------------------------------
+	U32 mRouteGeneration;
+
+	//-------------------------------------------------------------------
+	/// @var bool mCooperative
+	/// @brief Set while the path holds reservations in
+	///        iAIPathReservation.
+	//-------------------------------------------------------------------
+	bool mCooperative;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mReplanAt
+	/// @brief Index in the buffer of the position past which the next
+	///        cooperative path is due, or U32_MAX if never.
+	//-------------------------------------------------------------------
+	U32 mReplanAt;
+
+	//-------------------------------------------------------------------
+	/// @var bool mTraversing
+	/// @brief Used to set a flag if the getNextPosition has been called
+	///        previously or not.
+	//-------------------------------------------------------------------
+	bool mTraversing;
+
+	//-------------------------------------------------------------------
+	/// @var Point3F mLastPosition
+	/// @brief The last position which was returned, or
+	///        IAIPATHGLOBAL_INVALID_POSITION if none.
+	//-------------------------------------------------------------------
+	Point3F mLastPosition;
+
+	//-------------------------------------------------------------------
+	/// @var Point3F mGoal
+	/// @brief Position the path was created to reach.
+	//-------------------------------------------------------------------
+	Point3F mGoal;
+
+	//-------------------------------------------------------------------
+	/// @var bool mInvalidated
+	/// @brief Set when the pathmap changes under the path.
+	//-------------------------------------------------------------------
+	bool mInvalidated;
+
+	//-------------------------------------------------------------------
+	/// @var bool mPending
+	/// @brief Set when createPath is waiting on tiles to be paged in.
+	//-------------------------------------------------------------------
+	bool mPending;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mOwnerId
+	/// @brief Sim id of the object told of changes to the path; 0 if
+	///        none.
+	//-------------------------------------------------------------------
+	U32 mOwnerId;
+
+	//-------------------------------------------------------------------
+	/// @var static Vector<iAIPathHandle*> smActiveHandles
+	/// @brief Every handle taken from the pool.
+	//-------------------------------------------------------------------
+	static Vector<iAIPathHandle*> smActiveHandles;
+
+	//-------------------------------------------------------------------
+	/// @var static Vector<iAIPathHandle*> smFreeHandles
+	/// @brief Handles given back, ready to be taken again.
+	//-------------------------------------------------------------------
+	static Vector<iAIPathHandle*> smFreeHandles;
+
+	//-------------------------------------------------------------------
+	/// @struct CacheEntry
+	/// @brief A found path and what it was found for.
+	//-------------------------------------------------------------------
+	struct CacheEntry
+	{
+		U32 mStartId;						///< id of the start node
+		U32 mGoalId;						///< id of the goal node
+		F32 mRadius;						///< radius the path was fitted to
+		const iAIPathProfile *mProfile;		///< cost profile, 0 for the baked costs
+		bool mSmooth;						///< pulled tight, or visiting every node
+		Buffer *mBuffer;					///< the path; holds a reference
+	};
+
+	//-------------------------------------------------------------------
+	/// @var static Vector<CacheEntry> smCache
+	/// @brief Recently found paths, up to IAIPATHGLOBAL_PATH_CACHE_SIZE.
+	//-------------------------------------------------------------------
+	static Vector<CacheEntry> smCache;
+
+	//-------------------------------------------------------------------
+	/// @var static U32 smCacheNext
+	/// @brief Entry of the full cache replaced next.
+	//-------------------------------------------------------------------
+	static U32 smCacheNext;
+};
+
+#endif
@@ -0,0 +1,371 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathIndex
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+#include "platform/profiler.h"
+#include "math/mBox.h"
+
+#include "iAIPathIndex.h"
+#include "iAIPathNode.h"
+
+iAIPathIndex::iAIPathIndex()
+{
+	this->mBounds = Box3F(0,0,0, 0,0,0);
+	this->mCellSize = IAIPATHINDEX_CELL_SIZE;
+	this->mRegionReach = 0.0f;
+	this->mCellsX = 0;
+	this->mCellsY = 0;
+}
+
+iAIPathIndex::~iAIPathIndex()
+{
+	this->clear();
+}
+
+void iAIPathIndex::clear()
+{
+	this->mNodes.clear();
+	this->mPositions.clear();
+	this->mCellStart.clear();
+	this->mBounds = Box3F(0,0,0, 0,0,0);
+	this->mCellSize = IAIPATHINDEX_CELL_SIZE;
+	this->mRegionReach = 0.0f;
+	this->mCellsX = 0;
+	this->mCellsY = 0;
+}
+
+inline S32 iAIPathIndex::getCellX(const F32 x) const
+{
+	S32 cell = (S32)mFloor((x - this->mBounds.min.x) / this->mCellSize);
+	if (cell < 0)
+		return 0;
+	if (cell >= this->mCellsX)
+		return this->mCellsX - 1;
+	return cell;
+}
+
+inline S32 iAIPathIndex::getCellY(const F32 y) const
+{
+	S32 cell = (S32)mFloor((y - this->mBounds.min.y) / this->mCellSize);
+	if (cell < 0)
+		return 0;
+	if (cell >= this->mCellsY)
+		return this->mCellsY - 1;
+	return cell;
+}
+
+void iAIPathIndex::build(const Vector<iAIPathNode*> &nodes)
+{
+	PROFILE_SCOPE(iAIPathIndex_build);
+
+	this->clear();
+
+	if (nodes.size() == 0)
+		return;
+
+	// find the bounds of all the nodes
+	this->mBounds.min = nodes[0]->mPosition;
+	this->mBounds.max = nodes[0]->mPosition;
+	for (U32 i = 1; i < nodes.size(); ++i)
+	{
+		this->mBounds.min.setMin(nodes[i]->mPosition);
+		this->mBounds.max.setMax(nodes[i]->mPosition);
+	}
+
+	// and how far the biggest region reaches out from its node
+	for (U32 i = 0; i < nodes.size(); ++i)
+	{
+		Box3F region = nodes[i]->getRegionBox();
+		const Point3F &position = nodes[i]->mPosition;
+		this->mRegionReach = getMax(this->mRegionReach, getMax(position.x - region.min.x, region.max.x - position.x));
+		this->mRegionReach = getMax(this->mRegionReach, getMax(position.y - region.min.y, region.max.y - position.y));
+	}
+
+	// grow the cell size if the map is too large for the cell limit
+	F32 longestSide = getMax(this->mBounds.len_x(), this->mBounds.len_y());
+	this->mCellSize = getMax(IAIPATHINDEX_CELL_SIZE, longestSide / IAIPATHINDEX_MAX_CELLS);
+
+	this->mCellsX = (S32)(this->mBounds.len_x() / this->mCellSize) + 1;
+	this->mCellsY = (S32)(this->mBounds.len_y() / this->mCellSize) + 1;
+
+	// count the nodes in each cell
+	U32 cellCount = this->mCellsX * this->mCellsY;
+	this->mCellStart.setSize(cellCount + 1);
+	dMemset(this->mCellStart.address(), 0, sizeof(U32) * (cellCount + 1));
+
+	Vector<U32> nodeCell;
+	nodeCell.setSize(nodes.size());
+	for (U32 i = 0; i < nodes.size(); ++i)
+	{
+		nodeCell[i] = this->getCellY(nodes[i]->mPosition.y) * this->mCellsX + this->getCellX(nodes[i]->mPosition.x);
+		++this->mCellStart[nodeCell[i] + 1];
+	}
+
+	// turn the counts into offsets
+	for (U32 i = 1; i <= cellCount; ++i)
+		this->mCellStart[i] += this->mCellStart[i - 1];
+
+	// scatter the nodes into their cells
+	Vector<U32> cellFill;
+	cellFill.setSize(cellCount);
+	dMemcpy(cellFill.address(), this->mCellStart.address(), sizeof(U32) * cellCount);
+
+	this->mNodes.setSize(nodes.size());
+	this->mPositions.setSize(nodes.size());
+	for (U32 i = 0; i < nodes.size(); ++i)
+	{
+		U32 slot = cellFill[nodeCell[i]]++;
+		this->mNodes[slot] = nodes[i];
+		this->mPositions[slot] = nodes[i]->mPosition;
+	}
+}
+
+F32 iAIPathIndex::getRingClearance(const Point3F &position, const S32 cellX, const S32 cellY, const S32 ring) const
+{
+	F32 clearance = 1.0e10f;
+
+	// only sides which still have cells beyond them limit the search
+	if (cellX - ring > 0)
+		clearance = getMin(clearance, position.x - (this->mBounds.min.x + (cellX - ring) * this->mCellSize));
+	if (cellX + ring < this->mCellsX - 1)
+		clearance = getMin(clearance, (this->mBounds.min.x + (cellX + ring + 1) * this->mCellSize) - position.x);
+	if (cellY - ring > 0)
+		clearance = getMin(clearance, position.y - (this->mBounds.min.y + (cellY - ring) * this->mCellSize));
+	if (cellY + ring < this->mCellsY - 1)
+		clearance = getMin(clearance, (this->mBounds.min.y + (cellY + ring + 1) * this->mCellSize) - position.y);
+
+	return clearance;
+}
+
+iAIPathNode* iAIPathIndex::findClosest(const Point3F &position) const
+{
+	PROFILE_SCOPE(iAIPathIndex_findClosest);
+
+	if (this->isEmpty())
+		return 0;
+
+	S32 cellX = this->getCellX(position.x);
+	S32 cellY = this->getCellY(position.y);
+	S32 maxRing = getMax(getMax(cellX, this->mCellsX - 1 - cellX), getMax(cellY, this->mCellsY - 1 - cellY));
+
+	F32 closestSq = 1.0e20f;
+	S32 closestIdx = -1;
+
+	// search outwards ring by ring
+	for (S32 ring = 0; ring <= maxRing; ++ring)
+	{
+		for (S32 y = cellY - ring; y <= cellY + ring; ++y)
+		{
+			if ((y < 0) || (y >= this->mCellsY))
+				continue;
+
+			// only the edge of the ring is new, step across the middle rows
+			S32 step = ((y == cellY - ring) || (y == cellY + ring)) ? 1 : getMax(2 * ring, 1);
+			for (S32 x = cellX - ring; x <= cellX + ring; x += step)
+			{
+				if ((x < 0) || (x >= this->mCellsX))
+					continue;
+
+				U32 cell = y * this->mCellsX + x;
+				for (U32 i = this->mCellStart[cell]; i < this->mCellStart[cell + 1]; ++i)
+				{
+					F32 distSq = (this->mPositions[i] - position).lenSquared();
+					if (distSq < closestSq)
+					{
+						closestSq = distSq;
+						closestIdx = i;
+					}
+				}
+			}
+		}
+
+		// stop once nothing beyond this ring could be closer
+		if (closestIdx >= 0)
+		{
+			F32 clearance = this->getRingClearance(position, cellX, cellY, ring);
+			if ((clearance > 0.0f) && (closestSq <= clearance * clearance))
+				break;
+		}
+	}
+
+	return (closestIdx >= 0) ? this->mNodes[closestIdx] : 0;
+}
+
+U32 iAIPathIndex::findClosest(const Point3F &position, const U32 count, Vector<iAIPathNode*> &replyList) const
+{
+	PROFILE_SCOPE(iAIPathIndex_findClosestCount);
+
+	replyList.clear();
+	if ((this->isEmpty()) || (count == 0))
+		return 0;
+
+	S32 cellX = this->getCellX(position.x);
+	S32 cellY = this->getCellY(position.y);
+	S32 maxRing = getMax(getMax(cellX, this->mCellsX - 1 - cellX), getMax(cellY, this->mCellsY - 1 - cellY));
+
+	// best nodes so far, kept sorted closest first
+	Vector<F32> bestSq;
+	Vector<U32> bestIdx;
+
+	for (S32 ring = 0; ring <= maxRing; ++ring)
+	{
+		for (S32 y = cellY - ring; y <= cellY + ring; ++y)
+		{
+			if ((y < 0) || (y >= this->mCellsY))
+				continue;
+
+			S32 step = ((y == cellY - ring) || (y == cellY + ring)) ? 1 : getMax(2 * ring, 1);
+			for (S32 x = cellX - ring; x <= cellX + ring; x += step)
+			{
+				if ((x < 0) || (x >= this->mCellsX))
+					continue;
+
+				U32 cell = y * this->mCellsX + x;
+				for (U32 i = this->mCellStart[cell]; i < this->mCellStart[cell + 1]; ++i)
+				{
+					F32 distSq = (this->mPositions[i] - position).lenSquared();
+
+					// skip if the list is full and this one is further than the worst
+					if ((bestSq.size() == count) && (distSq >= bestSq.last()))
+						continue;
+
+					// insertion sort into the best list
+					if (bestSq.size() < count)
+					{
+						bestSq.push_back(distSq);
+						bestIdx.push_back(i);
+					} else
+					{
+						bestSq.last() = distSq;
+						bestIdx.last() = i;
+					}
+
+					for (S32 j = bestSq.size() - 1; (j > 0) && (bestSq[j] < bestSq[j - 1]); --j)
+					{
+						F32 tempSq = bestSq[j];
+						bestSq[j] = bestSq[j - 1];
+						bestSq[j - 1] = tempSq;
+
+						U32 tempIdx = bestIdx[j];
+						bestIdx[j] = bestIdx[j - 1];
+						bestIdx[j - 1] = tempIdx;
+					}
+				}
+			}
+		}
+
+		// stop once the list is full and nothing beyond could be closer
+		if (bestSq.size() == count)
+		{
+			F32 clearance = this->getRingClearance(position, cellX, cellY, ring);
+			if ((clearance > 0.0f) && (bestSq.last() <= clearance * clearance))
+				break;
+		}
+	}
+
+	for (U32 i = 0; i < bestIdx.size(); ++i)
+		replyList.push_back(this->mNodes[bestIdx[i]]);
+
+	return replyList.size();
+}
+
+U32 iAIPathIndex::findInRadius(const Point3F &position, const F32 radius, Vector<iAIPathNode*> &replyList) const
+{
+	PROFILE_SCOPE(iAIPathIndex_findInRadius);
+
+	replyList.clear();
+	if ((this->isEmpty()) || (radius <= 0.0f))
+		return 0;
+
+	// cells overlapping the radius
+	S32 startX = this->getCellX(position.x - radius);
+	S32 endX = this->getCellX(position.x + radius);
+	S32 startY = this->getCellY(position.y - radius);
+	S32 endY = this->getCellY(position.y + radius);
+	F32 radiusSq = radius * radius;
+
+	for (S32 y = startY; y <= endY; ++y)
+	{
+		for (S32 x = startX; x <= endX; ++x)
+		{
+			U32 cell = y * this->mCellsX + x;
+			for (U32 i = this->mCellStart[cell]; i < this->mCellStart[cell + 1]; ++i)
+			{
+				if ((this->mPositions[i] - position).lenSquared() <= radiusSq)
+					replyList.push_back(this->mNodes[i]);
+			}
+		}
+	}
+
+	return replyList.size();
+}
+
+U32 iAIPathIndex::findInArea(const Box3F &area, Vector<iAIPathNode*> &replyList) const
+{
+	PROFILE_SCOPE(iAIPathIndex_findInArea);
+
+	replyList.clear();
+	if (this->isEmpty())
+		return 0;
+
+	// cells overlapping the area
+	S32 startX = this->getCellX(area.min.x);
+	S32 endX = this->getCellX(area.max.x);
+	S32 startY = this->getCellY(area.min.y);
+	S32 endY = this->getCellY(area.max.y);
+
+	for (S32 y = startY; y <= endY; ++y)
+	{
+		for (S32 x = startX; x <= endX; ++x)
+		{
+			U32 cell = y * this->mCellsX + x;
+			for (U32 i = this->mCellStart[cell]; i < this->mCellStart[cell + 1]; ++i)
+			{
+				const Point3F &position = this->mPositions[i];
+				if ((position.x >= area.min.x) && (position.x <= area.max.x) &&
+					(position.y >= area.min.y) && (position.y <= area.max.y))
+					replyList.push_back(this->mNodes[i]);
+			}
+		}
+	}
+
+	return replyList.size();
+}
+
+U32 iAIPathIndex::findOverlapping(const Box3F &area, Vector<iAIPathNode*> &replyList) const
+{
+	PROFILE_SCOPE(iAIPathIndex_findOverlapping);
+
+	replyList.clear();
+	if (this->isEmpty())
+		return 0;
+
+	// nodes whose region could reach into the area
+	S32 startX = this->getCellX(area.min.x - this->mRegionReach);
+	S32 endX = this->getCellX(area.max.x + this->mRegionReach);
+	S32 startY = this->getCellY(area.min.y - this->mRegionReach);
+	S32 endY = this->getCellY(area.max.y + this->mRegionReach);
+
+	for (S32 y = startY; y <= endY; ++y)
+	{
+		for (S32 x = startX; x <= endX; ++x)
+		{
+			U32 cell = y * this->mCellsX + x;
+			for (U32 i = this->mCellStart[cell]; i < this->mCellStart[cell + 1]; ++i)
+			{
+				const Point3F &position = this->mPositions[i];
+				if ((position.x < area.min.x - this->mRegionReach) || (position.x > area.max.x + this->mRegionReach) ||
+					(position.y < area.min.y - this->mRegionReach) || (position.y > area.max.y + this->mRegionReach))
+					continue;
+
+				Box3F region = this->mNodes[i]->getRegionBox();
+				if ((region.min.x <= area.max.x) && (region.max.x >= area.min.x) &&
+					(region.min.y <= area.max.y) && (region.max.y >= area.min.y))
+					replyList.push_back(this->mNodes[i]);
+			}
+		}
+	}
+
+	return replyList.size();
+}
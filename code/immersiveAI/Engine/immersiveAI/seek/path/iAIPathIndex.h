@@ -0,0 +1,226 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathIndex
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+//-------------------------------------------------------------------
+/// @file iAIPathIndex.h
+//-------------------------------------------------------------------
+/// @class iAIPathIndex
+/// @author Gavin Bunney
+/// @version 1.0
+/// @brief Spatial index over every node in the pathmap.
+///
+/// Buckets node positions into a uniform grid of cells in X & Y,
+/// independent of which iAIPathGrid the nodes belong to. Answers
+/// nearest node, k-nearest and radius queries without casting rays
+/// against the server container.
+//-------------------------------------------------------------------
+#ifndef _IAIPATHINDEX_H_
+#define _IAIPATHINDEX_H_
+
+#include "iAIPathNode.h"
+
+//-------------------------------------------------------------------
+/// @def IAIPATHINDEX_CELL_SIZE
+/// @brief Size, in world units, of a single index cell in X & Y.
+//-------------------------------------------------------------------
+#define IAIPATHINDEX_CELL_SIZE			8.0f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHINDEX_MAX_CELLS
+/// @brief Upper bound on the number of cells in either axis. The
+///        cell size is grown to fit very large maps.
+//-------------------------------------------------------------------
+#define IAIPATHINDEX_MAX_CELLS			1024
+
+class iAIPathIndex {
+
+public:
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathIndex()
+	/// @brief Default constructor.
+	//-------------------------------------------------------------------
+	iAIPathIndex();
+
+	//-------------------------------------------------------------------
+	/// @fn ~iAIPathIndex()
+	/// @brief Default deconstructor.
+	//-------------------------------------------------------------------
+	~iAIPathIndex();
+
+	//-------------------------------------------------------------------
+	/// @fn void build(const Vector<iAIPathNode*> &nodes)
+	/// @brief Builds the index over the parsed nodes, replacing any
+	///        previous contents.
+	///
+	/// @param nodes Vector of all nodes to index.
+	//-------------------------------------------------------------------
+	void build(const Vector<iAIPathNode*> &nodes);
+
+	//-------------------------------------------------------------------
+	/// @fn void clear()
+	/// @brief Empties the index.
+	//-------------------------------------------------------------------
+	void clear();
+
+	//-------------------------------------------------------------------
+	/// @fn bool isEmpty() const
+	/// @brief Checks if the index holds any nodes.
+	///
+	/// @return True if no nodes are indexed.
+	//-------------------------------------------------------------------
+	bool isEmpty() const { return (this->mNodes.size() == 0); }
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getNodeCount() const
+	/// @brief Retrieves the number of indexed nodes.
+	///
+	/// @return U32 Number of nodes in the index.
+	//-------------------------------------------------------------------
+	U32 getNodeCount() const { return this->mNodes.size(); }
+
+	//-------------------------------------------------------------------
+	/// @fn const Box3F& getBounds() const
+	/// @brief Retrieves the box encompassing all indexed nodes.
+	///
+	/// @return Box3F Bounds of the index.
+	//-------------------------------------------------------------------
+	const Box3F& getBounds() const { return this->mBounds; }
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathNode* findClosest(const Point3F &position) const
+	/// @brief Finds the node closest to the parsed position, no matter
+	///        how far away it is.
+	///
+	/// @param position World point to search around.
+	/// @return Pointer to the closest node, 0 if the index is empty.
+	//-------------------------------------------------------------------
+	iAIPathNode* findClosest(const Point3F &position) const;
+
+	//-------------------------------------------------------------------
+	/// @fn U32 findClosest(const Point3F &position, const U32 count,
+	///                     Vector<iAIPathNode*> &replyList) const
+	/// @brief Finds the k closest nodes to the parsed position, sorted
+	///        from closest to furthest.
+	///
+	/// @param position World point to search around.
+	/// @param count Number of nodes to find.
+	/// @param replyList Vector to place the found nodes in.
+	/// @return U32 Number of nodes found.
+	//-------------------------------------------------------------------
+	U32 findClosest(const Point3F &position, const U32 count, Vector<iAIPathNode*> &replyList) const;
+
+	//-------------------------------------------------------------------
+	/// @fn U32 findInRadius(const Point3F &position, const F32 radius,
+	///                      Vector<iAIPathNode*> &replyList) const
+	/// @brief Finds all nodes within the parsed radius of a position.
+	///
+	/// @param position World point to search around.
+	/// @param radius Radius of the search sphere.
+	/// @param replyList Vector to place the found nodes in.
+	/// @return U32 Number of nodes found.
+	//-------------------------------------------------------------------
+	U32 findInRadius(const Point3F &position, const F32 radius, Vector<iAIPathNode*> &replyList) const;
+
+	//-------------------------------------------------------------------
+	/// @fn U32 findInArea(const Box3F &area,
+	///                    Vector<iAIPathNode*> &replyList) const
+	/// @brief Finds all nodes within the area in X & Y, at any height.
+	///
+	/// @param area World box to search; its Z extent is ignored.
+	/// @param replyList Vector to place the found nodes in.
+	/// @return U32 Number of nodes found.
+	//-------------------------------------------------------------------
+	U32 findInArea(const Box3F &area, Vector<iAIPathNode*> &replyList) const;
+
+	//-------------------------------------------------------------------
+	/// @fn U32 findOverlapping(const Box3F &area,
+	///                         Vector<iAIPathNode*> &replyList) const
+	/// @brief Finds all nodes whose region overlaps the area in X & Y,
+	///        at any height. Unlike findInArea, a merged region is found
+	///        even if the area misses the node at its middle.
+	///
+	/// @param area World box to search; its Z extent is ignored.
+	/// @param replyList Vector to place the found nodes in.
+	/// @return U32 Number of nodes found.
+	//-------------------------------------------------------------------
+	U32 findOverlapping(const Box3F &area, Vector<iAIPathNode*> &replyList) const;
+
+private:
+
+	//-------------------------------------------------------------------
+	/// @fn inline S32 getCellX(const F32 x) const
+	/// @brief Converts a world X coordinate into a cell column.
+	//-------------------------------------------------------------------
+	inline S32 getCellX(const F32 x) const;
+
+	//-------------------------------------------------------------------
+	/// @fn inline S32 getCellY(const F32 y) const
+	/// @brief Converts a world Y coordinate into a cell row.
+	//-------------------------------------------------------------------
+	inline S32 getCellY(const F32 y) const;
+
+	//-------------------------------------------------------------------
+	/// @fn F32 getRingClearance(const Point3F &position, const S32 cellX,
+	///                          const S32 cellY, const S32 ring) const
+	/// @brief Distance in X & Y from the position to the outside of the
+	///        block of cells searched so far. Any node further than the
+	///        current best beyond this distance can be ignored.
+	//-------------------------------------------------------------------
+	F32 getRingClearance(const Point3F &position, const S32 cellX, const S32 cellY, const S32 ring) const;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<iAIPathNode*> mNodes
+	/// @brief Indexed nodes, sorted by cell.
+	//-------------------------------------------------------------------
+	Vector<iAIPathNode*> mNodes;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<Point3F> mPositions
+	/// @brief Positions of the nodes in mNodes, kept contiguous so the
+	///        distance checks don't touch the nodes themselves.
+	//-------------------------------------------------------------------
+	Vector<Point3F> mPositions;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<U32> mCellStart
+	/// @brief Offset into mNodes of the first node of each cell. Holds
+	///        one extra entry so a cell's count is start[i+1]-start[i].
+	//-------------------------------------------------------------------
+	Vector<U32> mCellStart;
+
+	//-------------------------------------------------------------------
+	/// @var Box3F mBounds
+	/// @brief Box encompassing all the indexed nodes.
+	//-------------------------------------------------------------------
+	Box3F mBounds;
+
+	//-------------------------------------------------------------------
+	/// @var F32 mCellSize
+	/// @brief Size of a cell in world units.
+	//-------------------------------------------------------------------
+	F32 mCellSize;
+
+	//-------------------------------------------------------------------
+	/// @var F32 mRegionReach
+	/// @brief Furthest any node's region reaches from the node in X or
+	///        Y; how far beyond an area to look for overlapping regions.
+	//-------------------------------------------------------------------
+	F32 mRegionReach;
+
+	//-------------------------------------------------------------------
+	/// @var S32 mCellsX
+	/// @brief Number of cells in X.
+	//-------------------------------------------------------------------
+	S32 mCellsX;
+
+	//-------------------------------------------------------------------
+	/// @var S32 mCellsY
+	/// @brief Number of cells in Y.
+	//-------------------------------------------------------------------
+	S32 mCellsY;
+};
+
+#endif
@@ -1,191 +1,1886 @@
-//-------------------------------------------------------------------
-// Immersive AI :: Seek :: iAIPathMap
-// Copyright (c) 2006 Gavin Bunney & Tom Romano
-//-------------------------------------------------------------------
-
-#include "game/missionArea.h"
-#include "platform/profiler.h"
-#include "terrain/terrData.h"
-#include "game/gameConnection.h"
-#include "interior/interiorInstance.h"
-
-#include "iAIPathMap.h"
-#include "iAIPathGlobal.h"
-#include "iAIPathGrid.h"
-#include "iAIPathNode.h"
-
-IMPLEMENT_CONOBJECT(iAIPathMap);
-
-U32 iAIPathMap::smNodeCount = 0;
-
-iAIPathMap::iAIPathMap()
-{
-	this->mCompiled = false;
-	this->mTerrainGridIndex = 0;
-}
-
-iAIPathMap::~iAIPathMap()
-{
-	this->clearMap();
-}
-
-bool iAIPathMap::initialize()
-{
-	// if not compiled, create the path map
-	if (!this->mCompiled)
-	{
-		// create a new pathmap
-		this->mCompiled = this->createPathMap();
-	}
-	return this->mCompiled;
-}
-
-bool iAIPathMap::createPathMap()
-{
-	Con::iAIMessagef("Immersive AI :: Seek :: Building PathMap...");
-
-	// clear any current path map
-	this->clearMap();
-
-	// generate an avoid list of all the grids
-	Vector<Box3F> avoidList;
-	for (U32 i = 0; i < this->mGrids.size(); ++i)
-		avoidList.push_back(this->mGrids[i]->getWorldBox());
-
-	// calculate the entire mission area
-	MissionArea *missionAreaPtr = dynamic_cast<MissionArea*>(Sim::findObject("MissionArea"));
-	if (!missionAreaPtr)
-		return false;
-
-	// set grid points are the initial mission area points in x&y to the extent of the mission area
-	Point3F gridStart = Point3F(missionAreaPtr->getArea().point.x, missionAreaPtr->getArea().point.y, 100.0);
-	Point3F gridEnd = Point3F(missionAreaPtr->getArea().point.x + missionAreaPtr->getArea().extent.x, missionAreaPtr->getArea().point.y + missionAreaPtr->getArea().extent.y, 100.0);
-
-	// pointer for the terrain grid
-	iAIPathGrid *terrainGrid = new iAIPathGrid();
-
-	// generate a grid for the terrain, avoiding the avoid list
-	if (terrainGrid->createTerrainGrid(gridStart, gridEnd, avoidList, IAIPATHGLOBAL_GRID_DENSITY_TERRAIN))
-	{
-		// add to pathmap collection
-		this->mGrids.push_back(terrainGrid);
-
-		// set the type of the terrain grid to just a zone type;
-		// needed to optimise the getClosestNode function
-		// (so we don't always get the terrain grid as the collided grid!)
-		terrainGrid->mTypeMask |= PhysicalZoneObjectType;
-
-		// add grid to the scene
-		terrainGrid->registerObject();
-
-		// set the terrain grid index variable
-		this->mTerrainGridIndex = this->mGrids.size() - 1;
-	}
-
-	// iterate over all grids to calculate total node count
-	for (U32 i = 0; i < this->mGrids.size(); ++i)
-		iAIPathMap::smNodeCount += this->mGrids[i]->mNodes.size();
-
-	Con::iAIMessagef("Immersive AI :: Seek :: PathMap Built!");
-	return true;
-}
-
-void iAIPathMap::clearMap()
-{
-	// iterate over nodes and delete all
-	for (U32 i = 0; i < this->mGrids.size(); ++i)
-	{
-		if ((this->mGrids[i]) && (!this->mGrids[i]->isDeleted()))
-			this->mGrids[i]->deleteObject();
-		this->mGrids[i] = 0;
-	}
-
-	// set as uncompiled
-	this->mCompiled = false;
-	this->mTerrainGridIndex = 0;
-	iAIPathMap::smNodeCount = 0;
-}
-
-void iAIPathMap::toggleDisplay()
-{
-	// iterate over all grids
-	for (U32 i = 0; i < this->mGrids.size(); ++i)
-	{
-		// toggle the display
-		this->mGrids[i]->toggleDisplay();
-	}
-}
-
-iAIPathNode* iAIPathMap::getClosestNode(const Point3F position)
-{
-	PROFILE_SCOPE(iAIPathMap_getClosestNode);
-	iAIPathNode* closestNode = 0;
-
-	RayInfo rInfo;
-
-	// set the ray well above & below terrain
-	Point3F start = Point3F(position.x, position.y, position.z + 1000.0f);
-	Point3F end = Point3F(position.x, position.y, position.z - 1000.0f);
-
-	// see what grid node is in
-	if (gServerContainer.castRay(position, end, iAIPathGridObjectType, &rInfo))
-	{
-		// cast the found grid and find its closest node
-		if (iAIPathGrid* collidedGrid = dynamic_cast<iAIPathGrid*>(rInfo.object))
-			closestNode = collidedGrid->getClosestNode(position);
-	} else
-	{
-		// not in a grid, must be in terrain grid!
-		closestNode = this->mGrids[this->mTerrainGridIndex]->getClosestNode(position);
-	}
-
-	return closestNode;
-}
-
-ConsoleMethodGroupBegin(iAIPathMap, ScriptFunctions, "iAIPathMap Script Functions");
-
-ConsoleMethod( iAIPathMap, initialize, bool, 2, 2,
-			  "bool iAIPathMap.initialize() - Initializes the PathMap for the current mission.")
-{
-	return object->initialize();
-}
-
-ConsoleMethod( iAIPathMap, toggleDisplay, void, 2, 2,
-			  "void iAIPathMap.toggleDisplay() - Toggles displaying of the pathmap.")
-{
-	object->toggleDisplay();
-}
-
-ConsoleMethod( iAIPathMap, closestNode, const char *, 3, 3,
-			  "Point3F iAIPathMap.closestNode(Point3F pos) - Get the closest node to the supplied position.")
-{
-	// ensure pos passed
-	if (dStrlen(argv[2]) != 0) {
-
-		// pass the args into a Point3F
-		Point3F position;
-		dSscanf(argv[2], "%f %f %f", &position.x, &position.y, &position.z);
-
-		// get the closest node
-		iAIPathNode* closestNode = object->getClosestNode(position);
-
-		// ensure found a closest index
-		if (closestNode)
-		{
-			char *returnBuffer = Con::getReturnBuffer(256);
-			dSprintf(returnBuffer, 256, "%f %f %f", closestNode->mPosition.x, closestNode->mPosition.y, closestNode->mPosition.z);
-
-			return returnBuffer;
-		} else
-		{
-			Con::errorf("Immersive AI :: Seek :: PathMap - no node found near %f %f %f", &position.x, &position.y, &position.z);
-			return "";
-		}
-	} else
-	{
-		Con::errorf("Immersive AI :: Seek :: PathMap - no Point3F parsed to ClosestNode!");
-		return "";
-	}
-}
-
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathMap
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+#include "game/missionArea.h"
+#include "platform/profiler.h"
+#include "terrain/terrData.h"
+#include "game/gameConnection.h"
+#include "interior/interiorInstance.h"
+#include "math/mRandom.h"
+#include "math/mathIO.h"
+#include "core/fileStream.h"
+#include "core/memstream.h"
+#include "core/resManager.h"
+#include "core/crc.h"
+#include "platform/platformThread.h"
+
+#include "iAIPathMap.h"
+#include "iAIPathGlobal.h"
+#include "iAIPathGrid.h"
+#include "iAIPathNode.h"
+#include "iAIPathIndex.h"
+#include "iAIPathOverlay.h"
+#include "iAIPathProfile.h"
+#include "iAIPathCollision.h"
+#include "iAIPathHandle.h"
+#include "iAIPathDensity.h"
+#include "iAIPathReservation.h"
+
+IMPLEMENT_CONOBJECT(iAIPathMap);
+
+U32 iAIPathMap::smNodeCount = 0;
+
+//-------------------------------------------------------------------
+/// @class iAIPathMapBuildThread
+/// @brief Worker thread which compiles a grid for initializeAsync.
+//-------------------------------------------------------------------
+class iAIPathMapBuildThread : public Thread
+{
+public:
+
+	iAIPathMapBuildThread(iAIPathGrid *grid, volatile bool *done) : Thread(0, 0, false)
+	{
+		this->mGrid = grid;
+		this->mDone = done;
+	}
+
+	void run(S32 arg)
+	{
+		this->mGrid->compileGrid();
+		*this->mDone = true;
+	}
+
+private:
+
+	iAIPathGrid *mGrid;
+	volatile bool *mDone;
+};
+
+//-------------------------------------------------------------------
+/// @class iAIPathMapBuildEvent
+/// @brief Sim event which polls a background build.
+//-------------------------------------------------------------------
+class iAIPathMapBuildEvent : public SimEvent
+{
+public:
+
+	void process(SimObject *object)
+	{
+		static_cast<iAIPathMap*>(object)->updateBuild();
+	}
+};
+
+//-------------------------------------------------------------------
+/// @class iAIPathMapStreamEvent
+/// @brief Sim event which updates the tiles kept in memory.
+//-------------------------------------------------------------------
+class iAIPathMapStreamEvent : public SimEvent
+{
+public:
+
+	void process(SimObject *object)
+	{
+		static_cast<iAIPathMap*>(object)->updateStream();
+	}
+};
+
+iAIPathMap::iAIPathMap()
+{
+	this->mCompiled = false;
+	this->mTilesX = 0;
+	this->mTilesY = 0;
+	this->mTerrainNodesX = 0;
+	this->mTerrainNodesY = 0;
+	this->mTerrainOrigin = Point3F(0,0,0);
+	this->mTerrainStep = 0.0f;
+	this->mBuildStart = 0;
+	this->mBuildGrid = 0;
+	this->mBuildTile = 0;
+	this->mBuildThread = 0;
+	this->mBuildDone = false;
+	this->mBuildEvent = 0;
+	this->mBuildProgressReported = 0;
+	this->mBuildUseCache = false;
+	this->mBuildCacheFile = 0;
+	this->mBuildCacheKey = 0;
+	this->mStreamFile = 0;
+	this->mStreamKey = 0;
+	this->mStreamTick = 0;
+	this->mStreamEvent = 0;
+}
+
+iAIPathMap::~iAIPathMap()
+{
+	this->clearMap();
+	this->clearCostProfiles();
+}
+
+void iAIPathMap::onRemove()
+{
+	// mission is ending, stop any build
+	this->cancelBuild();
+
+	Parent::onRemove();
+}
+
+bool iAIPathMap::initialize()
+{
+	if (this->isBuilding())
+	{
+		Con::errorf("Immersive AI :: Seek :: PathMap - already building in the background!");
+		return false;
+	}
+
+	// if not compiled, create the path map
+	if (!this->mCompiled)
+	{
+		// lazy grids haven't validated their links, so have nothing worth caching
+		char fileName[1024];
+		bool useCache = Con::getBoolVariable("$iAIPathMap::useCache", true) && !Con::getBoolVariable("$iAIPathMap::lazyEdges", false) &&
+			this->getCacheFileName(fileName, sizeof(fileName));
+		U32 key = useCache ? this->getCacheKey() : 0;
+
+		// try the cache first
+		if (useCache)
+			this->mCompiled = this->loadPathMap(fileName, key);
+
+		if (!this->mCompiled)
+		{
+			// create a new pathmap
+			this->mCompiled = this->createPathMap();
+
+			// and save it for next time
+			if (this->mCompiled && useCache)
+				this->savePathMap(fileName, key);
+		}
+	}
+	return this->mCompiled;
+}
+
+bool iAIPathMap::initializeAsync()
+{
+	// already on the way
+	if (this->isBuilding())
+		return true;
+
+	if (!this->mCompiled)
+	{
+		char fileName[1024];
+		this->mBuildUseCache = Con::getBoolVariable("$iAIPathMap::useCache", true) && !Con::getBoolVariable("$iAIPathMap::lazyEdges", false) &&
+			this->getCacheFileName(fileName, sizeof(fileName));
+		this->mBuildCacheFile = this->mBuildUseCache ? StringTable->insert(fileName) : 0;
+		this->mBuildCacheKey = this->mBuildUseCache ? this->getCacheKey() : 0;
+
+		// try the cache first; it's quick enough to load right away
+		if (this->mBuildUseCache)
+			this->mCompiled = this->loadPathMap(this->mBuildCacheFile, this->mBuildCacheKey);
+
+		if (!this->mCompiled && this->prepareTerrainTiles())
+		{
+			this->mBuildProgressReported = 0;
+
+			// nothing on the terrain to build, so finish right away
+			if (!this->startTerrainTile())
+			{
+				this->mCompiled = this->finishPathMap();
+				if (this->mCompiled && this->mBuildUseCache)
+					this->savePathMap(this->mBuildCacheFile, this->mBuildCacheKey);
+			}
+		}
+	}
+
+	// poll the build, or just report back if there's nothing to build
+	this->mBuildEvent = Sim::postEvent(this, new iAIPathMapBuildEvent, Sim::getCurrentTime() + IAIPATHMAP_BUILD_POLL_TIME);
+	return true;
+}
+
+void iAIPathMap::updateBuild()
+{
+	this->mBuildEvent = 0;
+
+	if (this->mBuildThread)
+	{
+		if (!this->mBuildDone)
+		{
+			// report every 10%
+			U32 progress = (U32)(this->getBuildProgress() * 10.0f);
+			if (progress > this->mBuildProgressReported)
+			{
+				this->mBuildProgressReported = progress;
+				Con::iAIMessagef("Immersive AI :: Seek :: Building PathMap... %d%%", progress * 10);
+			}
+
+			this->mBuildEvent = Sim::postEvent(this, new iAIPathMapBuildEvent, Sim::getCurrentTime() + IAIPATHMAP_BUILD_POLL_TIME);
+			return;
+		}
+
+		this->mBuildThread->join();
+		delete this->mBuildThread;
+		this->mBuildThread = 0;
+
+		this->finishTerrainTile(this->mBuildGrid);
+		this->mBuildGrid = 0;
+
+		// on to the next tile
+		if (this->startTerrainTile())
+		{
+			this->mBuildEvent = Sim::postEvent(this, new iAIPathMapBuildEvent, Sim::getCurrentTime() + IAIPATHMAP_BUILD_POLL_TIME);
+			return;
+		}
+
+		this->mCompiled = this->finishPathMap();
+
+		// save it for next time
+		if (this->mCompiled && this->mBuildUseCache)
+			this->savePathMap(this->mBuildCacheFile, this->mBuildCacheKey);
+	}
+
+	Con::executef(this, 2, "onPathMapReady", this->mCompiled ? "1" : "0");
+}
+
+void iAIPathMap::cancelBuild()
+{
+	if (this->mBuildEvent)
+	{
+		Sim::cancelEvent(this->mBuildEvent);
+		this->mBuildEvent = 0;
+	}
+
+	if (!this->mBuildThread)
+		return;
+
+	// stop the workers
+	this->mBuildGrid->cancelBuild();
+
+	this->mBuildThread->join();
+	delete this->mBuildThread;
+	this->mBuildThread = 0;
+
+	// never registered, so just delete it
+	delete this->mBuildGrid;
+	this->mBuildGrid = 0;
+
+	Con::iAIMessagef("Immersive AI :: Seek :: PathMap build cancelled");
+}
+
+F32 iAIPathMap::getBuildProgress()
+{
+	// the tiles before the one being compiled are done
+	if (this->mBuildGrid)
+		return ((this->mBuildTile - 1) + this->mBuildGrid->getBuildProgress()) / (F32)getMax(this->mTilesX * this->mTilesY, (U32)1);
+
+	return this->mCompiled ? 1.0f : 0.0f;
+}
+
+bool iAIPathMap::createPathMap()
+{
+	if (!this->prepareTerrainTiles())
+		return false;
+
+	// build each tile right here
+	iAIPathGrid *tile;
+	while ((tile = this->prepareTerrainTile()) != 0)
+	{
+		tile->compileGrid();
+		this->finishTerrainTile(tile);
+	}
+
+	return this->finishPathMap();
+}
+
+bool iAIPathMap::prepareTerrainTiles()
+{
+	Con::iAIMessagef("Immersive AI :: Seek :: Building PathMap...");
+
+	this->mBuildStart = Platform::getRealMilliseconds();
+
+	// clear any current path map
+	this->clearMap();
+
+	// calculate the entire mission area
+	MissionArea *missionAreaPtr = dynamic_cast<MissionArea*>(Sim::findObject("MissionArea"));
+	if (!missionAreaPtr)
+		return false;
+
+	// set grid points are the initial mission area points in x&y to the extent of the mission area
+	Point3F gridStart = Point3F(missionAreaPtr->getArea().point.x, missionAreaPtr->getArea().point.y, 100.0);
+	Point3F gridEnd = Point3F(missionAreaPtr->getArea().point.x + missionAreaPtr->getArea().extent.x, missionAreaPtr->getArea().point.y + missionAreaPtr->getArea().extent.y, 100.0);
+
+	// find every interior within the mission area
+	Box3F missionBox(gridStart, gridEnd);
+	missionBox.min.z = -F32_MAX;
+	missionBox.max.z = F32_MAX;
+	Vector<Box3F> interiorBoxes;
+	gServerContainer.findObjects(missionBox, InteriorObjectType, iAIPathMap::interiorCallback, &interiorBoxes);
+
+	// interior grids are small, so build them right here
+	for (U32 i = 0; i < interiorBoxes.size(); ++i)
+	{
+		iAIPathGrid *interiorGrid = new iAIPathGrid();
+		if (interiorGrid->createInteriorGrid(interiorBoxes[i], IAIPATHGLOBAL_GRID_DENSITY_INTERIOR))
+			this->addGrid(interiorGrid);
+		else
+			delete interiorGrid;
+	}
+
+	// generate an avoid list of all the interiors; the terrain tiles still cover their buffers
+	this->mBuildAvoidList.clear();
+	for (U32 i = 0; i < this->mGrids.size(); ++i)
+		this->mBuildAvoidList.push_back(this->mGrids[i]->getInteriorBox());
+
+	// lay the terrain lattice over the area at the terrain density, then split it into tiles
+	F32 density = IAIPATHGLOBAL_GRID_DENSITY_TERRAIN / Con::getFloatVariable("Server::gridSize", 10.0f);
+	this->mTerrainOrigin = gridStart;
+	this->mTerrainStep = 1 / mSqrt(density);
+	this->mTerrainNodesX = (U32)((gridEnd.x - gridStart.x) * mSqrt(density));
+	this->mTerrainNodesY = (U32)((gridEnd.y - gridStart.y) * mSqrt(density));
+	this->mTilesX = (this->mTerrainNodesX + IAIPATHGLOBAL_GRID_TILE_SIZE - 1) / IAIPATHGLOBAL_GRID_TILE_SIZE;
+	this->mTilesY = (this->mTerrainNodesY + IAIPATHGLOBAL_GRID_TILE_SIZE - 1) / IAIPATHGLOBAL_GRID_TILE_SIZE;
+
+	// every grid must fit the high part of the node ids
+	if (((this->mTilesX * this->mTilesY) + this->mGrids.size()) > (1 << (32 - IAIPATHGLOBAL_NODE_ID_LOCAL_BITS)))
+	{
+		Con::errorf("Immersive AI :: Seek :: PathMap build failed - %d x %d tiles is too many!", this->mTilesX, this->mTilesY);
+		this->mTilesX = 0;
+		this->mTilesY = 0;
+		return false;
+	}
+
+	this->mTiles.setSize(this->mTilesX * this->mTilesY);
+	dMemset(this->mTiles.address(), 0, sizeof(iAIPathGrid*) * this->mTiles.size());
+	this->mBuildTile = 0;
+
+	return true;
+}
+
+iAIPathGrid* iAIPathMap::prepareTerrainTile()
+{
+	while (this->mBuildTile < this->mTiles.size())
+	{
+		U32 tile = this->mBuildTile++;
+
+		// lattice range of the tile within the whole terrain
+		U32 startX = (tile % this->mTilesX) * IAIPATHGLOBAL_GRID_TILE_SIZE;
+		U32 startY = (tile / this->mTilesX) * IAIPATHGLOBAL_GRID_TILE_SIZE;
+		U32 endX = getMin(startX + IAIPATHGLOBAL_GRID_TILE_SIZE, this->mTerrainNodesX);
+		U32 endY = getMin(startY + IAIPATHGLOBAL_GRID_TILE_SIZE, this->mTerrainNodesY);
+
+		Point3F tileStart = this->mTerrainOrigin + Point3F(startX * this->mTerrainStep, startY * this->mTerrainStep, 0);
+		Point3F tileEnd = this->mTerrainOrigin + Point3F(endX * this->mTerrainStep, endY * this->mTerrainStep, 0);
+
+		// size the grid for the tile, avoiding the interiors; compiled later
+		iAIPathGrid *grid = new iAIPathGrid();
+		grid->mMapTile = tile;
+		if (grid->prepareTerrainGrid(tileStart, tileEnd, this->mBuildAvoidList, IAIPATHGLOBAL_GRID_DENSITY_TERRAIN))
+			return grid;
+
+		delete grid;
+	}
+
+	return 0;
+}
+
+void iAIPathMap::finishTerrainTile(iAIPathGrid *tile)
+{
+	// only keep tiles with nodes
+	if (!tile->finishGrid())
+	{
+		delete tile;
+		return;
+	}
+
+	this->mTiles[tile->getMapTile()] = tile;
+	this->addGrid(tile);
+}
+
+bool iAIPathMap::startTerrainTile()
+{
+	this->mBuildGrid = this->prepareTerrainTile();
+	if (!this->mBuildGrid)
+		return false;
+
+	this->mBuildDone = false;
+	this->mBuildThread = new iAIPathMapBuildThread(this->mBuildGrid, &this->mBuildDone);
+	this->mBuildThread->start();
+	return true;
+}
+
+void iAIPathMap::addGrid(iAIPathGrid *grid)
+{
+	grid->mGridId = this->mGrids.size();
+	this->mGrids.push_back(grid);
+	grid->registerObject();
+}
+
+bool iAIPathMap::finishPathMap()
+{
+	// join the tiles to each other, then the interiors onto them
+	Box3F everywhere(Point3F(-F32_MAX, -F32_MAX, -F32_MAX), Point3F(F32_MAX, F32_MAX, F32_MAX));
+	U32 tileLinkCount = this->stitchTerrainTiles(everywhere);
+
+	U32 interiorCount = 0;
+	U32 linkCount = 0;
+	for (U32 i = 0; i < this->mGrids.size(); ++i)
+	{
+		if (this->mGrids[i]->isInteriorGrid())
+		{
+			linkCount += this->stitchInteriorGrid(this->mGrids[i]);
+			++interiorCount;
+		}
+	}
+
+	Con::iAIMessagef("Immersive AI :: Seek :: %d of %d terrain tiles populated, stitched with %d links", this->mGrids.size() - interiorCount,
+		this->mTiles.size(), tileLinkCount);
+
+	if (interiorCount > 0)
+		Con::iAIMessagef("Immersive AI :: Seek :: %d interior grids stitched to the terrain with %d links", interiorCount, linkCount);
+
+	// iterate over all grids to calculate total node count & build stats
+	U32 rayCount = 0;
+	for (U32 i = 0; i < this->mGrids.size(); ++i)
+	{
+		iAIPathMap::smNodeCount += this->mGrids[i]->mNodes.size();
+		rayCount += this->mGrids[i]->getBuildRayCount();
+
+		Con::iAIMessagef("Immersive AI :: Seek :: Grid %d - %d nodes (%d lattice), %d rays, %d ms", i, this->mGrids[i]->mNodes.size(),
+			this->mGrids[i]->mNodesCountX * this->mGrids[i]->mNodesCountY, this->mGrids[i]->getBuildRayCount(), this->mGrids[i]->getBuildTime());
+	}
+
+	// index the nodes of all the grids
+	this->rebuildIndex();
+
+	Con::iAIMessagef("Immersive AI :: Seek :: PathMap Built! %d nodes, %d rays, %d ms", iAIPathMap::smNodeCount, rayCount,
+		Platform::getRealMilliseconds() - this->mBuildStart);
+
+	if (Con::getBoolVariable("$iAIPathMap::lazyEdges", false))
+		Con::iAIMessagef("Immersive AI :: Seek :: PathMap links are validated on demand; watch the first paths found for the cost");
+	return true;
+}
+
+bool iAIPathMap::rebuildRegion(const Box3F &region)
+{
+	PROFILE_SCOPE(iAIPathMap_rebuildRegion);
+
+	if (!this->mCompiled || this->isBuilding())
+		return false;
+
+	U32 rebuildStart = Platform::getRealMilliseconds();
+
+	// rebuild the part of each grid within the region
+	bool rebuilt = false;
+	Box3F affectedBox = region;
+	for (U32 i = 0; i < this->mGrids.size(); ++i)
+	{
+		Box3F gridAffected;
+		if (this->mGrids[i]->isResident() && this->mGrids[i]->rebuildRegion(region, gridAffected))
+		{
+			affectedBox.min.setMin(gridAffected.min);
+			affectedBox.max.setMax(gridAffected.max);
+			rebuilt = true;
+		}
+	}
+
+	if (!rebuilt)
+		return false;
+
+	// relinking dropped the links between the grids, so stitch the tiles & interiors back on
+	this->stitchTerrainTiles(affectedBox);
+	for (U32 i = 0; i < this->mGrids.size(); ++i)
+	{
+		Box3F stitchBox = this->mGrids[i]->mGridBox;
+		stitchBox.min.z = -F32_MAX;
+		stitchBox.max.z = F32_MAX;
+
+		if (this->mGrids[i]->isInteriorGrid() && stitchBox.isOverlapped(affectedBox))
+			this->stitchInteriorGrid(this->mGrids[i]);
+	}
+
+	// the tiles restitched no longer match the cache file, so keep them in memory
+	if (this->isStreaming())
+	{
+		F32 tileWidth = IAIPATHGLOBAL_GRID_TILE_SIZE * this->mTerrainStep;
+		for (U32 i = 0; i < this->mGrids.size(); ++i)
+		{
+			Box3F gridBox = this->mGrids[i]->mGridBox;
+			gridBox.min -= Point3F(tileWidth, tileWidth, 0);
+			gridBox.max += Point3F(tileWidth, tileWidth, 0);
+			if (this->mGrids[i]->isResident() && (gridBox.min.x <= affectedBox.max.x) && (gridBox.max.x >= affectedBox.min.x) &&
+				(gridBox.min.y <= affectedBox.max.y) && (gridBox.max.y >= affectedBox.min.y))
+				this->mGridUsed[i] = U32_MAX;
+		}
+	}
+
+	// recount & re-index the nodes
+	iAIPathMap::smNodeCount = 0;
+	for (U32 i = 0; i < this->mGrids.size(); ++i)
+		iAIPathMap::smNodeCount += this->mGrids[i]->mNodes.size();
+	this->rebuildIndex();
+
+	// let any paths through the area know, and forget the paths found before
+	U32 pathCount = iAIPathHandle::invalidatePaths(affectedBox);
+	iAIPathHandle::flushCache();
+
+	Con::iAIMessagef("Immersive AI :: Seek :: PathMap region rebuilt - %d nodes, %d paths invalidated, %d ms", iAIPathMap::smNodeCount, pathCount,
+		Platform::getRealMilliseconds() - rebuildStart);
+	return true;
+}
+
+void iAIPathMap::interiorCallback(SceneObject *object, void *key)
+{
+	static_cast<Vector<Box3F>*>(key)->push_back(object->getWorldBox());
+}
+
+void iAIPathMap::agentCallback(SceneObject *object, void *key)
+{
+	static_cast<Vector<Point3F>*>(key)->push_back(object->getPosition());
+}
+
+iAIPathGrid* iAIPathMap::getTerrainTile(const S32 tileX, const S32 tileY)
+{
+	if ((tileX < 0) || (tileX >= this->mTilesX) || (tileY < 0) || (tileY >= this->mTilesY))
+		return 0;
+
+	return this->mTiles[(tileY * this->mTilesX) + tileX];
+}
+
+iAIPathNode* iAIPathMap::getTerrainLatticeNode(const S32 idX, const S32 idY)
+{
+	if ((idX < 0) || (idY < 0))
+		return 0;
+
+	S32 tileX = idX / IAIPATHGLOBAL_GRID_TILE_SIZE;
+	S32 tileY = idY / IAIPATHGLOBAL_GRID_TILE_SIZE;
+	iAIPathGrid *tile = this->getTerrainTile(tileX, tileY);
+	if (!tile)
+		return 0;
+
+	return tile->getLatticeNode(idX - (tileX * IAIPATHGLOBAL_GRID_TILE_SIZE), idY - (tileY * IAIPATHGLOBAL_GRID_TILE_SIZE));
+}
+
+U32 iAIPathMap::stitchTilePair(iAIPathGrid *tile, iAIPathGrid *neighbour)
+{
+	PROFILE_SCOPE(iAIPathMap_stitchTilePair);
+
+	// drop the old links on both sides
+	for (U32 i = 0; i < tile->mNodes.size(); ++i)
+	{
+		iAIPathNode *node = tile->mNodes[i];
+		for (S32 j = node->mNeighbours.size() - 1; j >= 0; --j)
+		{
+			if (node->mNeighbours[j]->mParentGrid == neighbour)
+				node->mNeighbours.erase(j);
+		}
+	}
+
+	for (U32 i = 0; i < neighbour->mNodes.size(); ++i)
+	{
+		iAIPathNode *node = neighbour->mNodes[i];
+		for (S32 j = node->mNeighbours.size() - 1; j >= 0; --j)
+		{
+			if (node->mNeighbours[j]->mParentGrid == tile)
+				node->mNeighbours.erase(j);
+		}
+	}
+
+	// offset from the tile's lattice to the neighbour's
+	S32 tilesX = this->mTilesX;
+	S32 offsetX = ((tile->getMapTile() % tilesX) - (neighbour->getMapTile() % tilesX)) * IAIPATHGLOBAL_GRID_TILE_SIZE;
+	S32 offsetY = ((tile->getMapTile() / tilesX) - (neighbour->getMapTile() / tilesX)) * IAIPATHGLOBAL_GRID_TILE_SIZE;
+
+	// an edge which isn't valid is half a step from an obstruction, as within a grid
+	F32 edgeClearance = this->mTerrainStep / 2;
+
+	U32 linkCount = 0;
+	for (S32 iterX = 0; iterX < tile->mNodesCountX; ++iterX)
+	{
+		for (S32 iterY = 0; iterY < tile->mNodesCountY; ++iterY)
+		{
+			// only the border can reach another tile
+			if ((iterX > 0) && (iterX < (tile->mNodesCountX - 1)) && (iterY > 0) && (iterY < (tile->mNodesCountY - 1)))
+				continue;
+
+			U32 index = (iterX * tile->mNodesCountY) + iterY;
+			iAIPathNode *node = tile->getLatticeNode(iterX, iterY);
+
+			for (U32 dir = 0; dir < iAIPathGrid::DirectionCount; ++dir)
+			{
+				S32 neighbourX = iterX + iAIPathGrid::smDirectionX[dir] + offsetX;
+				S32 neighbourY = iterY + iAIPathGrid::smDirectionY[dir] + offsetY;
+				if ((neighbourX < 0) || (neighbourX >= neighbour->mNodesCountX) || (neighbourY < 0) || (neighbourY >= neighbour->mNodesCountY))
+					continue;
+
+				U32 neighbourIndex = (neighbourX * neighbour->mNodesCountY) + neighbourY;
+				iAIPathNode *neighbourNode = neighbour->getLatticeNode(neighbourX, neighbourY);
+				if (!node && !neighbourNode)
+					continue;
+
+				// checked between the lattice positions, as the grids check their own edges
+				bool valid = node && neighbourNode &&
+							 (node->hasNeighbour(neighbourNode) || tile->mNodeBlock[index].isNeighbourValid(neighbour->mNodeBlock[neighbourIndex].mPosition, 0, 0, IAIPATHGLOBAL_STATIC_COLLISION_MASK));
+
+				// whichever side has a node is next to an obstruction
+				if (!valid)
+				{
+					if (node)
+						node->mClearance = getMin(node->mClearance, edgeClearance);
+					if (neighbourNode)
+						neighbourNode->mClearance = getMin(neighbourNode->mClearance, edgeClearance);
+					continue;
+				}
+
+				if (node->hasNeighbour(neighbourNode))
+					continue;
+
+				node->mNeighbours.push_back(neighbourNode);
+				neighbourNode->mNeighbours.push_back(node);
+				++linkCount;
+			}
+		}
+	}
+
+	return linkCount;
+}
+
+U32 iAIPathMap::stitchTerrainTiles(const Box3F &area)
+{
+	PROFILE_SCOPE(iAIPathMap_stitchTerrainTiles);
+
+	// whether each tile borders the area
+	Vector<U8> inArea;
+	inArea.setSize(this->mTiles.size());
+	for (U32 i = 0; i < this->mTiles.size(); ++i)
+	{
+		inArea[i] = false;
+		if (!this->mTiles[i] || !this->mTiles[i]->isResident())
+			continue;
+
+		Box3F tileBox = this->mTiles[i]->mGridBox;
+		tileBox.min -= Point3F(this->mTerrainStep, this->mTerrainStep, 0);
+		tileBox.max += Point3F(this->mTerrainStep, this->mTerrainStep, 0);
+		inArea[i] = (tileBox.min.x <= area.max.x) && (tileBox.max.x >= area.min.x) && (tileBox.min.y <= area.max.y) && (tileBox.max.y >= area.min.y);
+	}
+
+	U32 linkCount = 0;
+	for (U32 i = 0; i < this->mTiles.size(); ++i)
+	{
+		if (!inArea[i])
+			continue;
+
+		S32 tileX = i % this->mTilesX;
+		S32 tileY = i / this->mTilesX;
+		for (U32 dir = 0; dir < iAIPathGrid::DirectionCount; ++dir)
+		{
+			iAIPathGrid *neighbour = this->getTerrainTile(tileX + iAIPathGrid::smDirectionX[dir], tileY + iAIPathGrid::smDirectionY[dir]);
+			if (!neighbour || !neighbour->isResident())
+				continue;
+
+			// each pair only once
+			if (inArea[neighbour->getMapTile()] && ((U32)neighbour->getMapTile() < i))
+				continue;
+
+			linkCount += this->stitchTilePair(this->mTiles[i], neighbour);
+		}
+	}
+
+	return linkCount;
+}
+
+U32 iAIPathMap::stitchInteriorGrid(iAIPathGrid *interiorGrid)
+{
+	PROFILE_SCOPE(iAIPathMap_stitchInteriorGrid);
+
+	if (this->mTiles.size() == 0)
+		return 0;
+
+	// terrain lattice under the interior grid
+	F32 step = this->mTerrainStep;
+	S32 startX = (S32)mFloor((interiorGrid->mGridBox.min.x - this->mTerrainOrigin.x) / step) - 1;
+	S32 endX = (S32)mCeil((interiorGrid->mGridBox.max.x - this->mTerrainOrigin.x) / step) + 1;
+	S32 startY = (S32)mFloor((interiorGrid->mGridBox.min.y - this->mTerrainOrigin.y) / step) - 1;
+	S32 endY = (S32)mCeil((interiorGrid->mGridBox.max.y - this->mTerrainOrigin.y) / step) + 1;
+
+	// drop the old links on both sides
+	for (S32 iterX = startX; iterX <= endX; ++iterX)
+	{
+		for (S32 iterY = startY; iterY <= endY; ++iterY)
+		{
+			iAIPathNode *node = this->getTerrainLatticeNode(iterX, iterY);
+			if (!node)
+				continue;
+
+			for (S32 i = node->mNeighbours.size() - 1; i >= 0; --i)
+			{
+				if (node->mNeighbours[i]->mParentGrid == interiorGrid)
+					node->mNeighbours.erase(i);
+			}
+		}
+	}
+
+	for (U32 i = 0; i < interiorGrid->mNodes.size(); ++i)
+	{
+		iAIPathNode *node = interiorGrid->mNodes[i];
+		for (S32 j = node->mNeighbours.size() - 1; j >= 0; --j)
+		{
+			if (node->mNeighbours[j]->mParentGrid != interiorGrid)
+				node->mNeighbours.erase(j);
+		}
+	}
+
+	// link each node in the buffer to the terrain nodes around it
+	U32 linkCount = 0;
+	const Box3F &interiorBox = interiorGrid->getInteriorBox();
+	for (U32 i = 0; i < interiorGrid->mNodes.size(); ++i)
+	{
+		iAIPathNode *node = interiorGrid->mNodes[i];
+		const Point3F &position = node->mPosition;
+
+		if ((position.x >= interiorBox.min.x) && (position.x <= interiorBox.max.x) &&
+			(position.y >= interiorBox.min.y) && (position.y <= interiorBox.max.y))
+			continue;
+
+		S32 baseX = (S32)mFloor((position.x - this->mTerrainOrigin.x) / step);
+		S32 baseY = (S32)mFloor((position.y - this->mTerrainOrigin.y) / step);
+
+		for (S32 iterX = baseX; iterX <= (baseX + 1); ++iterX)
+		{
+			for (S32 iterY = baseY; iterY <= (baseY + 1); ++iterY)
+			{
+				iAIPathNode *terrainNode = this->getTerrainLatticeNode(iterX, iterY);
+				if (!terrainNode || node->hasNeighbour(terrainNode))
+					continue;
+
+				if (!node->isNeighbourValid(terrainNode->mPosition, 0, 0, IAIPATHGLOBAL_STATIC_COLLISION_MASK))
+					continue;
+
+				node->mNeighbours.push_back(terrainNode);
+				terrainNode->mNeighbours.push_back(node);
+				++linkCount;
+			}
+		}
+	}
+
+	return linkCount;
+}
+
+U32 iAIPathMap::addObstacle(const Box3F &box, const F32 cost, const bool blocked)
+{
+	U32 id = this->mOverlay.addBox(box, cost, blocked);
+	this->mOverlay.commit(this->mIndex);
+	iAIPathHandle::flushCache();
+
+	// paths through it are no longer valid
+	if (blocked)
+		iAIPathHandle::invalidatePaths(this->getRegionArea(box));
+
+	return id;
+}
+
+U32 iAIPathMap::addObstacle(const Point3F &centre, const F32 radius, const F32 cost, const bool blocked)
+{
+	U32 id = this->mOverlay.addCircle(centre, radius, cost, blocked);
+	this->mOverlay.commit(this->mIndex);
+	iAIPathHandle::flushCache();
+
+	// paths through it are no longer valid; the circle covers all heights
+	if (blocked)
+	{
+		const Box3F &bounds = this->mIndex.getBounds();
+		Box3F box(Point3F(centre.x - radius, centre.y - radius, bounds.min.z), Point3F(centre.x + radius, centre.y + radius, bounds.max.z));
+		iAIPathHandle::invalidatePaths(this->getRegionArea(box));
+	}
+
+	return id;
+}
+
+Box3F iAIPathMap::getRegionArea(const Box3F &area)
+{
+	Box3F regionArea = area;
+
+	Vector<iAIPathNode*> nodes;
+	this->mIndex.findOverlapping(area, nodes);
+	for (U32 i = 0; i < nodes.size(); ++i)
+	{
+		Box3F region = nodes[i]->getRegionBox();
+		regionArea.min.x = getMin(regionArea.min.x, region.min.x);
+		regionArea.min.y = getMin(regionArea.min.y, region.min.y);
+		regionArea.max.x = getMax(regionArea.max.x, region.max.x);
+		regionArea.max.y = getMax(regionArea.max.y, region.max.y);
+	}
+
+	return regionArea;
+}
+
+bool iAIPathMap::removeObstacle(const U32 id)
+{
+	if (!this->mOverlay.remove(id))
+		return false;
+
+	this->mOverlay.commit(this->mIndex);
+	iAIPathHandle::flushCache();
+	return true;
+}
+
+void iAIPathMap::clearObstacles()
+{
+	this->mOverlay.clear();
+	this->mOverlay.commit(this->mIndex);
+	iAIPathHandle::flushCache();
+}
+
+iAIPathProfile* iAIPathMap::addCostProfile(const char *name)
+{
+	iAIPathProfile *profile = this->findCostProfile(name);
+	if (profile)
+		return profile;
+
+	profile = new iAIPathProfile(name);
+	this->mCostProfiles.push_back(profile);
+	return profile;
+}
+
+iAIPathProfile* iAIPathMap::findCostProfile(const char *name)
+{
+	if (!name || !name[0])
+		return 0;
+
+	// names are in the string table, so compare the pointers
+	StringTableEntry entry = StringTable->insert(name);
+	for (U32 i = 0; i < this->mCostProfiles.size(); ++i)
+	{
+		if (this->mCostProfiles[i]->getName() == entry)
+			return this->mCostProfiles[i];
+	}
+	return 0;
+}
+
+void iAIPathMap::clearCostProfiles()
+{
+	for (U32 i = 0; i < this->mCostProfiles.size(); ++i)
+		delete this->mCostProfiles[i];
+	this->mCostProfiles.clear();
+
+	// the cache knows the profiles by address
+	iAIPathHandle::flushCache();
+}
+
+void iAIPathMap::clearMap()
+{
+	// iterate over nodes and delete all
+	for (U32 i = 0; i < this->mGrids.size(); ++i)
+	{
+		if ((this->mGrids[i]) && (!this->mGrids[i]->isDeleted()))
+			this->mGrids[i]->deleteObject();
+		this->mGrids[i] = 0;
+	}
+	this->mGrids.clear();
+
+	// nodes are gone, so is the index & every path found over them
+	this->mIndex.clear();
+	this->mOverlay.commit(this->mIndex);
+	iAIPathHandle::flushCache();
+	iAIPathDensity::getInstance()->clear();
+	iAIPathReservation::getInstance()->clear();
+
+	this->mTiles.clear();
+	this->mTilesX = 0;
+	this->mTilesY = 0;
+
+	// nothing left to page in
+	if (this->mStreamEvent)
+	{
+		Sim::cancelEvent(this->mStreamEvent);
+		this->mStreamEvent = 0;
+	}
+	this->mStreamFile = 0;
+	this->mStreamQueue.clear();
+	this->mGridOffsets.clear();
+	this->mGridUsed.clear();
+
+	// set as uncompiled
+	this->mCompiled = false;
+	iAIPathMap::smNodeCount = 0;
+}
+
+bool iAIPathMap::getCacheFileName(char* buffer, const U32 bufferSize)
+{
+	const char *missionFile = Con::getVariable("$Server::MissionFile");
+	if (!missionFile || !missionFile[0])
+		return false;
+
+	dStrncpy(buffer, missionFile, bufferSize - dStrlen(IAIPATHMAP_CACHE_EXTENSION) - 1);
+	buffer[bufferSize - dStrlen(IAIPATHMAP_CACHE_EXTENSION) - 1] = 0;
+
+	// swap the mission extension for the cache one
+	char *extension = dStrrchr(buffer, '.');
+	if (extension && !dStrchr(extension, '/'))
+		*extension = 0;
+	dStrcat(buffer, IAIPATHMAP_CACHE_EXTENSION);
+
+	return true;
+}
+
+void iAIPathMap::cacheKeyCallback(SceneObject *object, void *key)
+{
+	// summed so the order the container returns objects doesn't matter
+	Box3F worldBox = object->getWorldBox();
+	*static_cast<U32*>(key) += calculateCRC(&worldBox, sizeof(Box3F));
+}
+
+U32 iAIPathMap::getCacheKey()
+{
+	U32 key = calculateCRC(IAIPATHMAP_CACHE_EXTENSION, dStrlen(IAIPATHMAP_CACHE_EXTENSION));
+
+	// terrain heights
+	TerrainBlock *terrain = dynamic_cast<TerrainBlock*>(Sim::findObject("Terrain"));
+	if (terrain)
+	{
+		U32 terrainCRC = terrain->getCRC();
+		key = calculateCRC(&terrainCRC, sizeof(U32), key);
+	}
+
+	// extent of the terrain grid
+	MissionArea *missionAreaPtr = dynamic_cast<MissionArea*>(Sim::findObject("MissionArea"));
+	if (missionAreaPtr)
+	{
+		RectI area = missionAreaPtr->getArea();
+		key = calculateCRC(&area, sizeof(RectI), key);
+	}
+
+	// node density
+	F32 density = IAIPATHGLOBAL_GRID_DENSITY_TERRAIN / Con::getFloatVariable("Server::gridSize", 10.0f);
+	key = calculateCRC(&density, sizeof(F32), key);
+
+	// merging of open areas
+	S32 adaptiveLevels = Con::getIntVariable("$iAIPathMap::adaptiveLevels", IAIPATHGLOBAL_GRID_ADAPTIVE_LEVELS);
+	key = calculateCRC(&adaptiveLevels, sizeof(S32), key);
+	S32 openRegions = Con::getIntVariable("$iAIPathMap::openRegions", IAIPATHGLOBAL_GRID_OPEN_SIZE);
+	key = calculateCRC(&openRegions, sizeof(S32), key);
+
+	// costs of the terrain materials
+	if (terrain)
+	{
+		F32 surfaceCosts[TerrainBlock::MaterialGroups];
+		iAIPathGrid::getSurfaceCosts(terrain, surfaceCosts);
+		key = calculateCRC(surfaceCosts, sizeof(surfaceCosts), key);
+	}
+
+	// everything the grids are built against, and the water they're costed by
+	U32 objectKey = 0;
+	gServerContainer.findObjects(IAIPATHGLOBAL_STATIC_COLLISION_MASK | WaterObjectType, iAIPathMap::cacheKeyCallback, &objectKey);
+	key = calculateCRC(&objectKey, sizeof(U32), key);
+
+	return key;
+}
+
+bool iAIPathMap::savePathMap(const char* fileName, const U32 key)
+{
+	PROFILE_SCOPE(iAIPathMap_savePathMap);
+
+	// lazy grids hold links which were never cast, which would be loaded as valid
+	for (U32 i = 0; i < this->mGrids.size(); ++i)
+	{
+		if (this->mGrids[i]->isLazy())
+		{
+			Con::errorf("Immersive AI :: Seek :: PathMap cache - links are validated on demand, not writing %s", fileName);
+			return false;
+		}
+	}
+
+	FileStream stream;
+	if (!ResourceManager->openFileForWrite(stream, fileName))
+	{
+		Con::errorf("Immersive AI :: Seek :: PathMap cache - unable to write %s", fileName);
+		return false;
+	}
+
+	// header
+	stream.write((U32)IAIPATHMAP_CACHE_MAGIC);
+	stream.write((U32)IAIPATHMAP_CACHE_VERSION);
+	stream.write(key);
+	stream.writeString(Con::getVariable("$Server::MissionFile"));
+	stream.write((U32)this->mGrids.size());
+	mathWrite(stream, this->mTerrainOrigin);
+	stream.write(this->mTerrainStep);
+	stream.write(this->mTilesX);
+	stream.write(this->mTilesY);
+
+	// directory of the grid blocks, filled in once they're written; the last entry is the end of the blocks
+	U32 directoryPosition = stream.getPosition();
+	for (U32 i = 0; i <= this->mGrids.size(); ++i)
+		stream.write((U32)0);
+
+	// each grid in a block of its own, so the tiles can be read back one at a time
+	this->mGridOffsets.setSize(this->mGrids.size() + 1);
+	for (U32 i = 0; i < this->mGrids.size(); ++i)
+	{
+		this->mGridOffsets[i] = stream.getPosition();
+		this->writeGrid(stream, this->mGrids[i]);
+	}
+	this->mGridOffsets[this->mGrids.size()] = stream.getPosition();
+	stream.write((U32)IAIPATHMAP_CACHE_MAGIC);
+
+	stream.setPosition(directoryPosition);
+	for (U32 i = 0; i < this->mGridOffsets.size(); ++i)
+		stream.write(this->mGridOffsets[i]);
+
+	bool saved = (stream.getStatus() == Stream::Ok);
+	stream.close();
+
+	if (saved)
+	{
+		Con::iAIMessagef("Immersive AI :: Seek :: PathMap cache saved to %s", fileName);
+		this->startStream(fileName, key);
+	}
+	else
+		Con::errorf("Immersive AI :: Seek :: PathMap cache - error writing %s", fileName);
+
+	return saved;
+}
+
+void iAIPathMap::writeGrid(Stream &stream, iAIPathGrid *grid)
+{
+	mathWrite(stream, grid->mGridBox);
+	stream.write(grid->mDensity);
+	stream.write(grid->mNodesCountX);
+	stream.write(grid->mNodesCountY);
+	stream.write(grid->mAdaptiveLevels);
+	stream.write(grid->mOpenSize);
+	stream.write((U8)grid->mInteriorGrid);
+	stream.write(grid->mMapTile);
+	mathWrite(stream, grid->mInteriorBox);
+	stream.write((U32)grid->mNodes.size());
+
+	// neighbours are saved by node id, so the block stands alone
+	for (U32 i = 0; i < grid->mNodes.size(); ++i)
+	{
+		iAIPathNode *node = grid->mNodes[i];
+		U32 latticeIndex = grid->getLatticeIndex(node);
+
+		stream.write(latticeIndex);
+		mathWrite(stream, node->mPosition);
+		stream.write(node->mSpanX);
+		stream.write(node->mSpanY);
+		stream.write(node->mSurface);
+		for (U32 j = 0; j < iAIPathNode::CostChannelCount; ++j)
+			stream.write(node->mCost[j]);
+		stream.write(node->mClearance);
+
+		// an open region can border a few hundred nodes along its edges
+		stream.write((U16)node->mNeighbours.size());
+		for (U32 j = 0; j < node->mNeighbours.size(); ++j)
+			stream.write(node->mNeighbours[j]->getId());
+	}
+}
+
+bool iAIPathMap::loadPathMap(const char* fileName, const U32 key)
+{
+	PROFILE_SCOPE(iAIPathMap_loadPathMap);
+
+	U32 loadStart = Platform::getRealMilliseconds();
+
+	FileStream file;
+	if (!file.open(fileName, FileStream::Read))
+		return false;
+
+	// replace any current path map
+	this->clearMap();
+
+	bool loaded = false;
+	if (Con::getIntVariable("$iAIPathMap::streamBudget", IAIPATHMAP_STREAM_BUDGET) > 0)
+	{
+		// only the interiors are read now, so read straight from the file
+		loaded = this->readPathMap(file, key, true);
+		file.close();
+	} else
+	{
+		// pull the whole file into memory in one read
+		U32 size = file.getStreamSize();
+		U8 *buffer = new U8[size];
+		bool read = file.read(size, buffer);
+		file.close();
+
+		if (read)
+		{
+			MemStream stream(size, buffer, true, false);
+			loaded = this->readPathMap(stream, key, false);
+		}
+
+		delete [] buffer;
+	}
+
+	if (!loaded)
+	{
+		this->clearMap();
+		Con::iAIMessagef("Immersive AI :: Seek :: PathMap cache %s is out of date", fileName);
+		return false;
+	}
+
+	// index the nodes of all the grids
+	this->rebuildIndex();
+
+	Con::iAIMessagef("Immersive AI :: Seek :: PathMap loaded from %s - %d nodes, %d ms", fileName, iAIPathMap::smNodeCount,
+		Platform::getRealMilliseconds() - loadStart);
+
+	this->startStream(fileName, key);
+	return true;
+}
+
+bool iAIPathMap::readPathMap(Stream &stream, const U32 key, const bool streaming)
+{
+	U32 magic = 0, version = 0, fileKey = 0, gridCount = 0, tilesX = 0, tilesY = 0;
+	Point3F terrainOrigin;
+	F32 terrainStep = 0.0f;
+	char missionFile[256];
+
+	// check the header matches the current mission
+	bool ok = stream.read(&magic) && stream.read(&version) && stream.read(&fileKey);
+	if (!ok || (magic != IAIPATHMAP_CACHE_MAGIC) || (version != IAIPATHMAP_CACHE_VERSION) || (fileKey != key))
+		return false;
+
+	stream.readString(missionFile);
+	if (dStricmp(missionFile, Con::getVariable("$Server::MissionFile")) != 0)
+		return false;
+
+	ok = stream.read(&gridCount) && mathRead(stream, &terrainOrigin) && stream.read(&terrainStep) && stream.read(&tilesX) && stream.read(&tilesY);
+	if (!ok || (gridCount > (1 << (32 - IAIPATHGLOBAL_NODE_ID_LOCAL_BITS))) || ((tilesX * tilesY) > (1 << (32 - IAIPATHGLOBAL_NODE_ID_LOCAL_BITS))))
+		return false;
+
+	// directory of the grid blocks, which must lie in order within the file
+	Vector<U32> offsets;
+	offsets.setSize(gridCount + 1);
+	for (U32 i = 0; ok && (i < offsets.size()); ++i)
+		ok = stream.read(&offsets[i]) && (offsets[i] <= stream.getStreamSize()) && ((i == 0) || (offsets[i] > offsets[i - 1]));
+	if (!ok)
+		return false;
+
+	Vector<iAIPathGrid*> tiles;
+	tiles.setSize(tilesX * tilesY);
+	dMemset(tiles.address(), 0, sizeof(iAIPathGrid*) * tiles.size());
+
+	// the bounds of every grid first, so links between grids can be checked
+	Vector<iAIPathGrid*> grids;
+	for (U32 i = 0; ok && (i < gridCount); ++i)
+	{
+		iAIPathGrid *grid = new iAIPathGrid();
+		grids.push_back(grid);
+
+		ok = stream.setPosition(offsets[i]) && this->readGrid(stream, grid, false, grids);
+		if (!ok)
+			break;
+
+		// each terrain tile appears once
+		if (!grid->mInteriorGrid)
+		{
+			if ((grid->mMapTile < 0) || (grid->mMapTile >= tiles.size()) || tiles[grid->mMapTile])
+			{
+				ok = false;
+				break;
+			}
+			tiles[grid->mMapTile] = grid;
+		}
+	}
+
+	// then the nodes; only the interiors if the tiles are paged in later
+	for (U32 i = 0; ok && (i < gridCount); ++i)
+	{
+		if (streaming && !grids[i]->mInteriorGrid)
+			continue;
+
+		ok = stream.setPosition(offsets[i]) && this->readGrid(stream, grids[i], true, grids);
+	}
+
+	// must end exactly where the writer did
+	ok = ok && stream.setPosition(offsets[gridCount]) && stream.read(&magic) && (magic == IAIPATHMAP_CACHE_MAGIC);
+
+	if (!ok)
+	{
+		// grids were never registered, so just delete them
+		for (U32 i = 0; i < grids.size(); ++i)
+			delete grids[i];
+		return false;
+	}
+
+	// add the grids to the pathmap & scene, in the same order so the node ids hold
+	for (U32 i = 0; i < grids.size(); ++i)
+		this->addGrid(grids[i]);
+
+	this->mTiles = tiles;
+	this->mTilesX = tilesX;
+	this->mTilesY = tilesY;
+	this->mTerrainOrigin = terrainOrigin;
+	this->mTerrainStep = terrainStep;
+	this->mGridOffsets = offsets;
+
+	return true;
+}
+
+bool iAIPathMap::readGrid(Stream &stream, iAIPathGrid *grid, const bool readNodes, const Vector<iAIPathGrid*> &grids)
+{
+	U32 nodeCount = 0;
+	U8 interiorGrid = 0;
+	bool ok = mathRead(stream, &grid->mGridBox) && stream.read(&grid->mDensity) && stream.read(&grid->mNodesCountX) &&
+		 stream.read(&grid->mNodesCountY) && stream.read(&grid->mAdaptiveLevels) && stream.read(&grid->mOpenSize) && stream.read(&interiorGrid) &&
+		 stream.read(&grid->mMapTile) && mathRead(stream, &grid->mInteriorBox) && stream.read(&nodeCount);
+	grid->mInteriorGrid = (interiorGrid != 0);
+
+	U32 latticeSize = grid->mNodesCountX * grid->mNodesCountY;
+	if (!ok || (grid->mAdaptiveLevels > IAIPATHGLOBAL_GRID_ADAPTIVE_MAX_LEVELS) || (grid->mOpenSize > IAIPATHGLOBAL_GRID_OPEN_MAX_SIZE) || (nodeCount > latticeSize) ||
+		(grid->mNodesCountX > (1 << IAIPATHGLOBAL_NODE_ID_LOCAL_BITS)) || (grid->mNodesCountY > (1 << IAIPATHGLOBAL_NODE_ID_LOCAL_BITS)) ||
+		(latticeSize > (1 << IAIPATHGLOBAL_NODE_ID_LOCAL_BITS)))
+		return false;
+
+	if (!readNodes)
+		return true;
+
+	// all the nodes of the grid in one block
+	grid->mNodeBlock = new iAIPathNode[latticeSize];
+	grid->mLattice.setSize(latticeSize);
+	dMemset(grid->mLattice.address(), 0, sizeof(iAIPathNode*) * latticeSize);
+	grid->mNodes.reserve(nodeCount);
+
+	// neighbours are linked once every node of the grid is in
+	Vector<U32> neighbourIds;
+	Vector<U16> neighbourCounts;
+	neighbourCounts.reserve(nodeCount);
+
+	for (U32 i = 0; ok && (i < nodeCount); ++i)
+	{
+		U32 latticeIndex;
+		Point3F position;
+		U8 spanX, spanY, surface;
+		U16 neighbourCount;
+		F32 costs[iAIPathNode::CostChannelCount], clearance;
+		if (!stream.read(&latticeIndex) || !mathRead(stream, &position) || !stream.read(&spanX) || !stream.read(&spanY) || !stream.read(&surface) ||
+			(latticeIndex >= latticeSize) || (spanX == 0) || (spanY == 0) || (spanX > grid->getMaxRegionSize()) || (spanY > grid->getMaxRegionSize()) ||
+			grid->mLattice[latticeIndex])
+		{
+			ok = false;
+			break;
+		}
+
+		for (U32 j = 0; ok && (j < iAIPathNode::CostChannelCount); ++j)
+			ok = stream.read(&costs[j]);
+		ok = ok && stream.read(&clearance) && stream.read(&neighbourCount);
+
+		for (U32 j = 0; ok && (j < neighbourCount); ++j)
+		{
+			U32 neighbourId;
+			ok = stream.read(&neighbourId);
+			neighbourIds.push_back(neighbourId);
+		}
+		if (!ok)
+			break;
+
+		// a merged node's region must lie within the grid
+		S32 idX = latticeIndex / grid->mNodesCountY;
+		S32 idY = latticeIndex % grid->mNodesCountY;
+		if (((idX - (spanX / 2)) < 0) || ((idX - (spanX / 2) + spanX) > grid->mNodesCountX) ||
+			((idY - (spanY / 2)) < 0) || ((idY - (spanY / 2) + spanY) > grid->mNodesCountY))
+		{
+			ok = false;
+			break;
+		}
+
+		iAIPathNode *node = &grid->mNodeBlock[latticeIndex];
+		node->set(position, grid, idX, idY);
+		node->mSurface = surface;
+		dMemcpy(node->mCost, costs, sizeof(costs));
+		node->mClearance = clearance;
+		node->updateMoveModifier();
+		node->mSpanX = spanX;
+		node->mSpanY = spanY;
+
+		grid->mLattice[latticeIndex] = node;
+		grid->mNodes.push_back(node);
+		neighbourCounts.push_back(neighbourCount);
+	}
+
+	// link the neighbours; those in other grids both ways if that grid is loaded, otherwise left for when it is
+	U32 nextId = 0;
+	for (U32 i = 0; ok && (i < grid->mNodes.size()); ++i)
+	{
+		iAIPathNode *node = grid->mNodes[i];
+		node->mNeighbours.reserve(neighbourCounts[i]);
+
+		for (U32 j = 0; ok && (j < neighbourCounts[i]); ++j)
+		{
+			U32 neighbourId = neighbourIds[nextId++];
+			U32 gridId = neighbourId >> IAIPATHGLOBAL_NODE_ID_LOCAL_BITS;
+			U32 latticeIndex = neighbourId & ((1 << IAIPATHGLOBAL_NODE_ID_LOCAL_BITS) - 1);
+
+			ok = (gridId < grids.size());
+			if (!ok)
+				break;
+
+			iAIPathGrid *neighbourGrid = grids[gridId];
+			if (!neighbourGrid->isResident())
+			{
+				++node->mPagedLinks;
+				continue;
+			}
+
+			ok = (latticeIndex < neighbourGrid->mLattice.size()) && neighbourGrid->mLattice[latticeIndex];
+			if (!ok)
+				break;
+
+			iAIPathNode *neighbour = neighbourGrid->mLattice[latticeIndex];
+			node->mNeighbours.push_back(neighbour);
+
+			if ((neighbourGrid != grid) && !neighbour->hasNeighbour(node))
+			{
+				neighbour->mNeighbours.push_back(node);
+				if (neighbour->mPagedLinks > 0)
+					--neighbour->mPagedLinks;
+			}
+		}
+	}
+
+	if (!ok)
+	{
+		this->unlinkGrid(grid);
+		grid->releaseNodes();
+		return false;
+	}
+
+	grid->mCompiled = (grid->mNodes.size() > 0);
+	grid->restoreLatticeState();
+	grid->updateWorldBox();
+
+	return true;
+}
+
+void iAIPathMap::toggleDisplay()
+{
+	// iterate over all grids
+	for (U32 i = 0; i < this->mGrids.size(); ++i)
+	{
+		// toggle the display
+		this->mGrids[i]->toggleDisplay();
+	}
+}
+
+void iAIPathMap::rebuildIndex()
+{
+	// gather the nodes of every grid
+	Vector<iAIPathNode*> allNodes;
+	allNodes.reserve(iAIPathMap::smNodeCount);
+	for (U32 i = 0; i < this->mGrids.size(); ++i)
+	{
+		for (U32 j = 0; j < this->mGrids[i]->mNodes.size(); ++j)
+		{
+			this->mGrids[i]->mNodes[j]->mMapIndex = allNodes.size();
+			allNodes.push_back(this->mGrids[i]->mNodes[j]);
+		}
+	}
+
+	this->mIndex.build(allNodes);
+	iAIPathMap::smNodeCount = allNodes.size();
+
+	// node numbering has changed, re-rasterise the obstacles & move the crowd over
+	this->mOverlay.commit(this->mIndex);
+	iAIPathDensity::getInstance()->renumber(this);
+}
+
+iAIPathNode* iAIPathMap::getNode(const U32 id)
+{
+	U32 gridId = id >> IAIPATHGLOBAL_NODE_ID_LOCAL_BITS;
+	U32 latticeIndex = id & ((1 << IAIPATHGLOBAL_NODE_ID_LOCAL_BITS) - 1);
+
+	if ((gridId >= this->mGrids.size()) || (latticeIndex >= this->mGrids[gridId]->mLattice.size()))
+		return 0;
+
+	return this->mGrids[gridId]->mLattice[latticeIndex];
+}
+
+bool iAIPathMap::requestTiles(const Point3F &position, const S32 radius)
+{
+	if (!this->isStreaming())
+		return true;
+
+	F32 tileWidth = IAIPATHGLOBAL_GRID_TILE_SIZE * this->mTerrainStep;
+	S32 tileX = (S32)mFloor((position.x - this->mTerrainOrigin.x) / tileWidth);
+	S32 tileY = (S32)mFloor((position.y - this->mTerrainOrigin.y) / tileWidth);
+
+	bool resident = true;
+	for (S32 iterX = tileX - radius; iterX <= (tileX + radius); ++iterX)
+	{
+		for (S32 iterY = tileY - radius; iterY <= (tileY + radius); ++iterY)
+		{
+			iAIPathGrid *tile = this->getTerrainTile(iterX, iterY);
+			if (!tile)
+				continue;
+
+			// stamp as used, unless it's held in memory anyway
+			U32 gridId = tile->getGridId();
+			if (this->mGridUsed[gridId] != U32_MAX)
+				this->mGridUsed[gridId] = this->mStreamTick;
+
+			if (tile->isResident())
+				continue;
+
+			// queue it once
+			bool queued = false;
+			for (U32 i = 0; !queued && (i < this->mStreamQueue.size()); ++i)
+				queued = (this->mStreamQueue[i] == gridId);
+			if (!queued)
+				this->mStreamQueue.push_back(gridId);
+
+			if ((iterX == tileX) && (iterY == tileY))
+				resident = false;
+		}
+	}
+
+	return resident;
+}
+
+void iAIPathMap::startStream(const char* fileName, const U32 key)
+{
+	S32 budget = Con::getIntVariable("$iAIPathMap::streamBudget", IAIPATHMAP_STREAM_BUDGET);
+	if (budget <= 0)
+		return;
+
+	this->mStreamFile = StringTable->insert(fileName);
+	this->mStreamKey = key;
+	this->mStreamQueue.clear();
+
+	// nothing has been used yet
+	this->mGridUsed.setSize(this->mGrids.size());
+	dMemset(this->mGridUsed.address(), 0, sizeof(U32) * this->mGridUsed.size());
+	this->mStreamTick = 1;
+
+	if (!this->mStreamEvent)
+		this->mStreamEvent = Sim::postEvent(this, new iAIPathMapStreamEvent, Sim::getCurrentTime() + IAIPATHMAP_STREAM_POLL_TIME);
+
+	Con::iAIMessagef("Immersive AI :: Seek :: PathMap streaming terrain tiles from %s, %d MB budget", fileName, budget);
+}
+
+void iAIPathMap::updateStream()
+{
+	PROFILE_SCOPE(iAIPathMap_updateStream);
+
+	this->mStreamEvent = 0;
+	if (!this->isStreaming())
+		return;
+
+	// keep the tiles around every agent
+	Vector<Point3F> agentPositions;
+	gServerContainer.findObjects(iAIAgentObjectType, iAIPathMap::agentCallback, &agentPositions);
+	for (U32 i = 0; i < agentPositions.size(); ++i)
+		this->requestTiles(agentPositions[i], IAIPATHMAP_STREAM_RADIUS);
+
+	U32 loaded = this->loadQueuedTiles();
+	U32 evicted = this->evictTiles();
+
+	// the nodes have changed, so has the index
+	if ((loaded > 0) || (evicted > 0))
+	{
+		this->rebuildIndex();
+		Con::iAIMessagef("Immersive AI :: Seek :: PathMap streaming - %d tiles loaded, %d paged out, %d nodes in memory", loaded, evicted,
+			iAIPathMap::smNodeCount);
+	}
+
+	// requests from now on count towards the next update
+	++this->mStreamTick;
+
+	if (this->isStreaming())
+		this->mStreamEvent = Sim::postEvent(this, new iAIPathMapStreamEvent, Sim::getCurrentTime() + IAIPATHMAP_STREAM_POLL_TIME);
+}
+
+U32 iAIPathMap::loadQueuedTiles()
+{
+	if (this->mStreamQueue.size() == 0)
+		return 0;
+
+	PROFILE_SCOPE(iAIPathMap_loadQueuedTiles);
+
+	// the file must still be the one the map was read from
+	FileStream file;
+	U32 magic = 0, version = 0, fileKey = 0;
+	bool ok = file.open(this->mStreamFile, FileStream::Read) && file.read(&magic) && file.read(&version) && file.read(&fileKey) &&
+		(magic == IAIPATHMAP_CACHE_MAGIC) && (version == IAIPATHMAP_CACHE_VERSION) && (fileKey == this->mStreamKey);
+
+	U32 loaded = 0;
+	while (ok && (this->mStreamQueue.size() > 0) && (loaded < IAIPATHMAP_STREAM_LOADS_PER_POLL))
+	{
+		iAIPathGrid *grid = this->mGrids[this->mStreamQueue.front()];
+		this->mStreamQueue.pop_front();
+		if (grid->isResident())
+			continue;
+
+		// links to the grids already in are made as it's read
+		ok = file.setPosition(this->mGridOffsets[grid->getGridId()]) && this->readGrid(file, grid, true, this->mGrids);
+		if (ok)
+			++loaded;
+	}
+	file.close();
+
+	if (!ok)
+	{
+		Con::errorf("Immersive AI :: Seek :: PathMap streaming stopped - unable to read %s, paged out tiles are unavailable", this->mStreamFile);
+		this->mStreamFile = 0;
+		this->mStreamQueue.clear();
+	}
+
+	return loaded;
+}
+
+U32 iAIPathMap::evictTiles()
+{
+	PROFILE_SCOPE(iAIPathMap_evictTiles);
+
+	S32 budget = Con::getIntVariable("$iAIPathMap::streamBudget", IAIPATHMAP_STREAM_BUDGET);
+	if (budget <= 0)
+		return 0;
+
+	U32 used = 0;
+	for (U32 i = 0; i < this->mGrids.size(); ++i)
+		used += this->mGrids[i]->getMemoryUsage();
+
+	// tiles under a path can't go this update
+	Vector<U8> kept;
+	kept.setSize(this->mGrids.size());
+	dMemset(kept.address(), 0, kept.size());
+
+	U32 evicted = 0;
+	while (used > ((U32)budget * 1024 * 1024))
+	{
+		// least recently used terrain tile, not used since the last update
+		iAIPathGrid *oldest = 0;
+		for (U32 i = 0; i < this->mGrids.size(); ++i)
+		{
+			iAIPathGrid *grid = this->mGrids[i];
+			if (kept[i] || grid->isInteriorGrid() || !grid->isResident() || (this->mGridUsed[i] >= this->mStreamTick))
+				continue;
+
+			if (!oldest || (this->mGridUsed[i] < this->mGridUsed[oldest->getGridId()]))
+				oldest = grid;
+		}
+
+		// everything left is needed
+		if (!oldest)
+			break;
+
+		// paths hold on to the nodes they cross
+		Box3F tileBox = oldest->mGridBox;
+		tileBox.min.z = -F32_MAX;
+		tileBox.max.z = F32_MAX;
+		if (iAIPathHandle::isAreaInUse(tileBox))
+		{
+			kept[oldest->getGridId()] = true;
+			continue;
+		}
+
+		used -= oldest->getMemoryUsage();
+		this->unlinkGrid(oldest);
+		oldest->releaseNodes();
+		++evicted;
+	}
+
+	return evicted;
+}
+
+void iAIPathMap::unlinkGrid(iAIPathGrid *grid)
+{
+	for (U32 i = 0; i < grid->mNodes.size(); ++i)
+	{
+		iAIPathNode *node = grid->mNodes[i];
+		for (U32 j = 0; j < node->mNeighbours.size(); ++j)
+		{
+			iAIPathNode *neighbour = node->mNeighbours[j];
+			if (neighbour->mParentGrid == grid)
+				continue;
+
+			// relinked when the grid is read back in
+			if (neighbour->removeNeighbour(node))
+				++neighbour->mPagedLinks;
+		}
+	}
+}
+
+iAIPathNode* iAIPathMap::getClosestNode(const Point3F position)
+{
+	PROFILE_SCOPE(iAIPathMap_getClosestNode);
+	return this->mIndex.findClosest(position);
+}
+
+U32 iAIPathMap::getClosestNodes(const Point3F position, const U32 count, Vector<iAIPathNode*> &replyList)
+{
+	PROFILE_SCOPE(iAIPathMap_getClosestNodes);
+	return this->mIndex.findClosest(position, count, replyList);
+}
+
+U32 iAIPathMap::getNodesInRadius(const Point3F position, const F32 radius, Vector<iAIPathNode*> &replyList)
+{
+	PROFILE_SCOPE(iAIPathMap_getNodesInRadius);
+	return this->mIndex.findInRadius(position, radius, replyList);
+}
+
+void iAIPathMap::benchmarkQueries(const U32 queryCount)
+{
+	if (this->mIndex.isEmpty() || (queryCount == 0))
+	{
+		Con::errorf("Immersive AI :: Seek :: PathMap - nothing to benchmark, build the pathmap first!");
+		return;
+	}
+
+	// generate the query points within the bounds of the map, so every query type sees the same points
+	Box3F bounds = this->mIndex.getBounds();
+	Vector<Point3F> queryPoints;
+	queryPoints.setSize(queryCount);
+	for (U32 i = 0; i < queryCount; ++i)
+	{
+		queryPoints[i].x = gRandGen.randF(bounds.min.x, bounds.max.x);
+		queryPoints[i].y = gRandGen.randF(bounds.min.y, bounds.max.y);
+		queryPoints[i].z = gRandGen.randF(bounds.min.z, bounds.max.z);
+	}
+
+	Vector<iAIPathNode*> replyList;
+	U32 found = 0;
+
+	// closest node via the index
+	U32 startTime = Platform::getRealMilliseconds();
+	for (U32 i = 0; i < queryCount; ++i)
+	{
+		if (this->mIndex.findClosest(queryPoints[i]))
+			++found;
+	}
+	U32 closestTime = Platform::getRealMilliseconds() - startTime;
+
+	// 8 nearest via the index
+	startTime = Platform::getRealMilliseconds();
+	for (U32 i = 0; i < queryCount; ++i)
+		found += this->mIndex.findClosest(queryPoints[i], 8, replyList);
+	U32 nearestTime = Platform::getRealMilliseconds() - startTime;
+
+	// radius of one index cell via the index
+	startTime = Platform::getRealMilliseconds();
+	for (U32 i = 0; i < queryCount; ++i)
+		found += this->mIndex.findInRadius(queryPoints[i], IAIPATHINDEX_CELL_SIZE, replyList);
+	U32 radiusTime = Platform::getRealMilliseconds() - startTime;
+
+	// the old linear scan of every grid, for comparison
+	startTime = Platform::getRealMilliseconds();
+	for (U32 i = 0; i < queryCount; ++i)
+	{
+		for (U32 j = 0; j < this->mGrids.size(); ++j)
+		{
+			if (this->mGrids[j]->getClosestNode(queryPoints[i]))
+				++found;
+		}
+	}
+	U32 scanTime = Platform::getRealMilliseconds() - startTime;
+
+	Con::iAIMessagef("Immersive AI :: Seek :: PathMap query benchmark - %d nodes, %d queries each (%d results)", this->mIndex.getNodeCount(), queryCount, found);
+	Con::iAIMessagef("Immersive AI :: Seek ::   closest node:   %d ms (%.0f queries/sec)", closestTime, queryCount * 1000.0f / getMax(closestTime, (U32)1));
+	Con::iAIMessagef("Immersive AI :: Seek ::   8 nearest:      %d ms (%.0f queries/sec)", nearestTime, queryCount * 1000.0f / getMax(nearestTime, (U32)1));
+	Con::iAIMessagef("Immersive AI :: Seek ::   radius %.1f:    %d ms (%.0f queries/sec)", IAIPATHINDEX_CELL_SIZE, radiusTime, queryCount * 1000.0f / getMax(radiusTime, (U32)1));
+	Con::iAIMessagef("Immersive AI :: Seek ::   grid scan:      %d ms (%.0f queries/sec)", scanTime, queryCount * 1000.0f / getMax(scanTime, (U32)1));
+}
+
+ConsoleMethodGroupBegin(iAIPathMap, ScriptFunctions, "iAIPathMap Script Functions");
+
+ConsoleMethod( iAIPathMap, initialize, bool, 2, 2,
+			  "bool iAIPathMap.initialize() - Initializes the PathMap for the current mission.")
+{
+	return object->initialize();
+}
+
+ConsoleMethod( iAIPathMap, initializeAsync, bool, 2, 2,
+			  "bool iAIPathMap.initializeAsync() - Initializes the PathMap for the current mission in the background. Calls onPathMapReady(%success) when done.")
+{
+	return object->initializeAsync();
+}
+
+ConsoleMethod( iAIPathMap, cancelBuild, void, 2, 2,
+			  "void iAIPathMap.cancelBuild() - Stops a background build.")
+{
+	object->cancelBuild();
+}
+
+ConsoleMethod( iAIPathMap, getBuildProgress, F32, 2, 2,
+			  "F32 iAIPathMap.getBuildProgress() - Progress of the PathMap build, from 0 to 1.")
+{
+	return object->getBuildProgress();
+}
+
+ConsoleMethod( iAIPathMap, rebuildRegion, bool, 4, 4,
+			  "bool iAIPathMap.rebuildRegion(Point3F min, Point3F max) - Rebuilds the nodes within the box, e.g. after a shape is placed or removed.")
+{
+	Box3F region;
+	dSscanf(argv[2], "%f %f %f", &region.min.x, &region.min.y, &region.min.z);
+	dSscanf(argv[3], "%f %f %f", &region.max.x, &region.max.y, &region.max.z);
+
+	return object->rebuildRegion(region);
+}
+
+ConsoleMethod( iAIPathMap, addObstacleBox, S32, 5, 6,
+			  "int iAIPathMap.addObstacleBox(Point3F min, Point3F max, F32 cost, [bool blocked]) - Lays a box of extra cost over the pathmap. Returns the obstacle id.")
+{
+	Box3F box;
+	dSscanf(argv[2], "%f %f %f", &box.min.x, &box.min.y, &box.min.z);
+	dSscanf(argv[3], "%f %f %f", &box.max.x, &box.max.y, &box.max.z);
+
+	return object->addObstacle(box, dAtof(argv[4]), (argc > 5) ? dAtob(argv[5]) : false);
+}
+
+ConsoleMethod( iAIPathMap, addObstacleCircle, S32, 5, 6,
+			  "int iAIPathMap.addObstacleCircle(Point3F centre, F32 radius, F32 cost, [bool blocked]) - Lays a circle of extra cost over the pathmap. Returns the obstacle id.")
+{
+	Point3F centre;
+	dSscanf(argv[2], "%f %f %f", &centre.x, &centre.y, &centre.z);
+
+	return object->addObstacle(centre, dAtof(argv[3]), dAtof(argv[4]), (argc > 5) ? dAtob(argv[5]) : false);
+}
+
+ConsoleMethod( iAIPathMap, removeObstacle, bool, 3, 3,
+			  "bool iAIPathMap.removeObstacle(int id) - Removes an obstacle added with addObstacleBox or addObstacleCircle.")
+{
+	return object->removeObstacle(dAtoi(argv[2]));
+}
+
+ConsoleMethod( iAIPathMap, clearObstacles, void, 2, 2,
+			  "iAIPathMap.clearObstacles() - Removes all obstacles from the pathmap.")
+{
+	object->clearObstacles();
+}
+
+ConsoleMethod( iAIPathMap, addCostProfile, void, 6, 6,
+			  "iAIPathMap.addCostProfile(string name, float water, float slope, float surface) - Registers a cost profile, weighting each baked cost channel. Paths are found with it by parsing the name to iAIPath.createPath.")
+{
+	iAIPathProfile *profile = object->addCostProfile(argv[2]);
+	profile->setWeight(iAIPathNode::CostWater, dAtof(argv[3]));
+	profile->setWeight(iAIPathNode::CostSlope, dAtof(argv[4]));
+	profile->setWeight(iAIPathNode::CostSurface, dAtof(argv[5]));
+
+	// paths found with the old weights no longer hold
+	iAIPathHandle::flushCache();
+}
+
+ConsoleMethod( iAIPathMap, setCostProfileSurface, bool, 5, 5,
+			  "bool iAIPathMap.setCostProfileSurface(string name, string material, float cost) - Overrides the cost of a terrain material for a cost profile.")
+{
+	iAIPathProfile *profile = object->findCostProfile(argv[2]);
+	if (!profile)
+	{
+		Con::errorf("Immersive AI :: Seek :: PathMap - no cost profile named %s", argv[2]);
+		return false;
+	}
+
+	if (!profile->setSurfaceCost(argv[3], dAtof(argv[4])))
+	{
+		Con::iAIMessagef("Immersive AI :: Seek :: PathMap - terrain has no material %s for cost profile %s", argv[3], argv[2]);
+		return false;
+	}
+
+	iAIPathHandle::flushCache();
+	return true;
+}
+
+ConsoleMethod( iAIPathMap, toggleDisplay, void, 2, 2,
+			  "void iAIPathMap.toggleDisplay() - Toggles displaying of the pathmap.")
+{
+	object->toggleDisplay();
+}
+
+ConsoleMethod( iAIPathMap, closestNode, const char *, 3, 3,
+			  "Point3F iAIPathMap.closestNode(Point3F pos) - Get the closest node to the supplied position.")
+{
+	// ensure pos passed
+	if (dStrlen(argv[2]) != 0) {
+
+		// pass the args into a Point3F
+		Point3F position;
+		dSscanf(argv[2], "%f %f %f", &position.x, &position.y, &position.z);
+
+		// get the closest node
+		iAIPathNode* closestNode = object->getClosestNode(position);
+
+		// ensure found a closest index
+		if (closestNode)
+		{
+			char *returnBuffer = Con::getReturnBuffer(256);
+			dSprintf(returnBuffer, 256, "%f %f %f", closestNode->mPosition.x, closestNode->mPosition.y, closestNode->mPosition.z);
+
+			return returnBuffer;
+		} else
+		{
+			Con::errorf("Immersive AI :: Seek :: PathMap - no node found near %f %f %f", &position.x, &position.y, &position.z);
+			return "";
+		}
+	} else
+	{
+		Con::errorf("Immersive AI :: Seek :: PathMap - no Point3F parsed to ClosestNode!");
+		return "";
+	}
+}
+
+ConsoleMethod( iAIPathMap, closestNodes, const char *, 4, 4,
+			  "string iAIPathMap.closestNodes(Point3F pos, S32 count) - Get the closest count nodes to the supplied position, as tab separated positions.")
+{
+	// pass the args into a Point3F
+	Point3F position;
+	dSscanf(argv[2], "%f %f %f", &position.x, &position.y, &position.z);
+
+	Vector<iAIPathNode*> nodes;
+	object->getClosestNodes(position, getMax(dAtoi(argv[3]), 0), nodes);
+
+	// each position takes at most 64 chars
+	U32 bufferSize = (nodes.size() * 64) + 1;
+	char *returnBuffer = Con::getReturnBuffer(bufferSize);
+	returnBuffer[0] = 0;
+
+	U32 length = 0;
+	for (U32 i = 0; i < nodes.size(); ++i)
+		length += dSprintf(returnBuffer + length, bufferSize - length, (i == 0) ? "%f %f %f" : "\t%f %f %f", nodes[i]->mPosition.x, nodes[i]->mPosition.y, nodes[i]->mPosition.z);
+
+	return returnBuffer;
+}
+
+ConsoleMethod( iAIPathMap, nodesInRadius, const char *, 4, 4,
+			  "string iAIPathMap.nodesInRadius(Point3F pos, F32 radius) - Get all nodes within the radius of the supplied position, as tab separated positions.")
+{
+	// pass the args into a Point3F
+	Point3F position;
+	dSscanf(argv[2], "%f %f %f", &position.x, &position.y, &position.z);
+
+	Vector<iAIPathNode*> nodes;
+	object->getNodesInRadius(position, dAtof(argv[3]), nodes);
+
+	// each position takes at most 64 chars
+	U32 bufferSize = (nodes.size() * 64) + 1;
+	char *returnBuffer = Con::getReturnBuffer(bufferSize);
+	returnBuffer[0] = 0;
+
+	U32 length = 0;
+	for (U32 i = 0; i < nodes.size(); ++i)
+		length += dSprintf(returnBuffer + length, bufferSize - length, (i == 0) ? "%f %f %f" : "\t%f %f %f", nodes[i]->mPosition.x, nodes[i]->mPosition.y, nodes[i]->mPosition.z);
+
+	return returnBuffer;
+}
+
+ConsoleMethod( iAIPathMap, benchmarkQueries, void, 2, 3,
+			  "void iAIPathMap.benchmarkQueries(S32 count = 10000) - Time random node queries against the pathmap.")
+{
+	U32 queryCount = 10000;
+	if ((argc > 2) && (dAtoi(argv[2]) > 0))
+		queryCount = dAtoi(argv[2]);
+
+	object->benchmarkQueries(queryCount);
+}
+
+ConsoleMethod( iAIPathMap, saveCache, bool, 2, 2,
+			  "bool iAIPathMap.saveCache() - Writes the current PathMap to the mission's cache file.")
+{
+	char fileName[1024];
+	if (!object->getCacheFileName(fileName, sizeof(fileName)))
+	{
+		Con::errorf("Immersive AI :: Seek :: PathMap - no mission loaded to cache!");
+		return false;
+	}
+
+	return object->savePathMap(fileName, object->getCacheKey());
+}
+
 ConsoleMethodGroupEnd(iAIPathMap, ScriptFunctions);
\ No newline at end of file
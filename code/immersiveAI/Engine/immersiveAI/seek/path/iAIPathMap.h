@@ -1,114 +1,823 @@
-//-------------------------------------------------------------------
-// Immersive AI :: Seek :: iAIPathMap
-// Copyright (c) 2006 Gavin Bunney & Tom Romano
-//-------------------------------------------------------------------
-
-//-------------------------------------------------------------------
-/// @file iAIPathMap.h
-//-------------------------------------------------------------------
-/// @class iAIPathMap
-/// @author Gavin Bunney
-/// @version 1.0
-/// @brief Map of all nodes within the mission.
-/// 
-/// Holds a collection of all grids (collections of nodes) for the
-/// current server map. The map creates grids and maps links between
-/// them allowing for A* pathfinding.
-//-------------------------------------------------------------------
-#ifndef _IAIPATHMAP_H_
-#define _IAIPATHMAP_H_
-
-#include "iAIPathMap.h"
-#include "iAIPathGrid.h"
-#include "iAIPathNode.h"
-
-class iAIPathMap : public SimObject
-{
-	typedef SimObject Parent;
-	friend class iAIPath;
-
-public:
-	
-	//-------------------------------------------------------------------
-	/// @var DECLARE_CONOBJECT(iAIPathMap)
-	/// @brief TorqueScript object.
-	//-------------------------------------------------------------------
-	DECLARE_CONOBJECT(iAIPathMap);
-
-	//-------------------------------------------------------------------
-	/// @fn iAIPathMap() 
-	/// @brief Default constructor.
-	//-------------------------------------------------------------------
-	iAIPathMap();
-
-	//-------------------------------------------------------------------
-	/// @fn ~iAIPathMap() 
-	/// @brief Deconstructor which clears all the grids.
-	//-------------------------------------------------------------------
-	~iAIPathMap();
-
-	//-------------------------------------------------------------------
-	/// @fn bool initialize()
-	/// @brief Initializes the pathmap for the current server map.
-	///
-	/// @return initialization success.
-	//-------------------------------------------------------------------
-	bool initialize();
-
-	//-------------------------------------------------------------------
-	/// @fn bool createPathMap()
-	/// @brief Creates the pathmap for the current server map.
-	///
-	/// @return creation success.
-	//-------------------------------------------------------------------
-	bool createPathMap();
-
-	//-------------------------------------------------------------------
-	/// @fn void clearMap()
-	/// @brief Clears the map.
-	//-------------------------------------------------------------------
-	void clearMap();
-
-	//-------------------------------------------------------------------
-	/// @fn void toggleDisplay()
-	/// @brief Toggle displaying of the pathmap.
-	//-------------------------------------------------------------------
-	void toggleDisplay();
-
-	//-------------------------------------------------------------------
-	/// @fn iAIPathNode* getClosestNode(const Point3F position)
-	/// @brief Retrieves the closest node to the parsed position
-	///
-	/// @param position world point of node to find
-	/// @return pointer to closest node
-	//-------------------------------------------------------------------
-	iAIPathNode* getClosestNode(const Point3F position);
-
-	//-------------------------------------------------------------------
-	/// @fn static U32 smNodeCount
-	/// @brief Total count of nodes in the Path Map.
-	//-------------------------------------------------------------------
-	static U32 smNodeCount;
-	
-protected:
-
-	//-------------------------------------------------------------------
-	/// @var Vector<iAIPathGrid*> mGrids
-	/// @brief Vector of all grids in the world.
-	//-------------------------------------------------------------------
-	Vector<iAIPathGrid*> mGrids;
-
-	//-------------------------------------------------------------------
-	/// @var bool mCompiled
-	/// @brief Flag for when a pathmap has been compiled successfully.
-	//-------------------------------------------------------------------
-	bool mCompiled;
-
-	//-------------------------------------------------------------------
-	/// @var U32 mTerrainGridIndex
-	/// @brief Holds the index of the terrain grid within mGrids.
-	//-------------------------------------------------------------------
-	U32 mTerrainGridIndex;
-};
-
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathMap
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+//-------------------------------------------------------------------
+/// @file iAIPathMap.h
+//-------------------------------------------------------------------
+/// @class iAIPathMap
+/// @author Gavin Bunney
+/// @version 1.0
+/// @brief Map of all nodes within the mission.
+/// 
+/// Holds a collection of all grids (collections of nodes) for the
+/// current server map. The map creates grids and maps links between
+/// them allowing for A* pathfinding.
+///
+/// The terrain is split into tiles of IAIPATHGLOBAL_GRID_TILE_SIZE
+/// nodes across, each built as a grid of its own and stitched to the
+/// tiles around it. Tiles left without any nodes are dropped, so the
+/// memory used follows the populated area rather than its bounds.
+///
+/// With $iAIPathMap::streamBudget set, terrain tiles are paged in from
+/// the cache file around the agents and the paths asked for, and the
+/// least recently used are paged back out to stay within the budget.
+//-------------------------------------------------------------------
+#ifndef _IAIPATHMAP_H_
+#define _IAIPATHMAP_H_
+
+#include "iAIPathMap.h"
+#include "iAIPathGrid.h"
+#include "iAIPathNode.h"
+#include "iAIPathIndex.h"
+#include "iAIPathOverlay.h"
+#include "iAIPathProfile.h"
+
+class Stream;
+class iAIPathMapBuildThread;
+
+//-------------------------------------------------------------------
+/// @def IAIPATHMAP_CACHE_MAGIC
+/// @brief Identifier at the start of a pathmap cache file.
+//-------------------------------------------------------------------
+#define IAIPATHMAP_CACHE_MAGIC			0x4D504149
+
+//-------------------------------------------------------------------
+/// @def IAIPATHMAP_CACHE_VERSION
+/// @brief Version of the pathmap cache file format. Files of any
+///        other version are ignored and rebuilt.
+//-------------------------------------------------------------------
+#define IAIPATHMAP_CACHE_VERSION		11
+
+//-------------------------------------------------------------------
+/// @def IAIPATHMAP_CACHE_EXTENSION
+/// @brief Extension replacing the mission file extension to name the
+///        pathmap cache file.
+//-------------------------------------------------------------------
+#define IAIPATHMAP_CACHE_EXTENSION		".pathmap"
+
+//-------------------------------------------------------------------
+/// @def IAIPATHMAP_BUILD_POLL_TIME
+/// @brief Milliseconds between checks on a background build.
+//-------------------------------------------------------------------
+#define IAIPATHMAP_BUILD_POLL_TIME		100
+
+//-------------------------------------------------------------------
+/// @def IAIPATHMAP_STREAM_BUDGET
+/// @brief Default megabytes of terrain tiles kept in memory. Can be
+///        changed via $iAIPathMap::streamBudget, 0 keeps every tile.
+//-------------------------------------------------------------------
+#define IAIPATHMAP_STREAM_BUDGET		0
+
+//-------------------------------------------------------------------
+/// @def IAIPATHMAP_STREAM_POLL_TIME
+/// @brief Milliseconds between updates of the tiles kept in memory.
+//-------------------------------------------------------------------
+#define IAIPATHMAP_STREAM_POLL_TIME		500
+
+//-------------------------------------------------------------------
+/// @def IAIPATHMAP_STREAM_RADIUS
+/// @brief Tiles kept in memory around the tile of each agent.
+//-------------------------------------------------------------------
+#define IAIPATHMAP_STREAM_RADIUS		1
+
+//-------------------------------------------------------------------
+/// @def IAIPATHMAP_STREAM_LOADS_PER_POLL
+/// @brief Most tiles read from the cache file per update.
+//-------------------------------------------------------------------
+#define IAIPATHMAP_STREAM_LOADS_PER_POLL	4
+
+class iAIPathMap : public SimObject
+{
+	typedef SimObject Parent;
+	friend class iAIPathHandle;
+
+public:
+	
+	//-------------------------------------------------------------------
+	/// @var DECLARE_CONOBJECT(iAIPathMap)
+	/// @brief TorqueScript object.
+	//-------------------------------------------------------------------
+	DECLARE_CONOBJECT(iAIPathMap);
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathMap() 
+	/// @brief Default constructor.
+	//-------------------------------------------------------------------
+	iAIPathMap();
+
+	//-------------------------------------------------------------------
+	/// @fn ~iAIPathMap() 
+	/// @brief Deconstructor which clears all the grids.
+	//-------------------------------------------------------------------
+	~iAIPathMap();
+
+	//-------------------------------------------------------------------
+	/// @fn bool initialize()
+	/// @brief Initializes the pathmap for the current server map.
+	///
+	/// Loads the pathmap from the mission's cache file if it is still
+	/// valid, otherwise creates the pathmap and saves the cache. Set
+	/// $iAIPathMap::useCache to false to always create.
+	///
+	/// @return initialization success.
+	//-------------------------------------------------------------------
+	bool initialize();
+
+	//-------------------------------------------------------------------
+	/// @fn bool initializeAsync()
+	/// @brief Initializes the pathmap for the current server map without
+	///        blocking the server. The cache is loaded straight away if
+	///        valid, otherwise the terrain tiles are compiled one at a
+	///        time on a worker thread while the world keeps ticking. Calls
+	///        onPathMapReady(%success) on the object once done.
+	///
+	/// @return true if the build was started.
+	//-------------------------------------------------------------------
+	bool initializeAsync();
+
+	//-------------------------------------------------------------------
+	/// @fn void updateBuild()
+	/// @brief Polls the background build; reports progress and
+	///        finishes the pathmap once the worker is done.
+	//-------------------------------------------------------------------
+	void updateBuild();
+
+	//-------------------------------------------------------------------
+	/// @fn void cancelBuild()
+	/// @brief Stops the background build, discarding the tile being
+	///        compiled.
+	//-------------------------------------------------------------------
+	void cancelBuild();
+
+	//-------------------------------------------------------------------
+	/// @fn bool isBuilding()
+	/// @brief Checks if a background build is running.
+	///
+	/// @return true if building.
+	//-------------------------------------------------------------------
+	bool isBuilding() { return (this->mBuildThread != 0); }
+
+	//-------------------------------------------------------------------
+	/// @fn F32 getBuildProgress()
+	/// @brief Retrieves the progress of the pathmap build.
+	///
+	/// @return F32 progress from 0 to 1.
+	//-------------------------------------------------------------------
+	F32 getBuildProgress();
+
+	//-------------------------------------------------------------------
+	/// @fn void onRemove()
+	/// @brief Called on removal from Sim. Cancels any build.
+	//-------------------------------------------------------------------
+	void onRemove();
+
+	//-------------------------------------------------------------------
+	/// @fn bool createPathMap()
+	/// @brief Creates the pathmap for the current server map.
+	///
+	/// @return creation success.
+	//-------------------------------------------------------------------
+	bool createPathMap();
+
+	//-------------------------------------------------------------------
+	/// @fn bool savePathMap(const char* fileName, const U32 key)
+	/// @brief Writes the compiled pathmap to a cache file. Refused if
+	///        the grids were built with $iAIPathMap::lazyEdges.
+	///
+	/// @param fileName file to write.
+	/// @param key cache key of the current mission.
+	/// @return save success.
+	//-------------------------------------------------------------------
+	bool savePathMap(const char* fileName, const U32 key);
+
+	//-------------------------------------------------------------------
+	/// @fn bool loadPathMap(const char* fileName, const U32 key)
+	/// @brief Replaces the pathmap with one read from a cache file. The
+	///        file is read in one block and each grid's nodes are
+	///        placed in a single allocation. When streaming only the
+	///        interiors are read, leaving the terrain tiles paged out.
+	///
+	/// @param fileName file to read.
+	/// @param key cache key the file must match.
+	/// @return load success; the map is left empty on failure.
+	//-------------------------------------------------------------------
+	bool loadPathMap(const char* fileName, const U32 key);
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getCacheKey()
+	/// @brief Calculates the cache key of the current mission from the
+	///        terrain CRC, the mission area, the grid density & merge
+	///        levels and the bounds of every static collision object.
+	///
+	/// @return U32 cache key.
+	//-------------------------------------------------------------------
+	U32 getCacheKey();
+
+	//-------------------------------------------------------------------
+	/// @fn bool getCacheFileName(char* buffer, const U32 bufferSize)
+	/// @brief Retrieves the cache file name of the current mission.
+	///
+	/// @param buffer buffer to place the file name in.
+	/// @param bufferSize size of the buffer.
+	/// @return false if no mission is loaded.
+	//-------------------------------------------------------------------
+	bool getCacheFileName(char* buffer, const U32 bufferSize);
+
+	//-------------------------------------------------------------------
+	/// @fn bool rebuildRegion(const Box3F &region)
+	/// @brief Rebuilds only the nodes within the region and along its
+	///        border, re-indexes the map and invalidates any active
+	///        paths crossing the changed area.
+	///
+	/// @param region world box which has changed.
+	/// @return true if any grid was rebuilt.
+	//-------------------------------------------------------------------
+	bool rebuildRegion(const Box3F &region);
+
+	//-------------------------------------------------------------------
+	/// @fn U32 addObstacle(const Box3F &box, const F32 cost,
+	///                     const bool blocked)
+	/// @brief Lays a box obstacle over the pathmap without changing the
+	///        nodes. Active paths through a blocked box are invalidated.
+	///
+	/// @param box world box covering the obstacle.
+	/// @param cost additive cost of the nodes within the box.
+	/// @param blocked if true, the nodes are untraversable.
+	/// @return U32 id of the obstacle.
+	//-------------------------------------------------------------------
+	U32 addObstacle(const Box3F &box, const F32 cost, const bool blocked);
+
+	//-------------------------------------------------------------------
+	/// @fn U32 addObstacle(const Point3F &centre, const F32 radius,
+	///                     const F32 cost, const bool blocked)
+	/// @brief Lays a circle obstacle over the pathmap without changing
+	///        the nodes. Active paths through a blocked circle are
+	///        invalidated.
+	///
+	/// @param centre world centre of the obstacle.
+	/// @param radius radius of the obstacle in X & Y.
+	/// @param cost additive cost of the nodes within the circle.
+	/// @param blocked if true, the nodes are untraversable.
+	/// @return U32 id of the obstacle.
+	//-------------------------------------------------------------------
+	U32 addObstacle(const Point3F &centre, const F32 radius, const F32 cost, const bool blocked);
+
+	//-------------------------------------------------------------------
+	/// @fn bool removeObstacle(const U32 id)
+	/// @brief Removes an obstacle from the pathmap.
+	///
+	/// @param id id returned when the obstacle was added.
+	/// @return true if the obstacle was found.
+	//-------------------------------------------------------------------
+	bool removeObstacle(const U32 id);
+
+	//-------------------------------------------------------------------
+	/// @fn void clearObstacles()
+	/// @brief Removes all obstacles from the pathmap.
+	//-------------------------------------------------------------------
+	void clearObstacles();
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathOverlay* getOverlay()
+	/// @brief Retrieves the dynamic cost overlay of the pathmap.
+	///
+	/// @return pointer to the overlay.
+	//-------------------------------------------------------------------
+	iAIPathOverlay* getOverlay() { return &this->mOverlay; }
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathProfile* addCostProfile(const char *name)
+	/// @brief Registers a cost profile, or retrieves it if already
+	///        registered.
+	///
+	/// @param name name to find the profile by.
+	/// @return pointer to the profile.
+	//-------------------------------------------------------------------
+	iAIPathProfile* addCostProfile(const char *name);
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathProfile* findCostProfile(const char *name)
+	/// @brief Retrieves a registered cost profile.
+	///
+	/// @param name name of the profile.
+	/// @return pointer to the profile, or 0 if not registered.
+	//-------------------------------------------------------------------
+	iAIPathProfile* findCostProfile(const char *name);
+
+	//-------------------------------------------------------------------
+	/// @fn void clearCostProfiles()
+	/// @brief Removes all registered cost profiles.
+	//-------------------------------------------------------------------
+	void clearCostProfiles();
+
+	//-------------------------------------------------------------------
+	/// @fn void clearMap()
+	/// @brief Clears the map.
+	//-------------------------------------------------------------------
+	void clearMap();
+
+	//-------------------------------------------------------------------
+	/// @fn void toggleDisplay()
+	/// @brief Toggle displaying of the pathmap.
+	//-------------------------------------------------------------------
+	void toggleDisplay();
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathNode* getClosestNode(const Point3F position)
+	/// @brief Retrieves the closest node to the parsed position, across
+	///        all grids in the map.
+	///
+	/// @param position world point of node to find
+	/// @return pointer to closest node
+	//-------------------------------------------------------------------
+	iAIPathNode* getClosestNode(const Point3F position);
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getClosestNodes(const Point3F position, const U32 count,
+	///                         Vector<iAIPathNode*> &replyList)
+	/// @brief Retrieves the k closest nodes to the parsed position,
+	///        sorted from closest to furthest.
+	///
+	/// @param position world point to search around
+	/// @param count number of nodes to find
+	/// @param replyList Vector to place the found nodes in
+	/// @return U32 number of nodes found
+	//-------------------------------------------------------------------
+	U32 getClosestNodes(const Point3F position, const U32 count, Vector<iAIPathNode*> &replyList);
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getNodesInRadius(const Point3F position, const F32 radius,
+	///                          Vector<iAIPathNode*> &replyList)
+	/// @brief Retrieves all nodes within the radius of the position.
+	///
+	/// @param position world point to search around
+	/// @param radius radius to search within
+	/// @param replyList Vector to place the found nodes in
+	/// @return U32 number of nodes found
+	//-------------------------------------------------------------------
+	U32 getNodesInRadius(const Point3F position, const F32 radius, Vector<iAIPathNode*> &replyList);
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathNode* getNode(const U32 id)
+	/// @brief Retrieves a node by its id. Ids of lattice positions
+	///        within a merged region retrieve the region's node.
+	///
+	/// @param id id of the node, from iAIPathNode::getId().
+	/// @return pointer to the node, 0 if there is none.
+	//-------------------------------------------------------------------
+	iAIPathNode* getNode(const U32 id);
+
+	//-------------------------------------------------------------------
+	/// @fn bool requestTiles(const Point3F &position,
+	///                       const S32 radius = 0)
+	/// @brief Marks the terrain tiles around the position as in use,
+	///        queueing any paged out to be read back in.
+	///
+	/// @param position world point to request the tiles around.
+	/// @param radius tiles around the position's own to request.
+	/// @return true if the tile under the position is in memory, or
+	///         there is none to load.
+	//-------------------------------------------------------------------
+	bool requestTiles(const Point3F &position, const S32 radius = 0);
+
+	//-------------------------------------------------------------------
+	/// @fn bool isStreaming()
+	/// @brief Checks if terrain tiles are being paged in & out.
+	///
+	/// @return true if streaming.
+	//-------------------------------------------------------------------
+	bool isStreaming() { return (this->mStreamFile != 0); }
+
+	//-------------------------------------------------------------------
+	/// @fn void updateStream()
+	/// @brief Keeps the tiles around the agents in memory, reads in the
+	///        tiles requested since the last update and pages out the
+	///        least recently used over the budget.
+	//-------------------------------------------------------------------
+	void updateStream();
+
+	//-------------------------------------------------------------------
+	/// @fn void benchmarkQueries(const U32 queryCount)
+	/// @brief Runs random closest node, k-nearest and radius queries
+	///        against the node index and outputs the throughput, along
+	///        with the old per-grid scan for comparison.
+	///
+	/// @param queryCount number of queries of each type to run
+	//-------------------------------------------------------------------
+	void benchmarkQueries(const U32 queryCount);
+
+	//-------------------------------------------------------------------
+	/// @fn static U32 smNodeCount
+	/// @brief Total count of nodes in the Path Map.
+	//-------------------------------------------------------------------
+	static U32 smNodeCount;
+	
+protected:
+
+	//-------------------------------------------------------------------
+	/// @var Vector<iAIPathGrid*> mGrids
+	/// @brief Vector of all grids in the world.
+	//-------------------------------------------------------------------
+	Vector<iAIPathGrid*> mGrids;
+
+	//-------------------------------------------------------------------
+	/// @var iAIPathIndex mIndex
+	/// @brief Spatial index over the nodes of all grids.
+	//-------------------------------------------------------------------
+	iAIPathIndex mIndex;
+
+	//-------------------------------------------------------------------
+	/// @var iAIPathOverlay mOverlay
+	/// @brief Dynamic obstacle costs over the nodes of all grids.
+	//-------------------------------------------------------------------
+	iAIPathOverlay mOverlay;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<iAIPathProfile*> mCostProfiles
+	/// @brief Cost profiles registered from script.
+	//-------------------------------------------------------------------
+	Vector<iAIPathProfile*> mCostProfiles;
+
+	//-------------------------------------------------------------------
+	/// @fn void rebuildIndex()
+	/// @brief Rebuilds the spatial index from the nodes of all grids and
+	///        re-numbers the nodes for the overlay.
+	//-------------------------------------------------------------------
+	void rebuildIndex();
+
+	//-------------------------------------------------------------------
+	/// @fn Box3F getRegionArea(const Box3F &area)
+	/// @brief Grows the area in X & Y to cover every node region it
+	///        overlaps. Paths only pass through the node of a merged
+	///        region, so must be checked against the whole region.
+	///
+	/// @param area world box to grow.
+	/// @return Box3F of the area & the regions it touches.
+	//-------------------------------------------------------------------
+	Box3F getRegionArea(const Box3F &area);
+
+	//-------------------------------------------------------------------
+	/// @fn bool readPathMap(Stream &stream, const U32 key,
+	///                      const bool streaming)
+	/// @brief Reads the grids of a cache file from the stream.
+	///
+	/// @param streaming only read the nodes of the interior grids.
+	//-------------------------------------------------------------------
+	bool readPathMap(Stream &stream, const U32 key, const bool streaming);
+
+	//-------------------------------------------------------------------
+	/// @fn void writeGrid(Stream &stream, iAIPathGrid *grid)
+	/// @brief Writes a grid's block of the cache file; its bounds, then
+	///        each node with the ids of its neighbours.
+	//-------------------------------------------------------------------
+	void writeGrid(Stream &stream, iAIPathGrid *grid);
+
+	//-------------------------------------------------------------------
+	/// @fn bool readGrid(Stream &stream, iAIPathGrid *grid,
+	///                   const bool readNodes,
+	///                   const Vector<iAIPathGrid*> &grids)
+	/// @brief Reads a grid's block of the cache file. Links into other
+	///        grids are made both ways if that grid is loaded, otherwise
+	///        counted as paged out on the node.
+	///
+	/// @param grid grid to read into.
+	/// @param readNodes read the nodes too, not just the bounds.
+	/// @param grids every grid of the map, by id.
+	/// @return false if the block is invalid.
+	//-------------------------------------------------------------------
+	bool readGrid(Stream &stream, iAIPathGrid *grid, const bool readNodes, const Vector<iAIPathGrid*> &grids);
+
+	//-------------------------------------------------------------------
+	/// @fn void unlinkGrid(iAIPathGrid *grid)
+	/// @brief Drops the links other grids hold to the nodes of the
+	///        grid, counting them as paged out.
+	//-------------------------------------------------------------------
+	void unlinkGrid(iAIPathGrid *grid);
+
+	//-------------------------------------------------------------------
+	/// @fn void startStream(const char* fileName, const U32 key)
+	/// @brief Starts paging terrain tiles from the cache file, if
+	///        $iAIPathMap::streamBudget is set.
+	//-------------------------------------------------------------------
+	void startStream(const char* fileName, const U32 key);
+
+	//-------------------------------------------------------------------
+	/// @fn U32 loadQueuedTiles()
+	/// @brief Reads in the tiles requested, up to
+	///        IAIPATHMAP_STREAM_LOADS_PER_POLL. Stops streaming if the
+	///        cache file can't be read.
+	///
+	/// @return U32 number of tiles loaded.
+	//-------------------------------------------------------------------
+	U32 loadQueuedTiles();
+
+	//-------------------------------------------------------------------
+	/// @fn U32 evictTiles()
+	/// @brief Pages out the least recently used tiles until within the
+	///        budget. Tiles used since the last update, or under an
+	///        active path, are kept.
+	///
+	/// @return U32 number of tiles paged out.
+	//-------------------------------------------------------------------
+	U32 evictTiles();
+
+	//-------------------------------------------------------------------
+	/// @fn static void agentCallback(SceneObject *object, void *key)
+	/// @brief Container callback which collects the position of each
+	///        agent.
+	//-------------------------------------------------------------------
+	static void agentCallback(SceneObject *object, void *key);
+
+	//-------------------------------------------------------------------
+	/// @fn static void cacheKeyCallback(SceneObject *object, void *key)
+	/// @brief Container callback which adds an object's bounds to the
+	///        cache key.
+	//-------------------------------------------------------------------
+	static void cacheKeyCallback(SceneObject *object, void *key);
+
+	//-------------------------------------------------------------------
+	/// @fn static void interiorCallback(SceneObject *object, void *key)
+	/// @brief Container callback which collects the world box of each
+	///        interior.
+	//-------------------------------------------------------------------
+	static void interiorCallback(SceneObject *object, void *key);
+
+	//-------------------------------------------------------------------
+	/// @fn bool prepareTerrainTiles()
+	/// @brief Clears the map, builds a grid over each interior in the
+	///        mission area and lays out the terrain tiles around them,
+	///        ready to be prepared one by one.
+	///
+	/// @return false if no mission area, or too many tiles.
+	//-------------------------------------------------------------------
+	bool prepareTerrainTiles();
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathGrid* prepareTerrainTile()
+	/// @brief Prepares the grid of the next terrain tile, ready to be
+	///        compiled. Tiles which can't be built are skipped.
+	///
+	/// @return the unregistered grid, 0 once all tiles are done.
+	//-------------------------------------------------------------------
+	iAIPathGrid* prepareTerrainTile();
+
+	//-------------------------------------------------------------------
+	/// @fn void finishTerrainTile(iAIPathGrid *tile)
+	/// @brief Finishes a compiled terrain tile, adding it to the map if
+	///        it holds any nodes.
+	///
+	/// @param tile grid from prepareTerrainTile; deleted if empty.
+	//-------------------------------------------------------------------
+	void finishTerrainTile(iAIPathGrid *tile);
+
+	//-------------------------------------------------------------------
+	/// @fn bool startTerrainTile()
+	/// @brief Prepares the next terrain tile and starts compiling it on
+	///        a worker thread.
+	///
+	/// @return false once all tiles are done.
+	//-------------------------------------------------------------------
+	bool startTerrainTile();
+
+	//-------------------------------------------------------------------
+	/// @fn void addGrid(iAIPathGrid *grid)
+	/// @brief Adds a grid to the map & scene, numbering it for the ids
+	///        of its nodes.
+	///
+	/// @param grid grid to add.
+	//-------------------------------------------------------------------
+	void addGrid(iAIPathGrid *grid);
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathGrid* getTerrainTile(const S32 tileX, const S32 tileY)
+	/// @brief Retrieves the grid of a terrain tile.
+	///
+	/// @param tileX tile position in X.
+	/// @param tileY tile position in Y.
+	/// @return the tile's grid, 0 if outside the terrain or empty.
+	//-------------------------------------------------------------------
+	iAIPathGrid* getTerrainTile(const S32 tileX, const S32 tileY);
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathNode* getTerrainLatticeNode(const S32 idX,
+	///                                        const S32 idY)
+	/// @brief Retrieves the node at a position of the lattice spanning
+	///        all the terrain tiles.
+	///
+	/// @param idX ID in X across the whole terrain.
+	/// @param idY ID in Y across the whole terrain.
+	/// @return pointer to the node, 0 if none.
+	//-------------------------------------------------------------------
+	iAIPathNode* getTerrainLatticeNode(const S32 idX, const S32 idY);
+
+	//-------------------------------------------------------------------
+	/// @fn U32 stitchTilePair(iAIPathGrid *tile, iAIPathGrid *neighbour)
+	/// @brief Replaces the links between two neighbouring terrain tiles.
+	///        Each lattice edge crossing the border is checked as if
+	///        within one grid, and the nodes standing for its ends are
+	///        linked both ways. Border nodes take the obstructions just
+	///        across the border into their clearance.
+	///
+	/// @param tile first tile.
+	/// @param neighbour tile next to it, in any direction.
+	/// @return U32 number of links made.
+	//-------------------------------------------------------------------
+	U32 stitchTilePair(iAIPathGrid *tile, iAIPathGrid *neighbour);
+
+	//-------------------------------------------------------------------
+	/// @fn U32 stitchTerrainTiles(const Box3F &area)
+	/// @brief Replaces the links between every pair of neighbouring
+	///        terrain tiles where either borders the area.
+	///
+	/// @param area world area; only X & Y are checked.
+	/// @return U32 number of links made.
+	//-------------------------------------------------------------------
+	U32 stitchTerrainTiles(const Box3F &area);
+
+	//-------------------------------------------------------------------
+	/// @fn U32 stitchInteriorGrid(iAIPathGrid *interiorGrid)
+	/// @brief Replaces the links between an interior grid and the
+	///        terrain tiles. Every interior node in the buffer around
+	///        the interior is linked both ways to the terrain nodes
+	///        around it, where the link is valid.
+	///
+	/// @param interiorGrid grid to stitch.
+	/// @return U32 number of links made.
+	//-------------------------------------------------------------------
+	U32 stitchInteriorGrid(iAIPathGrid *interiorGrid);
+
+	//-------------------------------------------------------------------
+	/// @fn bool finishPathMap()
+	/// @brief Stitches the terrain tiles & interiors together, logs the
+	///        build stats and indexes all the nodes.
+	///
+	/// @return creation success.
+	//-------------------------------------------------------------------
+	bool finishPathMap();
+
+	//-------------------------------------------------------------------
+	/// @var U32 mBuildStart
+	/// @brief Real time the current build started.
+	//-------------------------------------------------------------------
+	U32 mBuildStart;
+
+	//-------------------------------------------------------------------
+	/// @var iAIPathGrid* mBuildGrid
+	/// @brief Terrain tile being compiled in the background.
+	//-------------------------------------------------------------------
+	iAIPathGrid *mBuildGrid;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mBuildTile
+	/// @brief Next terrain tile to prepare.
+	//-------------------------------------------------------------------
+	U32 mBuildTile;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<Box3F> mBuildAvoidList
+	/// @brief Interior boxes the terrain tiles are built around.
+	//-------------------------------------------------------------------
+	Vector<Box3F> mBuildAvoidList;
+
+	//-------------------------------------------------------------------
+	/// @var iAIPathMapBuildThread* mBuildThread
+	/// @brief Worker thread of the background build.
+	//-------------------------------------------------------------------
+	iAIPathMapBuildThread *mBuildThread;
+
+	//-------------------------------------------------------------------
+	/// @var volatile bool mBuildDone
+	/// @brief Set by the worker thread once the tile is compiled.
+	//-------------------------------------------------------------------
+	volatile bool mBuildDone;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mBuildEvent
+	/// @brief Id of the pending build poll event.
+	//-------------------------------------------------------------------
+	U32 mBuildEvent;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mBuildProgressReported
+	/// @brief Last progress step logged, in tenths.
+	//-------------------------------------------------------------------
+	U32 mBuildProgressReported;
+
+	//-------------------------------------------------------------------
+	/// @var bool mBuildUseCache
+	/// @brief Save the background build to the cache once done.
+	//-------------------------------------------------------------------
+	bool mBuildUseCache;
+
+	//-------------------------------------------------------------------
+	/// @var StringTableEntry mBuildCacheFile
+	/// @brief Cache file for the background build.
+	//-------------------------------------------------------------------
+	StringTableEntry mBuildCacheFile;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mBuildCacheKey
+	/// @brief Cache key taken when the background build started.
+	//-------------------------------------------------------------------
+	U32 mBuildCacheKey;
+
+	//-------------------------------------------------------------------
+	/// @var bool mCompiled
+	/// @brief Flag for when a pathmap has been compiled successfully.
+	//-------------------------------------------------------------------
+	bool mCompiled;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<iAIPathGrid*> mTiles
+	/// @brief Grid of each terrain tile, indexed by
+	///        (tileY * mTilesX) + tileX. 0 where the tile is empty.
+	//-------------------------------------------------------------------
+	Vector<iAIPathGrid*> mTiles;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mTilesX
+	/// @brief Count of terrain tiles, in X direction.
+	//-------------------------------------------------------------------
+	U32 mTilesX;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mTilesY
+	/// @brief Count of terrain tiles, in Y direction.
+	//-------------------------------------------------------------------
+	U32 mTilesY;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mTerrainNodesX
+	/// @brief Count of terrain lattice positions across all the tiles,
+	///        in X direction.
+	//-------------------------------------------------------------------
+	U32 mTerrainNodesX;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mTerrainNodesY
+	/// @brief Count of terrain lattice positions across all the tiles,
+	///        in Y direction.
+	//-------------------------------------------------------------------
+	U32 mTerrainNodesY;
+
+	//-------------------------------------------------------------------
+	/// @var Point3F mTerrainOrigin
+	/// @brief World position of the first terrain lattice position.
+	//-------------------------------------------------------------------
+	Point3F mTerrainOrigin;
+
+	//-------------------------------------------------------------------
+	/// @var F32 mTerrainStep
+	/// @brief World distance between terrain lattice positions.
+	//-------------------------------------------------------------------
+	F32 mTerrainStep;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<U32> mGridOffsets
+	/// @brief Position of each grid's block within the cache file, by
+	///        grid id.
+	//-------------------------------------------------------------------
+	Vector<U32> mGridOffsets;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<U32> mGridUsed
+	/// @brief Update each grid was last used in, by grid id. U32_MAX
+	///        keeps the grid in memory; set once it differs from the
+	///        cache file.
+	//-------------------------------------------------------------------
+	Vector<U32> mGridUsed;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<U32> mStreamQueue
+	/// @brief Ids of the grids waiting to be read in.
+	//-------------------------------------------------------------------
+	Vector<U32> mStreamQueue;
+
+	//-------------------------------------------------------------------
+	/// @var StringTableEntry mStreamFile
+	/// @brief Cache file tiles are paged from, 0 when not streaming.
+	//-------------------------------------------------------------------
+	StringTableEntry mStreamFile;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mStreamKey
+	/// @brief Cache key the file must still match.
+	//-------------------------------------------------------------------
+	U32 mStreamKey;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mStreamTick
+	/// @brief Count of stream updates, stamped on the grids as used.
+	//-------------------------------------------------------------------
+	U32 mStreamTick;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mStreamEvent
+	/// @brief Id of the pending stream update event.
+	//-------------------------------------------------------------------
+	U32 mStreamEvent;
+};
+
 #endif
\ No newline at end of file
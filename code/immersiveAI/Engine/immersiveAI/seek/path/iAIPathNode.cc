@@ -1,145 +1,191 @@
-//-------------------------------------------------------------------
-// Immersive AI :: Seek :: iAIPathNode
-// Copyright (c) 2006 Gavin Bunney & Tom Romano
-//-------------------------------------------------------------------
-
-#include "sceneGraph/sceneGraph.h"
-#include "sceneGraph/sceneState.h"
-
-#include "iAIPathGlobal.h"
-#include "iAIPathNode.h"
-#include "iAIPathMap.h"
-
-iAIPathNode::iAIPathNode(const Point3F position, iAIPathGrid* pathGrid, const U16 idX, const U16 idY)
-{
-	this->mPosition = position;
-	this->mIdX = idX;
-	this->mIdY = idY;
-	this->mParentGrid = pathGrid;
-
-	this->mMoveModifier = 0.0f;
-	this->mFitness = 0.0f;
-	this->mLowestCostFromStart = 0.0f;
-	this->mHeuristicCostToGoal = 0.0f;
-	this->mParent = 0;
-	this->mOpen = false;
-	this->mClosed = false;
-}
-
-iAIPathNode::~iAIPathNode()
-{
-	while (!this->mNeighbours.empty())
-	{
-		this->mNeighbours.erase((U32)0);
-	}
-	this->mNeighbours.clear();
-}
-
-bool iAIPathNode::isClear()
-{
-	Point3F start = this->mPosition;
-	Point3F end = this->mPosition + Point3F(0, 0, IAIPATHGLOBAL_NODE_CLEARANCE.z);
-
-	RayInfo dummy;
-
-	// if collided with something, isn't clear
-	if (gServerContainer.castRay(start, end, IAIPATHGLOBAL_COLLISION_MASK, &dummy))
-	{
-		return false;
-	}
-
-	// must be valid
-	return true;
-}
-
-bool iAIPathNode::isNeighbourValid(const Point3F neighbourPosition)
-{
-	// calculate vector in z
-	Point3F vec = this->mPosition - neighbourPosition;
-	F32 zSq = vec.z * vec.z;
-
-	// ensure difference in node height is valid
-	if (zSq > IAIPATHGLOBAL_MAX_SLOPE)
-		return false;
-
-	RayInfo dummy;
-	
-	// quick check from node to neighboour position
-	if (gServerContainer.castRay(this->mPosition, neighbourPosition, IAIPATHGLOBAL_COLLISION_MASK, &dummy))
-		return false;
-
-	// check 4 points around clearance box
-	Point3F offset = -Point3F(IAIPATHGLOBAL_NODE_CLEARANCE.x/2, 0, 0);
-	if (gServerContainer.castRay(this->mPosition + offset, neighbourPosition + offset, IAIPATHGLOBAL_COLLISION_MASK, &dummy))
-		return false;
-	offset = Point3F(IAIPATHGLOBAL_NODE_CLEARANCE.x/2, 0, 0);
-	if (gServerContainer.castRay(this->mPosition + offset, neighbourPosition + offset, IAIPATHGLOBAL_COLLISION_MASK, &dummy))
-		return false;
-	offset = Point3F(0, 0, IAIPATHGLOBAL_NODE_CLEARANCE.z);
-	if (gServerContainer.castRay(this->mPosition + offset, neighbourPosition + offset, IAIPATHGLOBAL_COLLISION_MASK, &dummy))
-		return false;
-	offset = Point3F(IAIPATHGLOBAL_NODE_CLEARANCE.x/2, 0, IAIPATHGLOBAL_NODE_CLEARANCE.z);
-	if (gServerContainer.castRay(this->mPosition + offset, neighbourPosition + offset, IAIPATHGLOBAL_COLLISION_MASK, &dummy))
-		return false;
-
-	// must be valid
-	return true;
-}
-
-bool iAIPathNode::addNeighbour(iAIPathNode* neighbour)
-{
-	if (neighbour)
-	{
-		// check that neighbour is valid before adding
-		if (isNeighbourValid(neighbour->mPosition))
-		{
-			this->mNeighbours.push_back(neighbour);
-			return true;
-		}
-	}
-	return false;
-}
-
-bool iAIPathNode::hasNeighbour(iAIPathNode* neighbour)
-{
-	if (neighbour)
-	{
-		// iterate over all neighbours
-		for (U32 i = 0; i < this->mNeighbours.size(); i++)
-		{
-			// if position match, then it has that neighbour!
-			if (this->mNeighbours[i]->mPosition == neighbour->mPosition)
-				return true;
-		}
-	}
-	return false;
-}
-
-bool iAIPathNode::removeNeighbour(iAIPathNode* neighbour)
-{
-	if (neighbour)
-	{
-		// iterate over all neighbours
-		for (U32 i = 0; i < this->mNeighbours.size(); i++)
-		{
-			// if position match, then it has that neighbour!
-			if (this->mNeighbours[i]->mPosition == neighbour->mPosition)
-			{
-				// remove the neighbour
-				this->mNeighbours.erase(i);
-				return true;
-			}
-		}
-	}
-	return false;
-}
-
-void iAIPathNode::updateMoveModifier()
-{
-	RayInfo dummy;
-	// check if the node is in water
-	if (gServerContainer.castRay(this->mPosition + Point3F(0,0,1000.0f), this->mPosition - Point3F(0, 0, IAIPATHGLOBAL_NODE_CLEARANCE.z / 2), WaterObjectType, &dummy))
-		this->mMoveModifier = IAIPATHGLOBAL_MOVE_MODIFIER_WATER;
-	else
-		this->mMoveModifier = 0.0f;
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathNode
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+#include "sceneGraph/sceneGraph.h"
+#include "sceneGraph/sceneState.h"
+
+#include "iAIPathGlobal.h"
+#include "iAIPathNode.h"
+#include "iAIPathMap.h"
+#include "iAIPathCollision.h"
+
+iAIPathNode::iAIPathNode()
+{
+	this->set(Point3F(0,0,0), 0, 0, 0);
+}
+
+iAIPathNode::iAIPathNode(const Point3F position, iAIPathGrid* pathGrid, const U16 idX, const U16 idY)
+{
+	this->set(position, pathGrid, idX, idY);
+}
+
+void iAIPathNode::set(const Point3F position, iAIPathGrid* pathGrid, const U16 idX, const U16 idY)
+{
+	this->mPosition = position;
+	this->mIdX = idX;
+	this->mIdY = idY;
+	this->mParentGrid = pathGrid;
+	this->mMapIndex = U32_MAX;
+	this->mPagedLinks = 0;
+	this->mSpanX = 1;
+	this->mSpanY = 1;
+
+	this->mMoveModifier = 0.0f;
+	for (U32 i = 0; i < iAIPathNode::CostChannelCount; ++i)
+		this->mCost[i] = 0.0f;
+	this->mSurface = IAIPATHGLOBAL_SURFACE_NONE;
+	this->mClearance = IAIPATHGLOBAL_NODE_CLEARANCE_MAX;
+	this->mFitness = 0.0f;
+	this->mLowestCostFromStart = 0.0f;
+	this->mHeuristicCostToGoal = 0.0f;
+	this->mParent = 0;
+	this->mOpen = false;
+	this->mClosed = false;
+}
+
+iAIPathNode::~iAIPathNode()
+{
+	while (!this->mNeighbours.empty())
+	{
+		this->mNeighbours.erase((U32)0);
+	}
+	this->mNeighbours.clear();
+}
+
+U32 iAIPathNode::getId()
+{
+	return (this->mParentGrid->getGridId() << IAIPATHGLOBAL_NODE_ID_LOCAL_BITS) | this->mParentGrid->getLatticeIndex(this);
+}
+
+Box3F iAIPathNode::getRegionBox()
+{
+	F32 step = this->mParentGrid ? this->mParentGrid->getDensityStep() : 0.0f;
+
+	// the node is on cell span / 2 of its region, counting from the anchor
+	Point3F below(((this->mSpanX / 2) + 0.5f) * step, ((this->mSpanY / 2) + 0.5f) * step, 0);
+	Point3F above(((this->mSpanX - 1 - (this->mSpanX / 2)) + 0.5f) * step, ((this->mSpanY - 1 - (this->mSpanY / 2)) + 0.5f) * step, 0);
+	return Box3F(this->mPosition - below, this->mPosition + above);
+}
+
+bool iAIPathNode::castRay(const Point3F start, const Point3F end, const iAIPathCollision* collision, U32* rayCount, RayInfo* info, const U32 mask)
+{
+	if (rayCount)
+		++(*rayCount);
+
+	// use the snapshot if building off the main thread
+	if (collision)
+		return collision->castRay(start, end, info);
+
+	RayInfo dummy;
+	return gServerContainer.castRay(start, end, mask, info ? info : &dummy);
+}
+
+bool iAIPathNode::isClear(const iAIPathCollision* collision, U32* rayCount, const U32 mask)
+{
+	Point3F start = this->mPosition;
+	Point3F end = this->mPosition + Point3F(0, 0, IAIPATHGLOBAL_NODE_CLEARANCE.z);
+
+	// if collided with something, isn't clear
+	if (iAIPathNode::castRay(start, end, collision, rayCount, 0, mask))
+	{
+		return false;
+	}
+
+	// must be valid
+	return true;
+}
+
+bool iAIPathNode::isNeighbourValid(const Point3F neighbourPosition, const iAIPathCollision* collision, U32* rayCount, const U32 mask)
+{
+	// calculate vector in z
+	Point3F vec = this->mPosition - neighbourPosition;
+	F32 zSq = vec.z * vec.z;
+
+	// ensure difference in node height is valid
+	if (zSq > IAIPATHGLOBAL_MAX_SLOPE)
+		return false;
+
+	return this->isLinkClear(neighbourPosition, collision, rayCount, mask);
+}
+
+bool iAIPathNode::isLinkClear(const Point3F neighbourPosition, const iAIPathCollision* collision, U32* rayCount, const U32 mask)
+{
+	// quick check from node to neighboour position
+	if (iAIPathNode::castRay(this->mPosition, neighbourPosition, collision, rayCount, 0, mask))
+		return false;
+
+	// check 4 points around clearance box
+	Point3F offset = -Point3F(IAIPATHGLOBAL_NODE_CLEARANCE.x/2, 0, 0);
+	if (iAIPathNode::castRay(this->mPosition + offset, neighbourPosition + offset, collision, rayCount, 0, mask))
+		return false;
+	offset = Point3F(IAIPATHGLOBAL_NODE_CLEARANCE.x/2, 0, 0);
+	if (iAIPathNode::castRay(this->mPosition + offset, neighbourPosition + offset, collision, rayCount, 0, mask))
+		return false;
+	offset = Point3F(0, 0, IAIPATHGLOBAL_NODE_CLEARANCE.z);
+	if (iAIPathNode::castRay(this->mPosition + offset, neighbourPosition + offset, collision, rayCount, 0, mask))
+		return false;
+	offset = Point3F(IAIPATHGLOBAL_NODE_CLEARANCE.x/2, 0, IAIPATHGLOBAL_NODE_CLEARANCE.z);
+	if (iAIPathNode::castRay(this->mPosition + offset, neighbourPosition + offset, collision, rayCount, 0, mask))
+		return false;
+
+	// must be valid
+	return true;
+}
+
+bool iAIPathNode::addNeighbour(iAIPathNode* neighbour)
+{
+	if (neighbour)
+	{
+		// check that neighbour is valid before adding
+		if (isNeighbourValid(neighbour->mPosition))
+		{
+			this->mNeighbours.push_back(neighbour);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool iAIPathNode::hasNeighbour(iAIPathNode* neighbour)
+{
+	if (neighbour)
+	{
+		// iterate over all neighbours
+		for (U32 i = 0; i < this->mNeighbours.size(); i++)
+		{
+			// if position match, then it has that neighbour!
+			if (this->mNeighbours[i]->mPosition == neighbour->mPosition)
+				return true;
+		}
+	}
+	return false;
+}
+
+bool iAIPathNode::removeNeighbour(iAIPathNode* neighbour)
+{
+	if (neighbour)
+	{
+		// iterate over all neighbours
+		for (U32 i = 0; i < this->mNeighbours.size(); i++)
+		{
+			// if position match, then it has that neighbour!
+			if (this->mNeighbours[i]->mPosition == neighbour->mPosition)
+			{
+				// remove the neighbour
+				this->mNeighbours.erase(i);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void iAIPathNode::updateMoveModifier()
+{
+	// the channels are baked by the grid; the default weighting is just their sum
+	this->mMoveModifier = 0.0f;
+	for (U32 i = 0; i < iAIPathNode::CostChannelCount; ++i)
+		this->mMoveModifier += this->mCost[i];
 }
\ No newline at end of file
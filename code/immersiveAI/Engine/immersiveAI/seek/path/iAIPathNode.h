@@ -1,180 +1,335 @@
-//-------------------------------------------------------------------
-// Immersive AI :: Seek :: iAIPathMap
-// Copyright (c) 2006 Gavin Bunney & Tom Romano
-//-------------------------------------------------------------------
-
-//-------------------------------------------------------------------
-/// @file iAIPathNode.h
-//-------------------------------------------------------------------
-/// @class iAIPathNode
-/// @author Gavin Bunney
-/// @version 1.0
-/// @brief Represents a single path finding node.
-/// 
-/// A point within the game world, consisting of a location, id, 
-/// neighbours and various path finding variables.
-//-------------------------------------------------------------------
-#ifndef _IAIPATHNODE_H_
-#define _IAIPATHNODE_H_
-
-class iAIPathNode {
-
-	friend class iAIPathMap;
-	friend class iAIPathGrid;
-	friend class iAIPath;
-	friend class iAIPathFind;
-
-public:
-
-	//-------------------------------------------------------------------
-	/// @fn iAIPathNode() 
-	/// @brief Default constructor.
-	//-------------------------------------------------------------------
-	iAIPathNode() { }
-
-	//-------------------------------------------------------------------
-	/// @fn ~iAIPathNode() 
-	/// @brief Default deconstructor.
-	//-------------------------------------------------------------------
-	~iAIPathNode();
-
-	//-------------------------------------------------------------------
-	/// @fn iAIPathNode(const Point3F position, iAIPathGrid* pathGrid, 
-	///                 const U16 idX, const U16 idY) 
-	/// @brief Constructor to create node at specified position.
-	///
-	/// @param position Point in world coords to create the node.
-	/// @param pathGrid Pointer to grid which the node is contained in.
-	/// @param idX ID in X of the node within the grid.
-	/// @param idY ID in Y of the node within the grid.
-	//-------------------------------------------------------------------
-	iAIPathNode(const Point3F position, iAIPathGrid* pathGrid, const U16 idX, const U16 idY);
-
-	//-------------------------------------------------------------------
-	/// @fn bool isClear()
-	/// @brief Checks if the node is in a valid position, clear of
-	///	       obstructions.
-	///
-	/// @return Node clear of all obstructions.
-	//-------------------------------------------------------------------
-	bool isClear();
-
-	//-------------------------------------------------------------------
-	/// @fn bool addNeighbour(iAIPathNode* neighbour)
-	/// @brief Adds a neighbour to this node's neighbour list.
-	///
-	/// @return Neighbour added to node neighbour list.
-	//-------------------------------------------------------------------
-	bool addNeighbour(iAIPathNode* neighbour);
-
-	//-------------------------------------------------------------------
-	/// @fn bool hasNeighbour(iAIPathNode* neighbour)
-	/// @brief Checks if the node has the parsed neighbour.
-	///
-	/// @return Neighbour in this node's neighbour list.
-	//-------------------------------------------------------------------
-	bool hasNeighbour(iAIPathNode* neighbour);
-
-	//-------------------------------------------------------------------
-	/// @fn bool removeNeighbour(iAIPathNode* neighbour)
-	/// @brief Removes the specified neighbour.
-	///
-	/// @return Neighbour was removed successfully.
-	//-------------------------------------------------------------------
-	bool removeNeighbour(iAIPathNode* neighbour);
-
-	//-------------------------------------------------------------------
-	/// @fn void bool isNeighbourValid(const Point3F neighbourPosition)
-	/// @brief Checks if a neighbour is accessible from this node.
-	///
-	/// @param neighbourPosition The position of the neighbour to check.
-	/// @return Neighbour in valid position
-	//-------------------------------------------------------------------
-	bool isNeighbourValid(const Point3F neighbourPosition);
-
-	//-------------------------------------------------------------------
-	/// @var Point3F mPosition
-	/// @brief Position of the node in world coordinates.
-	//-------------------------------------------------------------------
-	Point3F mPosition;
-
-	//-------------------------------------------------------------------
-	/// @var U16 mIdX
-	/// @brief ID in X within the node's grid.
-	//-------------------------------------------------------------------
-	U16 mIdX;
-
-	//-------------------------------------------------------------------
-	/// @var U16 mIdY
-	/// @brief ID in Y within the node's grid.
-	//-------------------------------------------------------------------
-	U16 mIdY;
-
-	//-------------------------------------------------------------------
-	/// @var Vector<iAIPathNode*> mNeighbours
-	/// @brief Vector of the nodes neighbours. Expect 8 neighbours, but
-	///        if edge of area or obstructed, will be less.
-	//-------------------------------------------------------------------
-	Vector<iAIPathNode*> mNeighbours;
-
-	//-------------------------------------------------------------------
-	/// @var iAIPathGrid* mParentGrid
-	/// @brief Pointer to the grid which the node is contained within.
-	//-------------------------------------------------------------------
-	iAIPathGrid* mParentGrid;
-
-	//-------------------------------------------------------------------
-	/// @fn void updateMoveModifier()
-	/// @brief Updates the node's move modifer, based on its position.
-	//-------------------------------------------------------------------
-	void updateMoveModifier();
-
-	//-------------------------------------------------------------------
-	/// @var F32 mMoveModifier
-	/// @brief Utilised in A* algorithm; the level of difficulty at this
-	//         node. 100.0f is untraversal, 0.0f is easiest.
-	//-------------------------------------------------------------------
-	F32 mMoveModifier;
-
-	//-------------------------------------------------------------------
-	/// @var F32 mFitness
-	/// @brief Utilised in A* algorithm; fitness of this node from a
-	///        start node.
-	//-------------------------------------------------------------------
-	F32 mFitness;
-
-	//-------------------------------------------------------------------
-	/// @var F32 mLowestCostFromStart
-	/// @brief Utilised in A* algorithm; lowest cost from the start node.
-	//-------------------------------------------------------------------
-	F32 mLowestCostFromStart;
-
-	//-------------------------------------------------------------------
-	/// @var F32 mHeuristicCostToGoal
-	/// @brief Utilised in A* algorithm; best guess cost to goal from this
-	///        node.
-	//-------------------------------------------------------------------
-	F32 mHeuristicCostToGoal;
-
-	//-------------------------------------------------------------------
-	/// @var iAIPathNode* mParent
-	/// @brief Utilised in A* algorithm; the node traversed previously to
-	///        reach this node.
-	//-------------------------------------------------------------------
-	iAIPathNode* mParent;
-
-	//-------------------------------------------------------------------
-	/// @var bool mOpen
-	/// @brief Utilised in A* algorithm; the node requires checking.
-	//-------------------------------------------------------------------
-	bool mOpen;
-
-	//-------------------------------------------------------------------
-	/// @var bool mClosed
-	/// @brief Utilised in A* algorithm; if node has been checked, set as
-	///        closed.
-	//-------------------------------------------------------------------
-	bool mClosed;
-};
-
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathMap
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+//-------------------------------------------------------------------
+/// @file iAIPathNode.h
+//-------------------------------------------------------------------
+/// @class iAIPathNode
+/// @author Gavin Bunney
+/// @version 1.0
+/// @brief Represents a single path finding node.
+/// 
+/// A point within the game world, consisting of a location, id, 
+/// neighbours and various path finding variables.
+//-------------------------------------------------------------------
+#ifndef _IAIPATHNODE_H_
+#define _IAIPATHNODE_H_
+
+#include "game/objectTypes.h"
+#include "iAIPathGlobal.h"
+
+class iAIPathCollision;
+struct RayInfo;
+
+class iAIPathNode {
+
+	friend class iAIPathMap;
+	friend class iAIPathGrid;
+	friend class iAIPathHandle;
+	friend class iAIPathFind;
+	friend class iAIPathOverlay;
+	friend class iAIPathProfile;
+	friend class iAIPathDensity;
+
+public:
+
+	//-------------------------------------------------------------------
+	/// @enum CostChannel
+	/// @brief The separate costs baked into each node when the pathmap
+	///        is built; summed into mMoveModifier.
+	//-------------------------------------------------------------------
+	enum CostChannel
+	{
+		CostWater = 0,		///< node is under water
+		CostSlope,			///< steepness of the ground under the node
+		CostSurface,		///< terrain material under the node
+		CostChannelCount
+	};
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathNode() 
+	/// @brief Default constructor.
+	//-------------------------------------------------------------------
+	iAIPathNode();
+
+	//-------------------------------------------------------------------
+	/// @fn ~iAIPathNode() 
+	/// @brief Default deconstructor.
+	//-------------------------------------------------------------------
+	~iAIPathNode();
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathNode(const Point3F position, iAIPathGrid* pathGrid, 
+	///                 const U16 idX, const U16 idY) 
+	/// @brief Constructor to create node at specified position.
+	///
+	/// @param position Point in world coords to create the node.
+	/// @param pathGrid Pointer to grid which the node is contained in.
+	/// @param idX ID in X of the node within the grid.
+	/// @param idY ID in Y of the node within the grid.
+	//-------------------------------------------------------------------
+	iAIPathNode(const Point3F position, iAIPathGrid* pathGrid, const U16 idX, const U16 idY);
+
+	//-------------------------------------------------------------------
+	/// @fn void set(const Point3F position, iAIPathGrid* pathGrid, 
+	///              const U16 idX, const U16 idY) 
+	/// @brief Sets the position and grid location of the node.
+	///
+	/// @param position Point in world coords of the node.
+	/// @param pathGrid Pointer to grid which the node is contained in.
+	/// @param idX ID in X of the node within the grid.
+	/// @param idY ID in Y of the node within the grid.
+	//-------------------------------------------------------------------
+	void set(const Point3F position, iAIPathGrid* pathGrid, const U16 idX, const U16 idY);
+
+	//-------------------------------------------------------------------
+	/// @fn bool isClear(const iAIPathCollision* collision = 0,
+	///          U32* rayCount = 0,
+	///          const U32 mask = IAIPATHGLOBAL_COLLISION_MASK)
+	/// @brief Checks if the node is in a valid position, clear of
+	///	       obstructions.
+	///
+	/// @param collision Collision snapshot to cast against. If not set
+	///        casts against the server container.
+	/// @param rayCount If set, incremented for each ray cast.
+	/// @param mask Object types to cast against the server container.
+	///        The snapshot holds only the types it was built with.
+	/// @return Node clear of all obstructions.
+	//-------------------------------------------------------------------
+	bool isClear(const iAIPathCollision* collision = 0, U32* rayCount = 0, const U32 mask = IAIPATHGLOBAL_COLLISION_MASK);
+
+	//-------------------------------------------------------------------
+	/// @fn bool addNeighbour(iAIPathNode* neighbour)
+	/// @brief Adds a neighbour to this node's neighbour list.
+	///
+	/// @return Neighbour added to node neighbour list.
+	//-------------------------------------------------------------------
+	bool addNeighbour(iAIPathNode* neighbour);
+
+	//-------------------------------------------------------------------
+	/// @fn bool hasNeighbour(iAIPathNode* neighbour)
+	/// @brief Checks if the node has the parsed neighbour.
+	///
+	/// @return Neighbour in this node's neighbour list.
+	//-------------------------------------------------------------------
+	bool hasNeighbour(iAIPathNode* neighbour);
+
+	//-------------------------------------------------------------------
+	/// @fn bool removeNeighbour(iAIPathNode* neighbour)
+	/// @brief Removes the specified neighbour.
+	///
+	/// @return Neighbour was removed successfully.
+	//-------------------------------------------------------------------
+	bool removeNeighbour(iAIPathNode* neighbour);
+
+	//-------------------------------------------------------------------
+	/// @fn void bool isNeighbourValid(const Point3F neighbourPosition,
+	///          const iAIPathCollision* collision = 0, U32* rayCount = 0,
+	///          const U32 mask = IAIPATHGLOBAL_COLLISION_MASK)
+	/// @brief Checks if a neighbour is accessible from this node. The
+	///        test is symmetric; the result holds in both directions.
+	///
+	/// @param neighbourPosition The position of the neighbour to check.
+	/// @param collision Collision snapshot to cast against. If not set
+	///        casts against the server container.
+	/// @param rayCount If set, incremented for each ray cast.
+	/// @param mask Object types to cast against the server container.
+	///        The snapshot holds only the types it was built with.
+	/// @return Neighbour in valid position
+	//-------------------------------------------------------------------
+	bool isNeighbourValid(const Point3F neighbourPosition, const iAIPathCollision* collision = 0, U32* rayCount = 0, const U32 mask = IAIPATHGLOBAL_COLLISION_MASK);
+
+	//-------------------------------------------------------------------
+	/// @fn bool isLinkClear(const Point3F neighbourPosition,
+	///          const iAIPathCollision* collision = 0, U32* rayCount = 0,
+	///          const U32 mask = IAIPATHGLOBAL_COLLISION_MASK)
+	/// @brief The collision half of isNeighbourValid; checks nothing
+	///        blocks the link, leaving the slope to the caller.
+	///
+	/// @param neighbourPosition The position of the neighbour to check.
+	/// @param collision Collision snapshot to cast against. If not set
+	///        casts against the server container.
+	/// @param rayCount If set, incremented for each ray cast.
+	/// @param mask Object types to cast against the server container.
+	///        The snapshot holds only the types it was built with.
+	/// @return Link is clear
+	//-------------------------------------------------------------------
+	bool isLinkClear(const Point3F neighbourPosition, const iAIPathCollision* collision = 0, U32* rayCount = 0, const U32 mask = IAIPATHGLOBAL_COLLISION_MASK);
+
+	//-------------------------------------------------------------------
+	/// @fn static bool castRay(const Point3F start, const Point3F end,
+	///          const iAIPathCollision* collision, U32* rayCount,
+	///          RayInfo* info = 0,
+	///          const U32 mask = IAIPATHGLOBAL_COLLISION_MASK)
+	/// @brief Casts a ray against the node collision mask.
+	///
+	/// @param start World point to start the ray.
+	/// @param end World point to end the ray.
+	/// @param collision Collision snapshot to cast against. If not set
+	///        casts against the server container.
+	/// @param rayCount If set, incremented for the ray.
+	/// @param info If set, filled in with the closest collision.
+	/// @param mask Object types to cast against the server container.
+	///        The snapshot holds only the types it was built with.
+	/// @return True if the ray collided with something.
+	//-------------------------------------------------------------------
+	static bool castRay(const Point3F start, const Point3F end, const iAIPathCollision* collision, U32* rayCount, RayInfo* info = 0, const U32 mask = IAIPATHGLOBAL_COLLISION_MASK);
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getId()
+	/// @brief Retrieves the id of the node within the whole pathmap; the
+	///        index of its grid in the high bits and its lattice index
+	///        within the grid in the low IAIPATHGLOBAL_NODE_ID_LOCAL_BITS.
+	///
+	/// @return U32 node id.
+	//-------------------------------------------------------------------
+	U32 getId();
+
+	//-------------------------------------------------------------------
+	/// @fn Box3F getRegionBox()
+	/// @brief Retrieves the world area the node stands for in X & Y;
+	///        its lattice cell, or every cell of its region once merged.
+	///        The node sits on the middle cell, not always the middle of
+	///        the box. The height is flat, at the node's.
+	///
+	/// @return Box3F of the node's region.
+	//-------------------------------------------------------------------
+	Box3F getRegionBox();
+
+	//-------------------------------------------------------------------
+	/// @var Point3F mPosition
+	/// @brief Position of the node in world coordinates.
+	//-------------------------------------------------------------------
+	Point3F mPosition;
+
+	//-------------------------------------------------------------------
+	/// @var U16 mIdX
+	/// @brief ID in X within the node's grid. Grids are kept small
+	///        enough, by tiling the terrain, for this to fit.
+	//-------------------------------------------------------------------
+	U16 mIdX;
+
+	//-------------------------------------------------------------------
+	/// @var U16 mIdY
+	/// @brief ID in Y within the node's grid.
+	//-------------------------------------------------------------------
+	U16 mIdY;
+
+	//-------------------------------------------------------------------
+	/// @var Vector<iAIPathNode*> mNeighbours
+	/// @brief Vector of the nodes neighbours. Expect 8 neighbours, but
+	///        if edge of area or obstructed, will be less.
+	//-------------------------------------------------------------------
+	Vector<iAIPathNode*> mNeighbours;
+
+	//-------------------------------------------------------------------
+	/// @var iAIPathGrid* mParentGrid
+	/// @brief Pointer to the grid which the node is contained within.
+	//-------------------------------------------------------------------
+	iAIPathGrid* mParentGrid;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mMapIndex
+	/// @brief Position of the node within the whole pathmap, used to
+	///        look up per-node data such as the cost overlay.
+	//-------------------------------------------------------------------
+	U32 mMapIndex;
+
+	//-------------------------------------------------------------------
+	/// @var U8 mSpanX
+	/// @brief Lattice positions in X covered by the node; more than 1
+	///        when it stands for a merged region of its grid.
+	//-------------------------------------------------------------------
+	U8 mSpanX;
+
+	//-------------------------------------------------------------------
+	/// @var U8 mSpanY
+	/// @brief Lattice positions in Y covered by the node.
+	//-------------------------------------------------------------------
+	U8 mSpanY;
+
+	//-------------------------------------------------------------------
+	/// @var U16 mPagedLinks
+	/// @brief Number of the node's links into terrain tiles which are
+	///        paged out of the pathmap; relinked once they're loaded.
+	//-------------------------------------------------------------------
+	U16 mPagedLinks;
+
+	//-------------------------------------------------------------------
+	/// @fn void updateMoveModifier()
+	/// @brief Updates the node's move modifer from its cost channels.
+	//-------------------------------------------------------------------
+	void updateMoveModifier();
+
+	//-------------------------------------------------------------------
+	/// @var F32 mCost[CostChannelCount]
+	/// @brief Cost of each channel at this node, baked by the grid.
+	//-------------------------------------------------------------------
+	F32 mCost[CostChannelCount];
+
+	//-------------------------------------------------------------------
+	/// @var F32 mClearance
+	/// @brief Distance in X & Y from the node to the closest obstruction,
+	///        up to IAIPATHGLOBAL_NODE_CLEARANCE_MAX. Agents wider than
+	///        this can't pass through the node.
+	//-------------------------------------------------------------------
+	F32 mClearance;
+
+	//-------------------------------------------------------------------
+	/// @var U8 mSurface
+	/// @brief Terrain material index under the node, or
+	///        IAIPATHGLOBAL_SURFACE_NONE.
+	//-------------------------------------------------------------------
+	U8 mSurface;
+
+	//-------------------------------------------------------------------
+	/// @var F32 mMoveModifier
+	/// @brief Utilised in A* algorithm; the level of difficulty at this
+	//         node. 100.0f is untraversal, 0.0f is easiest.
+	//-------------------------------------------------------------------
+	F32 mMoveModifier;
+
+	//-------------------------------------------------------------------
+	/// @var F32 mFitness
+	/// @brief Utilised in A* algorithm; fitness of this node from a
+	///        start node.
+	//-------------------------------------------------------------------
+	F32 mFitness;
+
+	//-------------------------------------------------------------------
+	/// @var F32 mLowestCostFromStart
+	/// @brief Utilised in A* algorithm; lowest cost from the start node.
+	//-------------------------------------------------------------------
+	F32 mLowestCostFromStart;
+
+	//-------------------------------------------------------------------
+	/// @var F32 mHeuristicCostToGoal
+	/// @brief Utilised in A* algorithm; best guess cost to goal from this
+	///        node.
+	//-------------------------------------------------------------------
+	F32 mHeuristicCostToGoal;
+
+	//-------------------------------------------------------------------
+	/// @var iAIPathNode* mParent
+	/// @brief Utilised in A* algorithm; the node traversed previously to
+	///        reach this node.
+	//-------------------------------------------------------------------
+	iAIPathNode* mParent;
+
+	//-------------------------------------------------------------------
+	/// @var bool mOpen
+	/// @brief Utilised in A* algorithm; the node requires checking.
+	//-------------------------------------------------------------------
+	bool mOpen;
+
+	//-------------------------------------------------------------------
+	/// @var bool mClosed
+	/// @brief Utilised in A* algorithm; if node has been checked, set as
+	///        closed.
+	//-------------------------------------------------------------------
+	bool mClosed;
+};
+
 #endif
\ No newline at end of file
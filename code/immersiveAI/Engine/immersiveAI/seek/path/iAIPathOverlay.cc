@@ -0,0 +1,152 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathOverlay
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+#include "platform/platformMutex.h"
+#include "platform/profiler.h"
+
+#include "iAIPathGlobal.h"
+#include "iAIPathOverlay.h"
+#include "iAIPathIndex.h"
+
+iAIPathOverlay::iAIPathOverlay()
+{
+	this->mNextId = 1;
+	this->mFront = 0;
+	this->mBuffers[0].mReaders = 0;
+	this->mBuffers[1].mReaders = 0;
+	this->mMutex = Mutex::createMutex();
+}
+
+iAIPathOverlay::~iAIPathOverlay()
+{
+	this->mObstacles.clear();
+	Mutex::destroyMutex(this->mMutex);
+	this->mMutex = 0;
+}
+
+U32 iAIPathOverlay::addBox(const Box3F &box, const F32 cost, const bool blocked)
+{
+	Obstacle obstacle;
+	obstacle.mId = this->mNextId++;
+	obstacle.mCircle = false;
+	obstacle.mBox = box;
+	obstacle.mCentre = (box.min + box.max) * 0.5f;
+	obstacle.mRadius = 0.0f;
+	obstacle.mCost = cost;
+	obstacle.mBlocked = blocked;
+	this->mObstacles.push_back(obstacle);
+	return obstacle.mId;
+}
+
+U32 iAIPathOverlay::addCircle(const Point3F &centre, const F32 radius, const F32 cost, const bool blocked)
+{
+	Obstacle obstacle;
+	obstacle.mId = this->mNextId++;
+	obstacle.mCircle = true;
+	obstacle.mBox = Box3F(centre - Point3F(radius, radius, 0), centre + Point3F(radius, radius, 0));
+	obstacle.mCentre = centre;
+	obstacle.mRadius = radius;
+	obstacle.mCost = cost;
+	obstacle.mBlocked = blocked;
+	this->mObstacles.push_back(obstacle);
+	return obstacle.mId;
+}
+
+bool iAIPathOverlay::remove(const U32 id)
+{
+	for (U32 i = 0; i < this->mObstacles.size(); ++i)
+	{
+		if (this->mObstacles[i].mId == id)
+		{
+			this->mObstacles.erase_fast(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+void iAIPathOverlay::clear()
+{
+	this->mObstacles.clear();
+}
+
+void iAIPathOverlay::commit(const iAIPathIndex &index)
+{
+	PROFILE_SCOPE(iAIPathOverlay_commit);
+
+	Buffer &back = this->mBuffers[1 - this->mFront];
+
+	// a search which acquired the back buffer before the last swap may
+	// still be running; new searches only take the front, so just wait
+	Mutex::lockMutex(this->mMutex);
+	while (back.mReaders > 0)
+	{
+		Mutex::unlockMutex(this->mMutex);
+		Platform::sleep(0);
+		Mutex::lockMutex(this->mMutex);
+	}
+	Mutex::unlockMutex(this->mMutex);
+
+	// rasterise every obstacle into the back buffer
+	back.mCosts.setSize(index.getNodeCount());
+	if (back.mCosts.size() > 0)
+		dMemset(back.mCosts.address(), 0, back.mCosts.size() * sizeof(F32));
+
+	Vector<iAIPathNode*> nodes;
+	for (U32 i = 0; i < this->mObstacles.size(); ++i)
+	{
+		const Obstacle &obstacle = this->mObstacles[i];
+		F32 cost = obstacle.mCost;
+		if (obstacle.mBlocked)
+			cost += IAIPATHGLOBAL_MOVE_MODIFIER_UNTRAVERSAL;
+
+		// circles cover all heights, so search the area under them; a merged region is hit anywhere across it
+		index.findOverlapping(obstacle.mBox, nodes);
+		F32 radiusSq = obstacle.mRadius * obstacle.mRadius;
+		for (U32 j = 0; j < nodes.size(); ++j)
+		{
+			const Point3F &position = nodes[j]->mPosition;
+			if (obstacle.mCircle)
+			{
+				// closest point of the region to the centre
+				Box3F region = nodes[j]->getRegionBox();
+				Point2F offset(mClampF(obstacle.mCentre.x, region.min.x, region.max.x) - obstacle.mCentre.x,
+							   mClampF(obstacle.mCentre.y, region.min.y, region.max.y) - obstacle.mCentre.y);
+				if (offset.lenSquared() > radiusSq)
+					continue;
+			} else if ((position.z < obstacle.mBox.min.z) || (position.z > obstacle.mBox.max.z))
+				continue;
+
+			if (nodes[j]->mMapIndex < back.mCosts.size())
+				back.mCosts[nodes[j]->mMapIndex] += cost;
+		}
+	}
+
+	// publish
+	Mutex::lockMutex(this->mMutex);
+	this->mFront = 1 - this->mFront;
+	Mutex::unlockMutex(this->mMutex);
+}
+
+const iAIPathOverlay::Buffer* iAIPathOverlay::acquire()
+{
+	Mutex::lockMutex(this->mMutex);
+	Buffer *buffer = &this->mBuffers[this->mFront];
+	++buffer->mReaders;
+	Mutex::unlockMutex(this->mMutex);
+	return buffer;
+}
+
+void iAIPathOverlay::release(const Buffer *buffer)
+{
+	if (!buffer)
+		return;
+
+	Mutex::lockMutex(this->mMutex);
+	Buffer *owned = (buffer == &this->mBuffers[0]) ? &this->mBuffers[0] : &this->mBuffers[1];
+	if (owned->mReaders > 0)
+		--owned->mReaders;
+	Mutex::unlockMutex(this->mMutex);
+}
@@ -0,0 +1,206 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathOverlay
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+//-------------------------------------------------------------------
+/// @file iAIPathOverlay.h
+//-------------------------------------------------------------------
+/// @class iAIPathOverlay
+/// @author Gavin Bunney
+/// @version 1.0
+/// @brief Dynamic costs laid over the static pathmap.
+///
+/// Obstacles (boxes or circles) are registered at runtime with an
+/// additive cost or as blocked. The overlay rasterises them into a
+/// per-node cost buffer which A* adds to each node's move modifier,
+/// leaving the nodes and their links untouched. A node is hit if an
+/// obstacle overlaps any part of its region, not just the node.
+///
+/// The buffer is double-buffered; a change is written into the back
+/// buffer and then published by swapping, so a search holding the
+/// front buffer never sees a partial update.
+//-------------------------------------------------------------------
+#ifndef _IAIPATHOVERLAY_H_
+#define _IAIPATHOVERLAY_H_
+
+#include "iAIPathNode.h"
+
+class iAIPathIndex;
+
+class iAIPathOverlay {
+
+public:
+
+	//-------------------------------------------------------------------
+	/// @struct Buffer
+	/// @brief Cost of every node in the pathmap, indexed by the node's
+	///        mMapIndex.
+	//-------------------------------------------------------------------
+	struct Buffer
+	{
+		//-------------------------------------------------------------------
+		/// @var Vector<F32> mCosts
+		/// @brief Additive cost per node. Blocked nodes hold at least
+		///        IAIPATHGLOBAL_MOVE_MODIFIER_UNTRAVERSAL.
+		//-------------------------------------------------------------------
+		Vector<F32> mCosts;
+
+		//-------------------------------------------------------------------
+		/// @var U32 mReaders
+		/// @brief Number of searches currently holding the buffer.
+		//-------------------------------------------------------------------
+		U32 mReaders;
+	};
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathOverlay()
+	/// @brief Default constructor.
+	//-------------------------------------------------------------------
+	iAIPathOverlay();
+
+	//-------------------------------------------------------------------
+	/// @fn ~iAIPathOverlay()
+	/// @brief Default deconstructor.
+	//-------------------------------------------------------------------
+	~iAIPathOverlay();
+
+	//-------------------------------------------------------------------
+	/// @fn U32 addBox(const Box3F &box, const F32 cost, const bool blocked)
+	/// @brief Registers a box obstacle. Call commit() to publish.
+	///
+	/// @param box world box covering the obstacle.
+	/// @param cost additive cost of the nodes within the box.
+	/// @param blocked if true, the nodes are untraversable.
+	/// @return U32 id of the obstacle.
+	//-------------------------------------------------------------------
+	U32 addBox(const Box3F &box, const F32 cost, const bool blocked);
+
+	//-------------------------------------------------------------------
+	/// @fn U32 addCircle(const Point3F &centre, const F32 radius,
+	///                   const F32 cost, const bool blocked)
+	/// @brief Registers a circle obstacle, covering all heights within
+	///        the radius in X & Y. Call commit() to publish.
+	///
+	/// @param centre world centre of the obstacle.
+	/// @param radius radius of the obstacle.
+	/// @param cost additive cost of the nodes within the circle.
+	/// @param blocked if true, the nodes are untraversable.
+	/// @return U32 id of the obstacle.
+	//-------------------------------------------------------------------
+	U32 addCircle(const Point3F &centre, const F32 radius, const F32 cost, const bool blocked);
+
+	//-------------------------------------------------------------------
+	/// @fn bool remove(const U32 id)
+	/// @brief Unregisters an obstacle. Call commit() to publish.
+	///
+	/// @param id id returned when the obstacle was added.
+	/// @return true if the obstacle was found.
+	//-------------------------------------------------------------------
+	bool remove(const U32 id);
+
+	//-------------------------------------------------------------------
+	/// @fn void clear()
+	/// @brief Unregisters all obstacles. Call commit() to publish.
+	//-------------------------------------------------------------------
+	void clear();
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getObstacleCount() const
+	/// @brief Retrieves the number of registered obstacles.
+	///
+	/// @return U32 number of obstacles.
+	//-------------------------------------------------------------------
+	U32 getObstacleCount() const { return this->mObstacles.size(); }
+
+	//-------------------------------------------------------------------
+	/// @fn void commit(const iAIPathIndex &index)
+	/// @brief Rasterises the obstacles into the back buffer and swaps it
+	///        to the front. Must be called from the main thread, after
+	///        any change to the obstacles or the nodes of the pathmap.
+	///
+	/// @param index spatial index over every node of the pathmap.
+	//-------------------------------------------------------------------
+	void commit(const iAIPathIndex &index);
+
+	//-------------------------------------------------------------------
+	/// @fn const Buffer* acquire()
+	/// @brief Retrieves the front buffer for the length of a search. May
+	///        be called from any thread; must be paired with release().
+	///
+	/// @return the current front buffer.
+	//-------------------------------------------------------------------
+	const Buffer* acquire();
+
+	//-------------------------------------------------------------------
+	/// @fn void release(const Buffer *buffer)
+	/// @brief Hands back a buffer from acquire().
+	///
+	/// @param buffer buffer to release.
+	//-------------------------------------------------------------------
+	void release(const Buffer *buffer);
+
+	//-------------------------------------------------------------------
+	/// @fn static F32 getCost(const Buffer *buffer, const iAIPathNode *node)
+	/// @brief Retrieves the overlay cost of a node.
+	///
+	/// @param buffer buffer from acquire(), may be 0.
+	/// @param node node to look up.
+	/// @return F32 additive cost of the node.
+	//-------------------------------------------------------------------
+	static inline F32 getCost(const Buffer *buffer, const iAIPathNode *node)
+	{
+		if (!buffer || (node->mMapIndex >= buffer->mCosts.size()))
+			return 0.0f;
+		return buffer->mCosts[node->mMapIndex];
+	}
+
+protected:
+
+	//-------------------------------------------------------------------
+	/// @struct Obstacle
+	/// @brief A registered box or circle.
+	//-------------------------------------------------------------------
+	struct Obstacle
+	{
+		U32 mId;
+		bool mCircle;
+		Box3F mBox;
+		Point3F mCentre;
+		F32 mRadius;
+		F32 mCost;
+		bool mBlocked;
+	};
+
+	//-------------------------------------------------------------------
+	/// @var Vector<Obstacle> mObstacles
+	/// @brief All registered obstacles.
+	//-------------------------------------------------------------------
+	Vector<Obstacle> mObstacles;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mNextId
+	/// @brief Id given to the next obstacle added.
+	//-------------------------------------------------------------------
+	U32 mNextId;
+
+	//-------------------------------------------------------------------
+	/// @var Buffer mBuffers[2]
+	/// @brief The front and back cost buffers.
+	//-------------------------------------------------------------------
+	Buffer mBuffers[2];
+
+	//-------------------------------------------------------------------
+	/// @var U32 mFront
+	/// @brief Index into mBuffers of the front buffer.
+	//-------------------------------------------------------------------
+	U32 mFront;
+
+	//-------------------------------------------------------------------
+	/// @var void* mMutex
+	/// @brief Guards mFront and the reader counts.
+	//-------------------------------------------------------------------
+	void *mMutex;
+};
+
+#endif
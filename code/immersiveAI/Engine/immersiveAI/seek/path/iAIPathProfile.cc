@@ -0,0 +1,53 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathProfile
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+#include "iAIPathGlobal.h"
+#include "iAIPathProfile.h"
+
+iAIPathProfile::iAIPathProfile(const char *name)
+{
+	this->mName = StringTable->insert(name);
+
+	for (U32 i = 0; i < iAIPathNode::CostChannelCount; ++i)
+		this->mWeights[i] = 1.0f;
+
+	for (U32 i = 0; i < TerrainBlock::MaterialGroups; ++i)
+	{
+		this->mSurfaceCosts[i] = 0.0f;
+		this->mSurfaceSet[i] = false;
+	}
+}
+
+void iAIPathProfile::setWeight(const U32 channel, const F32 weight)
+{
+	if (channel < iAIPathNode::CostChannelCount)
+		this->mWeights[channel] = weight;
+}
+
+bool iAIPathProfile::setSurfaceCost(const char *material, const F32 cost)
+{
+	TerrainBlock *terrain = dynamic_cast<TerrainBlock*>(Sim::findObject("Terrain"));
+	if (!terrain || !material)
+		return false;
+
+	// the nodes hold material indexes, so find the one with the name
+	for (U32 i = 0; i < TerrainBlock::MaterialGroups; ++i)
+	{
+		const char *fileName = terrain->mMaterialFileName[i];
+		if (!fileName || !fileName[0])
+			continue;
+
+		const char *name = dStrrchr(fileName, '/');
+		name = name ? name + 1 : fileName;
+		if (dStricmp(name, material) != 0)
+			continue;
+
+		this->mSurfaceCosts[i] = cost;
+		this->mSurfaceSet[i] = true;
+		return true;
+	}
+
+	return false;
+}
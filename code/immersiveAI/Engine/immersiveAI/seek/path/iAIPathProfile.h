@@ -0,0 +1,129 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathProfile
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+//-------------------------------------------------------------------
+/// @file iAIPathProfile.h
+//-------------------------------------------------------------------
+/// @class iAIPathProfile
+/// @author Gavin Bunney
+/// @version 1.0
+/// @brief Named weighting of the cost channels baked into the nodes.
+///
+/// Each agent type can have its own profile, registered from script
+/// on the pathmap, so one agent avoids water while another avoids
+/// roads. A* looks up a node's cost through the profile of the path
+/// being found; the nodes themselves are shared by every profile.
+//-------------------------------------------------------------------
+#ifndef _IAIPATHPROFILE_H_
+#define _IAIPATHPROFILE_H_
+
+#include "terrain/terrData.h"
+
+#include "iAIPathNode.h"
+
+class iAIPathProfile {
+
+public:
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathProfile(const char *name)
+	/// @brief Creates a profile weighting every channel by 1, the same
+	///        as no profile at all.
+	///
+	/// @param name name the profile is found by.
+	//-------------------------------------------------------------------
+	iAIPathProfile(const char *name);
+
+	//-------------------------------------------------------------------
+	/// @fn StringTableEntry getName() const
+	/// @brief Retrieves the name of the profile.
+	///
+	/// @return StringTableEntry name.
+	//-------------------------------------------------------------------
+	StringTableEntry getName() const { return this->mName; }
+
+	//-------------------------------------------------------------------
+	/// @fn void setWeight(const U32 channel, const F32 weight)
+	/// @brief Sets how much a cost channel counts for.
+	///
+	/// @param channel iAIPathNode::CostChannel to weight.
+	/// @param weight multiplier of the channel's baked cost.
+	//-------------------------------------------------------------------
+	void setWeight(const U32 channel, const F32 weight);
+
+	//-------------------------------------------------------------------
+	/// @fn bool setSurfaceCost(const char *material, const F32 cost)
+	/// @brief Overrides the surface cost of a terrain material for this
+	///        profile alone.
+	///
+	/// @param material terrain material name, without its path.
+	/// @param cost cost of nodes over the material.
+	/// @return true if the terrain has the material.
+	//-------------------------------------------------------------------
+	bool setSurfaceCost(const char *material, const F32 cost);
+
+	//-------------------------------------------------------------------
+	/// @fn F32 getCost(const iAIPathNode *node) const
+	/// @brief Retrieves the move modifier of a node under this profile.
+	///
+	/// @param node node to cost.
+	/// @return F32 move modifier.
+	//-------------------------------------------------------------------
+	inline F32 getCost(const iAIPathNode *node) const
+	{
+		F32 cost = (this->mWeights[iAIPathNode::CostWater] * node->mCost[iAIPathNode::CostWater]) +
+				   (this->mWeights[iAIPathNode::CostSlope] * node->mCost[iAIPathNode::CostSlope]);
+
+		if ((node->mSurface < TerrainBlock::MaterialGroups) && this->mSurfaceSet[node->mSurface])
+			cost += this->mSurfaceCosts[node->mSurface];
+		else
+			cost += this->mWeights[iAIPathNode::CostSurface] * node->mCost[iAIPathNode::CostSurface];
+
+		return cost;
+	}
+
+	//-------------------------------------------------------------------
+	/// @fn static F32 getCost(const iAIPathProfile *profile,
+	///                        const iAIPathNode *node)
+	/// @brief Retrieves the move modifier of a node under a profile, or
+	///        its baked move modifier if there is none.
+	///
+	/// @param profile profile of the search, may be 0.
+	/// @param node node to cost.
+	/// @return F32 move modifier.
+	//-------------------------------------------------------------------
+	static inline F32 getCost(const iAIPathProfile *profile, const iAIPathNode *node)
+	{
+		return profile ? profile->getCost(node) : node->mMoveModifier;
+	}
+
+protected:
+
+	//-------------------------------------------------------------------
+	/// @var StringTableEntry mName
+	/// @brief Name the profile is found by.
+	//-------------------------------------------------------------------
+	StringTableEntry mName;
+
+	//-------------------------------------------------------------------
+	/// @var F32 mWeights[iAIPathNode::CostChannelCount]
+	/// @brief Multiplier of each cost channel.
+	//-------------------------------------------------------------------
+	F32 mWeights[iAIPathNode::CostChannelCount];
+
+	//-------------------------------------------------------------------
+	/// @var F32 mSurfaceCosts[TerrainBlock::MaterialGroups]
+	/// @brief Surface cost of each terrain material, where overridden.
+	//-------------------------------------------------------------------
+	F32 mSurfaceCosts[TerrainBlock::MaterialGroups];
+
+	//-------------------------------------------------------------------
+	/// @var bool mSurfaceSet[TerrainBlock::MaterialGroups]
+	/// @brief Terrain materials whose surface cost is overridden.
+	//-------------------------------------------------------------------
+	bool mSurfaceSet[TerrainBlock::MaterialGroups];
+};
+
+#endif
@@ -0,0 +1,187 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathReservation
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+#include "platform/profiler.h"
+
+#include "iAIPathReservation.h"
+#include "iAIPathMap.h"
+#include "immersiveAI/agent/iAIAgent.h"
+
+//-------------------------------------------------------------------
+/// @class iAIPathReservationEvent
+/// @brief Sim event which plans the queued cooperative paths.
+//-------------------------------------------------------------------
+class iAIPathReservationEvent : public SimEvent
+{
+public:
+
+	void process(SimObject *object)
+	{
+		iAIPathReservation::getInstance()->processRequests(static_cast<iAIPathMap*>(object));
+	}
+};
+
+iAIPathReservation* iAIPathReservation::mInstance = 0;
+
+iAIPathReservation* iAIPathReservation::getInstance()
+{
+	// if an instance doesn't exist yet, create one!
+	if (!mInstance)
+	{
+		mInstance = new iAIPathReservation();
+	}
+	return mInstance;
+}
+
+iAIPathReservation::iAIPathReservation()
+{
+	this->mEvent = 0;
+
+	for (U32 i = 0; i < IAIPATHRESERVATION_HASH_SIZE; ++i)
+		this->mBuckets[i] = -1;
+}
+
+bool iAIPathReservation::isEnabled()
+{
+	return Con::getBoolVariable("$iAIPathMap::cooperative", false);
+}
+
+U32 iAIPathReservation::getWindow()
+{
+	S32 window = Con::getIntVariable("$iAIPathMap::cooperativeWindow", IAIPATHRESERVATION_WINDOW);
+	return (U32)mClamp(window, 1, IAIPATHRESERVATION_MAX_WINDOW);
+}
+
+U32 iAIPathReservation::getOwner(const U32 nodeId, const U32 step)
+{
+	for (S32 i = this->mBuckets[iAIPathReservation::getBucket(nodeId, step)]; i != -1; i = this->mReservations[i].mNext)
+	{
+		const Reservation &reservation = this->mReservations[i];
+		if ((reservation.mNodeId == nodeId) && (reservation.mStep == step))
+			return reservation.mOwnerId;
+	}
+	return 0;
+}
+
+void iAIPathReservation::reserve(const U32 nodeId, const U32 step, const U32 ownerId)
+{
+	// first come, first served
+	if (this->getOwner(nodeId, step) != 0)
+		return;
+
+	Reservation reservation;
+	reservation.mNodeId = nodeId;
+	reservation.mStep = step;
+	reservation.mOwnerId = ownerId;
+
+	U32 bucket = iAIPathReservation::getBucket(nodeId, step);
+	reservation.mNext = this->mBuckets[bucket];
+	this->mBuckets[bucket] = this->mReservations.size();
+	this->mReservations.push_back(reservation);
+}
+
+void iAIPathReservation::release(const U32 ownerId)
+{
+	PROFILE_SCOPE(iAIPathReservation_release);
+
+	// keep the rest in order, then link them up again
+	U32 currentStep = iAIPathReservation::getCurrentStep();
+	U32 kept = 0;
+	for (U32 i = 0; i < this->mReservations.size(); ++i)
+	{
+		const Reservation &reservation = this->mReservations[i];
+		if ((reservation.mOwnerId == ownerId) || (reservation.mStep < currentStep))
+			continue;
+
+		this->mReservations[kept++] = reservation;
+	}
+	this->mReservations.setSize(kept);
+
+	for (U32 i = 0; i < IAIPATHRESERVATION_HASH_SIZE; ++i)
+		this->mBuckets[i] = -1;
+
+	for (U32 i = 0; i < this->mReservations.size(); ++i)
+	{
+		U32 bucket = iAIPathReservation::getBucket(this->mReservations[i].mNodeId, this->mReservations[i].mStep);
+		this->mReservations[i].mNext = this->mBuckets[bucket];
+		this->mBuckets[bucket] = i;
+	}
+}
+
+void iAIPathReservation::clear()
+{
+	this->mReservations.clear();
+	for (U32 i = 0; i < IAIPATHRESERVATION_HASH_SIZE; ++i)
+		this->mBuckets[i] = -1;
+
+	this->mRequests.clear();
+	if (this->mEvent)
+	{
+		Sim::cancelEvent(this->mEvent);
+		this->mEvent = 0;
+	}
+}
+
+bool iAIPathReservation::requestPath(iAIAgent *agent, const Point3F &goal)
+{
+	iAIPathMap* pathMap = 0;
+	if (!Sim::findObject(dAtoi(Con::getVariable("$iAIPathMap")), pathMap))
+	{
+		Con::errorf("Immersive AI :: Seek :: unable to find the iAIPathMap");
+		return false;
+	}
+
+	// an agent asking again has changed its mind
+	U32 agentId = agent->getId();
+	bool queued = false;
+	for (U32 i = 0; !queued && (i < this->mRequests.size()); ++i)
+	{
+		if (this->mRequests[i].mAgentId == agentId)
+		{
+			this->mRequests[i].mGoal = goal;
+			queued = true;
+		}
+	}
+
+	if (!queued)
+	{
+		Request request;
+		request.mAgentId = agentId;
+		request.mGoal = goal;
+		this->mRequests.push_back(request);
+	}
+
+	// the rest of the squad asks during the same tick; plan them all once it's done
+	if (!this->mEvent)
+		this->mEvent = Sim::postEvent(pathMap, new iAIPathReservationEvent, Sim::getCurrentTime());
+
+	return true;
+}
+
+void iAIPathReservation::processRequests(iAIPathMap *pathMap)
+{
+	PROFILE_SCOPE(iAIPathReservation_processRequests);
+
+	this->mEvent = 0;
+
+	// requests made while planning wait for the next batch
+	Vector<Request> requests = this->mRequests;
+	this->mRequests.clear();
+
+	// everyone starts from the next step, so they're all planned against the same clock
+	U32 startStep = iAIPathReservation::getCurrentStep() + 1;
+	U32 planned = 0;
+	for (U32 i = 0; i < requests.size(); ++i)
+	{
+		iAIAgent *agent = 0;
+		if (!Sim::findObject(requests[i].mAgentId, agent))
+			continue;
+
+		agent->planCooperativePath(pathMap, requests[i].mGoal, startStep);
+		++planned;
+	}
+
+	Con::iAIMessagef("Immersive AI :: Seek :: %d cooperative paths planned, %d nodes reserved", planned, this->mReservations.size());
+}
@@ -0,0 +1,256 @@
+//-------------------------------------------------------------------
+// Immersive AI :: Seek :: iAIPathReservation
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+//-------------------------------------------------------------------
+/// @file iAIPathReservation.h
+//-------------------------------------------------------------------
+/// @class iAIPathReservation
+/// @author Gavin Bunney
+/// @version 1.0
+/// @brief Space-time reservations of pathmap nodes, for agents
+///        planning around each other.
+///
+/// A Singleton class holding which agent will be on which node at
+/// each step of time, for windowed cooperative A*. Agents with
+/// cooperativePath set, while $iAIPathMap::cooperative is on, plan
+/// the next $iAIPathMap::cooperativeWindow steps of their path around
+/// the nodes the others have reserved, waiting where they must, then
+/// reserve their own. The rest of the way is planned as usual, and
+/// planned again once half the window has been walked.
+/// <br><br>
+/// Requests are queued and planned together once per tick, in the
+/// order they were made, so a whole squad plans in one go.
+//-------------------------------------------------------------------
+#ifndef _IAIPATHRESERVATION_H_
+#define _IAIPATHRESERVATION_H_
+
+#include "console/simBase.h"
+
+#include "iAIPathNode.h"
+
+class iAIPathMap;
+class iAIAgent;
+
+//-------------------------------------------------------------------
+/// @def IAIPATHRESERVATION_STEP_TIME
+/// @brief Milliseconds in each step of time; roughly the time to walk
+///        from one node to the next.
+//-------------------------------------------------------------------
+#define IAIPATHRESERVATION_STEP_TIME		500
+
+//-------------------------------------------------------------------
+/// @def IAIPATHRESERVATION_WINDOW
+/// @brief Default steps planned around the others' reservations. Can
+///        be changed via $iAIPathMap::cooperativeWindow.
+//-------------------------------------------------------------------
+#define IAIPATHRESERVATION_WINDOW			8
+
+//-------------------------------------------------------------------
+/// @def IAIPATHRESERVATION_MAX_WINDOW
+/// @brief Most steps $iAIPathMap::cooperativeWindow can be set to.
+//-------------------------------------------------------------------
+#define IAIPATHRESERVATION_MAX_WINDOW		32
+
+//-------------------------------------------------------------------
+/// @def IAIPATHRESERVATION_MAX_STATES
+/// @brief Most node & step states a cooperative search will make.
+//-------------------------------------------------------------------
+#define IAIPATHRESERVATION_MAX_STATES		4096
+
+//-------------------------------------------------------------------
+/// @def IAIPATHRESERVATION_MAX_OPEN
+/// @brief Most entries a cooperative search's open list will take; a
+///        state is entered again each time a cheaper way to it is
+///        found. The search stops where it got to once full.
+//-------------------------------------------------------------------
+#define IAIPATHRESERVATION_MAX_OPEN			(IAIPATHRESERVATION_MAX_STATES * 4)
+
+//-------------------------------------------------------------------
+/// @def IAIPATHRESERVATION_WAIT_COST
+/// @brief Cost of waiting on a node for a step.
+//-------------------------------------------------------------------
+#define IAIPATHRESERVATION_WAIT_COST		1.0f
+
+//-------------------------------------------------------------------
+/// @def IAIPATHRESERVATION_HASH_SIZE
+/// @brief Number of buckets in the reservation & search state hashes;
+///        a power of two.
+//-------------------------------------------------------------------
+#define IAIPATHRESERVATION_HASH_SIZE		1024
+
+class iAIPathReservation {
+
+public:
+
+	//-------------------------------------------------------------------
+	/// @fn ~iAIPathReservation()
+	/// @brief Default deconstructor.
+	//-------------------------------------------------------------------
+	~iAIPathReservation() { };
+
+	//-------------------------------------------------------------------
+	/// @fn static iAIPathReservation* getInstance()
+	/// @brief Retrieves the instance of the singleton. Creates a new
+	///        instance if one doesn't exist.
+	///
+	/// @return Singleton instance pointer.
+	//-------------------------------------------------------------------
+	static iAIPathReservation* getInstance();
+
+	//-------------------------------------------------------------------
+	/// @fn static bool isEnabled()
+	/// @brief Checks if cooperative paths are turned on, via
+	///        $iAIPathMap::cooperative.
+	//-------------------------------------------------------------------
+	static bool isEnabled();
+
+	//-------------------------------------------------------------------
+	/// @fn static U32 getWindow()
+	/// @brief Retrieves $iAIPathMap::cooperativeWindow, kept within 1 &
+	///        IAIPATHRESERVATION_MAX_WINDOW.
+	///
+	/// @return U32 steps planned around the reservations.
+	//-------------------------------------------------------------------
+	static U32 getWindow();
+
+	//-------------------------------------------------------------------
+	/// @fn static U32 getCurrentStep()
+	/// @brief Retrieves the step of time the Sim is in.
+	//-------------------------------------------------------------------
+	static U32 getCurrentStep() { return Sim::getCurrentTime() / IAIPATHRESERVATION_STEP_TIME; }
+
+	//-------------------------------------------------------------------
+	/// @fn static U32 getStepTime(const U32 step)
+	/// @brief Retrieves the Sim time a step of time starts at.
+	//-------------------------------------------------------------------
+	static U32 getStepTime(const U32 step) { return step * IAIPATHRESERVATION_STEP_TIME; }
+
+	//-------------------------------------------------------------------
+	/// @fn U32 getOwner(const U32 nodeId, const U32 step)
+	/// @brief Retrieves who has reserved a node at a step.
+	///
+	/// @param nodeId id of the node.
+	/// @param step step of time.
+	/// @return U32 Sim id of the agent, 0 if nobody.
+	//-------------------------------------------------------------------
+	U32 getOwner(const U32 nodeId, const U32 step);
+
+	//-------------------------------------------------------------------
+	/// @fn void reserve(const U32 nodeId, const U32 step,
+	///                  const U32 ownerId)
+	/// @brief Reserves a node at a step.
+	///
+	/// @param nodeId id of the node.
+	/// @param step step of time.
+	/// @param ownerId Sim id of the agent reserving it.
+	//-------------------------------------------------------------------
+	void reserve(const U32 nodeId, const U32 step, const U32 ownerId);
+
+	//-------------------------------------------------------------------
+	/// @fn void release(const U32 ownerId)
+	/// @brief Drops every reservation of an agent, and any already past.
+	///
+	/// @param ownerId Sim id of the agent.
+	//-------------------------------------------------------------------
+	void release(const U32 ownerId);
+
+	//-------------------------------------------------------------------
+	/// @fn void clear()
+	/// @brief Drops every reservation and request. Called by the pathmap
+	///        when its nodes are deleted.
+	//-------------------------------------------------------------------
+	void clear();
+
+	//-------------------------------------------------------------------
+	/// @fn bool requestPath(iAIAgent *agent, const Point3F &goal)
+	/// @brief Queues an agent to plan a cooperative path with the rest
+	///        at the end of the tick; replaces any it already queued.
+	///        Once planned, the agent follows the path.
+	///
+	/// @param agent agent to plan for.
+	/// @param goal Point3F to plan to.
+	/// @return false if there's no pathmap to plan on.
+	//-------------------------------------------------------------------
+	bool requestPath(iAIAgent *agent, const Point3F &goal);
+
+	//-------------------------------------------------------------------
+	/// @fn void processRequests(iAIPathMap *pathMap)
+	/// @brief Plans every queued request, in order.
+	///
+	/// @param pathMap pathmap to plan on.
+	//-------------------------------------------------------------------
+	void processRequests(iAIPathMap *pathMap);
+
+private:
+
+	//-------------------------------------------------------------------
+	/// @fn iAIPathReservation::iAIPathReservation()
+	/// @brief Default constructor.
+	//-------------------------------------------------------------------
+	iAIPathReservation();
+
+	//-------------------------------------------------------------------
+	/// @var static iAIPathReservation* mInstance
+	/// @brief Instance of the singleton.
+	//-------------------------------------------------------------------
+	static iAIPathReservation* mInstance;
+
+	//-------------------------------------------------------------------
+	/// @struct Reservation
+	/// @brief A node held by an agent for a step.
+	//-------------------------------------------------------------------
+	struct Reservation
+	{
+		U32 mNodeId;			///< id of the node
+		U32 mStep;				///< step of time
+		U32 mOwnerId;			///< Sim id of the agent
+		S32 mNext;				///< next reservation in the same bucket, or -1
+	};
+
+	//-------------------------------------------------------------------
+	/// @struct Request
+	/// @brief An agent waiting to plan.
+	//-------------------------------------------------------------------
+	struct Request
+	{
+		U32 mAgentId;			///< Sim id of the agent
+		Point3F mGoal;			///< where it's going
+	};
+
+	//-------------------------------------------------------------------
+	/// @fn static inline U32 getBucket(const U32 nodeId, const U32 step)
+	/// @brief Hashes a node & step into a bucket index.
+	//-------------------------------------------------------------------
+	static inline U32 getBucket(const U32 nodeId, const U32 step)
+	{
+		return ((nodeId * 73856093) ^ (step * 19349663)) & (IAIPATHRESERVATION_HASH_SIZE - 1);
+	}
+
+	//-------------------------------------------------------------------
+	/// @var Vector<Reservation> mReservations
+	/// @brief Every reservation held.
+	//-------------------------------------------------------------------
+	Vector<Reservation> mReservations;
+
+	//-------------------------------------------------------------------
+	/// @var S32 mBuckets[IAIPATHRESERVATION_HASH_SIZE]
+	/// @brief First reservation in each bucket, or -1.
+	//-------------------------------------------------------------------
+	S32 mBuckets[IAIPATHRESERVATION_HASH_SIZE];
+
+	//-------------------------------------------------------------------
+	/// @var Vector<Request> mRequests
+	/// @brief Agents waiting to plan, in order.
+	//-------------------------------------------------------------------
+	Vector<Request> mRequests;
+
+	//-------------------------------------------------------------------
+	/// @var U32 mEvent
+	/// @brief Sim event planning the requests, or 0.
+	//-------------------------------------------------------------------
+	U32 mEvent;
+};
+
+#endif
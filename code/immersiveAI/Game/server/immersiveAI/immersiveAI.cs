@@ -1,86 +1,152 @@
-//-------------------------------------------------------------------
-// Immersive AI
-// Copyright (c) 2006 Gavin Bunney & Tom Romano
-//-------------------------------------------------------------------
-
-// agent types
-$iAIAgentType_Bandit = "bandit";
-$iAIAgentType_Bandit_Code = 1;
-$iAIAgentType_Entertainer = "entertainer";
-$iAIAgentType_Entertainer_Code = 2;
-$iAIAgentType_Soldier = "soldier";
-$iAIAgentType_Soldier_Code = 3;
-
-// execute the main managers/libraries
-exec("./agent/iAIAgent.cs");
-exec("./agent/iAIAgentManager.cs");
-exec("./goals/iAIGoalLibrary.cs");
-exec("./goals/iAIGoalManager.cs");
-
-// number of agents to spawn
-$IAIAGENT_COUNT = 2;
-
-// radius to search
-$IAISEEK_RADIUS = 150;
-$IAISEEK_CLOSE_ENOUGH = 10;
-
-// time between check vitals loops
-$IAIAGENT_CHECK_VITALS = 10000;
-
-// vitals rates of decay
-$IAIAGENT_VITALS_HAPPINESS = -10;
-$IAIAGENT_VITALS_FATIGUE = 10;
-$IAIAGENT_VITALS_BOREDOM = 10;
-
-// time between thinking loops
-$IAIAGENT_THINK = 2000;
-
-// number of think ticks before an agent leaves a goal (if in same goal whole time)
-$IAIAGENT_THINK_TICK_LIMIT = 60;
-
-//-------------------------------------------------------------------
-/// @fn immersiveAI_Initialize()
-/// @brief Initializes the immersive AI system. Called when a game
-///        is created.
-///
-//-------------------------------------------------------------------
-function immersiveAI_Initialize()
-{
-   // create & init the goal library
-   $iAIGoalLibrary = new iAIGoalLibrary();
-   MissionCleanup.add($iAIGoalLibrary);
-   $iAIGoalLibrary.initialize();
-
-   // create & init the goal manager
-   new ScriptObject(iAIGoalManager) {};
-   MissionCleanup.add(iAIGoalManager);
-   iAIGoalManager.initialize();
-
-   // create the path map
-   $iAIPathMap = new iAIPathMap();
-   MissionCleanup.add($iAIPathMap);
-
-   // init pathmap for the current mission
-   if ($iAIPathMap.Initialize())
-   {
-      // start the iAIAgentManager
-      new ScriptObject(iAIAgentManager) {};
-      MissionCleanup.add(iAIAgentManager);
-      iAIAgentManager.initialize();
-   }
-}
-
-//-------------------------------------------------------------------
-/// @fn getRandomPoint()
-/// @brief Helper function to get a random position in the world.
-///
-/// @returns Point3F Random position in the world.
-//-------------------------------------------------------------------
-function getRandomPoint()
-{
-   %randX = getRandom(-150, 600);
-   %randY = getRandom(-150, 600);
-   %randZ = getTerrainHeight(%randX SPC %randY) + 50;
-   return %randX SPC %randY SPC %randZ;
-}
-
+//-------------------------------------------------------------------
+// Immersive AI
+// Copyright (c) 2006 Gavin Bunney & Tom Romano
+//-------------------------------------------------------------------
+
+// agent types
+$iAIAgentType_Bandit = "bandit";
+$iAIAgentType_Bandit_Code = 1;
+$iAIAgentType_Entertainer = "entertainer";
+$iAIAgentType_Entertainer_Code = 2;
+$iAIAgentType_Soldier = "soldier";
+$iAIAgentType_Soldier_Code = 3;
+
+// execute the main managers/libraries
+exec("./agent/iAIAgent.cs");
+exec("./agent/iAIAgentManager.cs");
+exec("./goals/iAIGoalLibrary.cs");
+exec("./goals/iAIGoalManager.cs");
+
+// number of agents to spawn
+$IAIAGENT_COUNT = 2;
+
+// radius to search
+$IAISEEK_RADIUS = 150;
+$IAISEEK_CLOSE_ENOUGH = 10;
+
+// time between check vitals loops
+$IAIAGENT_CHECK_VITALS = 10000;
+
+// vitals rates of decay
+$IAIAGENT_VITALS_HAPPINESS = -10;
+$IAIAGENT_VITALS_FATIGUE = 10;
+$IAIAGENT_VITALS_BOREDOM = 10;
+
+// time between thinking loops
+$IAIAGENT_THINK = 2000;
+
+// number of think ticks before an agent leaves a goal (if in same goal whole time)
+$IAIAGENT_THINK_TICK_LIMIT = 60;
+
+// time between retries of a path waiting on pathmap tiles to load, and how many to make
+$IAIAGENT_PATH_PENDING_TIME = 500;
+$IAIAGENT_PATH_PENDING_RETRIES = 10;
+
+// show each agent's path in the world; paths are only made into scene objects when set
+$IAIAGENT_SHOW_PATHS = false;
+
+// load the pathmap from the mission's .pathmap cache when still valid
+$iAIPathMap::useCache = true;
+
+// build the pathmap in the background, so the server keeps running
+$iAIPathMap::buildAsync = true;
+
+// merge open terrain into rectangular regions up to 2^levels nodes on a side (0 = full density everywhere)
+$iAIPathMap::adaptiveLevels = 4;
+
+// merge wide open terrain, where every node links to all its neighbours, into rectangles up to this many nodes on a side (0 = off)
+$iAIPathMap::openRegions = 64;
+
+// validate pathmap links the first time a path crosses them, rather than all up front; quicker to start but
+// keeps the full density, ignores agent radius & can't be cached (0 = validate everything at build)
+$iAIPathMap::lazyEdges = 0;
+
+// page terrain tiles in & out of the .pathmap cache around the agents, keeping under this many MB (0 = keep it all)
+$iAIPathMap::streamBudget = 0;
+
+// extra cost of walking over a terrain material, by material name
+//$iAIPathMap::surfaceCost["sand"] = 5;
+
+// extra cost of each agent standing on a node, or half that for each path still to pass through it, so paths
+// spread over the routes around crowds; found paths aren't shared between agents while set, so off unless
+// crowds need spreading (try 2)
+$iAIPathMap::crowdWeight = 0;
+
+// agents with cooperativePath set plan their next cooperativeWindow steps (of half a second) around the nodes
+// the others have reserved, waiting for them to pass; planned together once per tick
+$iAIPathMap::cooperative = false;
+$iAIPathMap::cooperativeWindow = 8;
+
+// steer agents around each other as they move, looking out to neighbourDist for up to maxNeighbours agents,
+// keeping clear of them for timeHorizon seconds ahead
+$iAIAvoidance::enabled = true;
+$iAIAvoidance::neighbourDist = 10;
+$iAIAvoidance::maxNeighbours = 10;
+$iAIAvoidance::timeHorizon = 2;
+
+//-------------------------------------------------------------------
+/// @fn immersiveAI_Initialize()
+/// @brief Initializes the immersive AI system. Called when a game
+///        is created.
+///
+//-------------------------------------------------------------------
+function immersiveAI_Initialize()
+{
+   // create & init the goal library
+   $iAIGoalLibrary = new iAIGoalLibrary();
+   MissionCleanup.add($iAIGoalLibrary);
+   $iAIGoalLibrary.initialize();
+
+   // create & init the goal manager
+   new ScriptObject(iAIGoalManager) {};
+   MissionCleanup.add(iAIGoalManager);
+   iAIGoalManager.initialize();
+
+   // create the path map
+   $iAIPathMap = new iAIPathMap();
+   MissionCleanup.add($iAIPathMap);
+
+   // cost profiles per agent type (water, slope, surface); soldiers keep out of water, bandits off the roads
+   $iAIPathMap.addCostProfile($iAIAgentType_Soldier, 1.3, 1, 1);
+   $iAIPathMap.addCostProfile($iAIAgentType_Bandit, 1, 1, 1);
+   $iAIPathMap.setCostProfileSurface($iAIAgentType_Bandit, "road", 40);
+
+   // init pathmap for the current mission
+   if ($iAIPathMap::buildAsync)
+      $iAIPathMap.initializeAsync();
+   else
+      $iAIPathMap.onPathMapReady($iAIPathMap.Initialize());
+}
+
+//-------------------------------------------------------------------
+/// @fn iAIPathMap::onPathMapReady(%this, %success)
+/// @brief Called once the pathmap for the mission is initialized.
+///        Starts the agents if the pathmap is usable.
+///
+/// @param %success pathmap initialized successfully.
+//-------------------------------------------------------------------
+function iAIPathMap::onPathMapReady(%this, %success)
+{
+   if (!%success)
+      return;
+
+   // start the iAIAgentManager
+   new ScriptObject(iAIAgentManager) {};
+   MissionCleanup.add(iAIAgentManager);
+   iAIAgentManager.initialize();
+}
+
+//-------------------------------------------------------------------
+/// @fn getRandomPoint()
+/// @brief Helper function to get a random position in the world.
+///
+/// @returns Point3F Random position in the world.
+//-------------------------------------------------------------------
+function getRandomPoint()
+{
+   %randX = getRandom(-150, 600);
+   %randY = getRandom(-150, 600);
+   %randZ = getTerrainHeight(%randX SPC %randY) + 50;
+   return %randX SPC %randY SPC %randZ;
+}
+